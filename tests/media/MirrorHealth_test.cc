@@ -0,0 +1,100 @@
+#include <iostream>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+
+#include <zypp-core/fs/TmpPath.h>
+#include <zypp-core/fs/PathInfo.h>
+#include <zypp-curl/private/mirrorhealth_p.h>
+
+using namespace zypp;
+using namespace zypp::media;
+
+BOOST_AUTO_TEST_CASE(mirrorhealth_key)
+{
+  BOOST_CHECK_EQUAL( MirrorHealth::makeKey( Url("http://user@mirror.example.org:8080/path/file.rpm?foo=bar") ), "http://mirror.example.org:8080" );
+  BOOST_CHECK_EQUAL( MirrorHealth::makeKey( Url("https://mirror.example.org/a") ), MirrorHealth::makeKey( Url("https://mirror.example.org/b") ) );
+}
+
+BOOST_AUTO_TEST_CASE(mirrorhealth_rank)
+{
+  MirrorHealth health( (Pathname()) );
+
+  const Url good( "http://good.example.org/repo" );
+  const Url slow( "http://slow.example.org/repo" );
+  const Url broken( "http://broken.example.org/repo" );
+  const Url unknown( "http://unknown.example.org/repo" );
+
+  BOOST_CHECK( !health.stats( good ) );
+
+  health.recordConnectTime( good, std::chrono::milliseconds( 20 ) );
+  health.recordTransfer( good, true, 10 * 1024 * 1024 );
+  health.recordConnectTime( slow, std::chrono::milliseconds( 300 ) );
+  health.recordTransfer( slow, true, 100 * 1024 );
+  for ( int i = 0; i < 5; ++i )
+    health.recordTransfer( broken, false );
+
+  BOOST_REQUIRE( health.stats( broken ) );
+  BOOST_CHECK_EQUAL( health.stats( broken )->failures, 5 );
+  BOOST_CHECK_EQUAL( health.stats( broken )->successRate(), 0.0 );
+  BOOST_CHECK_EQUAL( health.stats( good )->successRate(), 1.0 );
+
+  std::vector<Url> urls { broken, unknown, slow, good };
+  health.sortByHealth( urls );
+  BOOST_CHECK_EQUAL( urls[0], good );
+  BOOST_CHECK_EQUAL( urls[1], unknown );
+  BOOST_CHECK_EQUAL( urls[2], slow );
+  BOOST_CHECK_EQUAL( urls[3], broken );
+
+  // unknown mirrors keep their order
+  std::vector<Url> unknowns { Url("http://b.example.org"), Url("http://a.example.org") };
+  health.sortByHealth( unknowns );
+  BOOST_CHECK_EQUAL( unknowns[0], Url("http://b.example.org") );
+}
+
+BOOST_AUTO_TEST_CASE(mirrorhealth_persist)
+{
+  filesystem::TmpDir tmp;
+  const Pathname file { tmp.path() / "cache" / "mirror-health" };
+  const Url mirror( "https://mirror.example.org/repo/x86_64/foo.rpm" );
+
+  {
+    MirrorHealth health( file );
+    health.recordConnectTime( mirror, std::chrono::milliseconds( 42 ) );
+    health.recordTransfer( mirror, true, 1000.5 );
+    health.recordTransfer( mirror, false );
+    health.save();
+  }
+  BOOST_REQUIRE( PathInfo( file ).isFile() );
+
+  MirrorHealth health( file );
+  const auto stats = health.stats( Url("https://mirror.example.org/other") );
+  BOOST_REQUIRE( stats );
+  BOOST_CHECK_EQUAL( stats->successes, 1 );
+  BOOST_CHECK_EQUAL( stats->failures, 1 );
+  BOOST_CHECK_EQUAL( stats->rtt, 42.0 );
+  BOOST_CHECK_EQUAL( stats->throughput, 1000.5 );
+  BOOST_CHECK( !health.stats( Url("http://mirror.example.org/repo") ) ); // other scheme
+}
+
+BOOST_AUTO_TEST_CASE(mirrorhealth_save_policy)
+{
+  filesystem::TmpDir tmp;
+  const Pathname file { tmp.path() / "mirror-health" };
+  const Url mirror( "https://mirror.example.org/repo" );
+
+  {
+    MirrorHealth health( file );
+    health.recordTransfer( mirror, true );
+    // not due yet: downloads do not write the file each time
+    health.saveIfDue();
+    BOOST_CHECK( ! PathInfo( file ).isExist() );
+    health.saveIfDue( std::chrono::seconds( 0 ) );
+    BOOST_CHECK( PathInfo( file ).isFile() );
+
+    health.recordTransfer( mirror, false );
+  }
+  // the rest is written when the store is destroyed
+  MirrorHealth health( file );
+  BOOST_REQUIRE( health.stats( mirror ) );
+  BOOST_CHECK_EQUAL( health.stats( mirror )->failures, 1 );
+}
@@ -1,6 +1,10 @@
 #include "TestSetup.h"
 #include <zypp/parser/HistoryLogReader.h>
 #include <zypp-core/parser/ParseException>
+#include <zypp/TmpPath.h>
+#include <zypp/PathInfo.h>
+#include <zypp/base/String.h>
+#include <fstream>
 
 using namespace zypp;
 
@@ -38,3 +42,89 @@ BOOST_AUTO_TEST_CASE(basic)
   HistoryLogDataInstall::Ptr p = dynamic_pointer_cast<HistoryLogDataInstall>( history[1] );
   BOOST_CHECK_EQUAL( p->userdata(), "trans|ID" ); // properly (un)escaped?
 }
+
+BOOST_AUTO_TEST_CASE(reverse)
+{
+  std::vector<HistoryLogData::Ptr> history;
+  parser::HistoryLogReader parser( TESTS_SRC_DIR "/parser/HistoryLogReader_test.dat",
+                                   parser::HistoryLogReader::IGNORE_INVALID_ITEMS,
+    [&history]( HistoryLogData::Ptr ptr )->bool {
+      history.push_back( ptr );
+      return true;
+    } );
+
+  parser.readReverse();
+  BOOST_CHECK_EQUAL( history.size(), 9 );
+  BOOST_CHECK( dynamic_pointer_cast<HistoryLogPatchStateChange>	( history[0] ) );
+  BOOST_CHECK( dynamic_pointer_cast<HistoryLogDataStampCommand>	( history[1] ) );
+  BOOST_CHECK( dynamic_pointer_cast<HistoryLogDataRepoAdd>	( history[8] ) );
+  BOOST_CHECK_EQUAL( (*history[7])[HistoryLogDataInstall::USERDATA_INDEX], "trans|ID" );
+
+  // latest 2 install/remove entries
+  history.clear();
+  parser::HistoryLogReader latest( TESTS_SRC_DIR "/parser/HistoryLogReader_test.dat",
+                                   parser::HistoryLogReader::IGNORE_INVALID_ITEMS,
+    [&history]( HistoryLogData::Ptr ptr )->bool {
+      history.push_back( ptr );
+      return history.size() < 2;
+    } );
+  latest.addActionFilter( HistoryActionID::INSTALL );
+  latest.addActionFilter( HistoryActionID::REMOVE );
+  latest.readReverse();
+  BOOST_CHECK_EQUAL( history.size(), 2 );
+  BOOST_CHECK( dynamic_pointer_cast<HistoryLogDataRemove>	( history[0] ) );
+  BOOST_CHECK( dynamic_pointer_cast<HistoryLogDataRemove>	( history[1] ) );
+}
+
+BOOST_AUTO_TEST_CASE(indexed)
+{
+  filesystem::TmpDir tmp;
+  const Pathname file { tmp.path() / "history" };
+  auto writeLog = [&file]( unsigned fromDay_r, unsigned toDay_r, std::ios_base::openmode mode_r ) {
+    std::ofstream out( file.c_str(), mode_r );
+    for ( unsigned day = fromDay_r; day <= toDay_r; ++day )
+    {
+      out << str::form( "# day %u\n", day );
+      out << str::form( "2020-01-%02u 10:00:00|install|pkg%u|1-1|noarch||repo|abcdef|\n", day, day );
+      if ( day % 3 == 0 )
+        out << str::form( "2020-01-%02u 11:00:00|remove |pkg%u|1-1|noarch||\n", day, day );
+      out << str::form( "2020-01-%02u 12:00:00|command|root@host|'zypper' 'in'|\n", day );
+    }
+  };
+  auto readLog = [&file]( parser::HistoryLogReader::Options options_r, const Date & from_r, const Date & to_r, HistoryActionID filter_r ) {
+    std::vector<std::string> ret;
+    parser::HistoryLogReader parser( file, options_r,
+      [&ret]( HistoryLogData::Ptr ptr )->bool {
+        ret.push_back( (*ptr)[0] + "|" + (*ptr)[1] + "|" + (*ptr)[2] );
+        return true;
+      } );
+    parser.addActionFilter( filter_r );
+    parser.readFromTo( from_r, to_r );
+    return ret;
+  };
+
+  writeLog( 1, 20, std::ios_base::out | std::ios_base::trunc );
+  const Date from( "2020-01-05 10:30:00", HISTORY_LOG_DATE_FORMAT );
+  const Date to( "2020-01-12 11:00:00", HISTORY_LOG_DATE_FORMAT );
+
+  for ( const HistoryActionID & filter : { HistoryActionID::NONE, HistoryActionID::REMOVE, HistoryActionID::STAMP_COMMAND } )
+  {
+    const std::vector<std::string> plain { readLog( parser::HistoryLogReader::Options(), from, to, filter ) };
+    const std::vector<std::string> indexed { readLog( parser::HistoryLogReader::USE_INDEX, from, to, filter ) };
+    BOOST_CHECK( ! plain.empty() );
+    BOOST_CHECK_EQUAL_COLLECTIONS( plain.begin(), plain.end(), indexed.begin(), indexed.end() );
+  }
+  BOOST_CHECK( PathInfo( file.extend( ".idx" ) ).isFile() );
+  BOOST_CHECK_EQUAL( readLog( parser::HistoryLogReader::USE_INDEX, from, to, HistoryActionID::REMOVE ).size(), 2 ); // day 6 and 9
+
+  // appended entries are picked up by the index
+  writeLog( 21, 25, std::ios_base::out | std::ios_base::app );
+  const Date late( "2020-01-24 00:00:00", HISTORY_LOG_DATE_FORMAT );
+  const Date never( "2021-01-01 00:00:00", HISTORY_LOG_DATE_FORMAT );
+  BOOST_CHECK_EQUAL( readLog( parser::HistoryLogReader::USE_INDEX, late, never, HistoryActionID::INSTALL ).size(), 2 );
+
+  // a rotated log invalidates the index
+  writeLog( 22, 23, std::ios_base::out | std::ios_base::trunc );
+  BOOST_CHECK_EQUAL( readLog( parser::HistoryLogReader::USE_INDEX, late, never, HistoryActionID::INSTALL ).size(), 0 );
+  BOOST_CHECK_EQUAL( readLog( parser::HistoryLogReader::USE_INDEX, from, never, HistoryActionID::INSTALL ).size(), 2 );
+}
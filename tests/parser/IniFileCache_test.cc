@@ -0,0 +1,150 @@
+#include <fstream>
+#include <string>
+#include <zypp/parser/IniFileCache.h>
+#include <zypp/parser/RepoFileReader.h>
+#include <zypp/parser/ParseException.h>
+#include <zypp/base/NonCopyable.h>
+#include <zypp/TmpPath.h>
+#include <zypp/PathInfo.h>
+
+#include "TestSetup.h"
+
+using std::string;
+using namespace zypp;
+
+static std::string suse_repo = "[factory-oss]\n"
+"name=factory-oss\n"
+"enabled=1\n"
+"baseurl=http://serv.er/loc1\n"
+"        http://serv.er/loc2  ,   http://serv.er/loc3\n"
+"gpgkey=http://serv.er/key\n"
+"[factory-debug]\n"
+"name=factory-debug\n"
+"enabled=0\n"
+"baseurl=http://serv.er/debug\n";
+
+struct RepoCollector : private base::NonCopyable
+{
+  bool collect( const RepoInfo &repo )
+  {
+    repos.push_back(repo);
+    return true;
+  }
+
+  RepoInfoList repos;
+};
+
+static void writeFile( const Pathname & file_r, const std::string & content_r )
+{
+  std::ofstream out( file_r.c_str(), std::ios_base::out | std::ios_base::trunc );
+  out << content_r;
+}
+
+static RepoInfoList readRepos( const Pathname & file_r, parser::IniFileCache & cache_r )
+{
+  RepoCollector collector;
+  parser::RepoFileReader parser( file_r, cache_r, bind( &RepoCollector::collect, &collector, _1 ) );
+  return collector.repos;
+}
+
+static void checkRepos( const RepoInfoList & repos_r, const Pathname & file_r )
+{
+  BOOST_REQUIRE_EQUAL( repos_r.size(), 2 );
+  const RepoInfo & repo( repos_r.front() );
+  BOOST_CHECK_EQUAL( repo.alias(), "factory-oss" );
+  BOOST_CHECK_EQUAL( repo.enabled(), true );
+  BOOST_CHECK_EQUAL( repo.baseUrlsSize(), 3 );
+  BOOST_CHECK_EQUAL( repo.gpgKeyUrl(), Url("http://serv.er/key") );
+  BOOST_CHECK_EQUAL( repo.filepath(), file_r );
+  BOOST_CHECK_EQUAL( repos_r.back().alias(), "factory-debug" );
+  BOOST_CHECK_EQUAL( repos_r.back().enabled(), false );
+}
+
+BOOST_AUTO_TEST_CASE(inifilecache)
+{
+  filesystem::TmpDir tmp;
+  const Pathname cachefile { tmp.path() / "cache" / "repofiles.cache" };
+  const Pathname repofile { tmp.path() / "factory.repo" };
+  writeFile( repofile, suse_repo );
+
+  {
+    parser::IniFileCache cache( cachefile );
+    checkRepos( readRepos( repofile, cache ), repofile );
+    checkRepos( readRepos( repofile, cache ), repofile );
+    BOOST_CHECK_EQUAL( cache.misses(), 1 );
+    BOOST_CHECK( ! cache.recording( tmp.path() / "nonexisting.repo" ) );
+    cache.save();
+  }
+  BOOST_REQUIRE( PathInfo( cachefile ).isFile() );
+
+  {
+    // replayed from the cache file
+    parser::IniFileCache cache( cachefile );
+    BOOST_CHECK_EQUAL( cache.size(), 1 );
+    checkRepos( readRepos( repofile, cache ), repofile );
+    BOOST_CHECK_EQUAL( cache.misses(), 0 );
+  }
+
+  {
+    // changed file is parsed again
+    writeFile( repofile, suse_repo + "priority=7\n" );
+    parser::IniFileCache cache( cachefile );
+    RepoInfoList repos { readRepos( repofile, cache ) };
+    BOOST_CHECK_EQUAL( cache.misses(), 1 );
+    checkRepos( repos, repofile );
+    BOOST_CHECK_EQUAL( repos.back().priority(), 7 );
+    cache.save();
+  }
+
+  {
+    // entries not asked for are dropped on save
+    parser::IniFileCache cache( cachefile );
+    cache.save();
+    BOOST_CHECK_EQUAL( parser::IniFileCache( cachefile ).size(), 0 );
+  }
+}
+
+BOOST_AUTO_TEST_CASE(inifilecache_garbage)
+{
+  filesystem::TmpDir tmp;
+  const Pathname cachefile { tmp.path() / "repofiles.cache" };
+  const Pathname repofile { tmp.path() / "broken.repo" };
+  writeFile( repofile, "[broken]\nname=broken\nthis is garbage\n" );
+
+  // a garbage line throws on replay just as when parsing
+  parser::IniFileCache cache( cachefile );
+  BOOST_CHECK_THROW( readRepos( repofile, cache ), parser::ParseException );
+  BOOST_CHECK_THROW( readRepos( repofile, cache ), parser::ParseException );
+  BOOST_CHECK_EQUAL( cache.misses(), 1 );
+
+  // a corrupt cache file is discarded
+  writeFile( cachefile, "zypp-inifilecache-1\ngarbage" );
+  BOOST_CHECK_EQUAL( parser::IniFileCache( cachefile ).size(), 0 );
+}
+
+BOOST_AUTO_TEST_CASE(inifilecache_mode)
+{
+  filesystem::TmpDir tmp;
+  const Pathname cachefile { tmp.path() / "repofiles.cache" };
+  const Pathname repofile { tmp.path() / "factory.repo" };
+  writeFile( repofile, suse_repo );
+
+  // a cache with data from a file not readable by everyone is private
+  filesystem::chmod( repofile, 0600 );
+  {
+    parser::IniFileCache cache( cachefile );
+    checkRepos( readRepos( repofile, cache ), repofile );
+    cache.save();
+  }
+  BOOST_CHECK( PathInfo( cachefile ).isPerm( 0600 ) );
+  BOOST_CHECK( ! PathInfo( cachefile.extend( ".new" ) ).isExist() );
+
+  filesystem::chmod( repofile, 0644 );
+  {
+    parser::IniFileCache cache( cachefile );
+    checkRepos( readRepos( repofile, cache ), repofile );
+    BOOST_CHECK_EQUAL( cache.misses(), 1 );
+    cache.save();
+  }
+  BOOST_CHECK( PathInfo( cachefile ).isPerm( 0644 ) );
+}
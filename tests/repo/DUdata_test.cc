@@ -109,4 +109,36 @@ BOOST_AUTO_TEST_CASE(dudata)
   BOOST_CHECK_EQUAL( getSize( duc, pool ), mkByteSet(  5,  0 ) );	// update (old goes)
   ins.status().setTransact( false, ResStatus::USER );
   up3.status().setTransact( false, ResStatus::USER );
+
+  // incremental computation must match a fresh counter
+  const auto fresh = [&duc,&pool]() { return getSize( DiskUsageCounter( duc.getMountPoints() ), pool ); };
+  for ( PoolItem pi : { up1, ins, up2, up1, up3, ins, up3, up2 } )
+  {
+    pi.status().setTransact( ! pi.status().transacts(), ResStatus::USER );
+    BOOST_CHECK_EQUAL( getSize( duc, pool ), fresh() );
+  }
+  BOOST_CHECK_EQUAL( getSize( duc, pool ), mkByteSet(  0,  0 ) );
+
+  // copies do not share the remembered computation
+  DiskUsageCounter copy( duc );
+  up2.status().setTransact( true, ResStatus::USER );
+  BOOST_CHECK_EQUAL( getSize( copy, pool ), fresh() );
+  up2.status().setTransact( false, ResStatus::USER );
+  BOOST_CHECK_EQUAL( getSize( duc, pool ), fresh() );
+  BOOST_CHECK_EQUAL( getSize( copy, pool ), fresh() );
+  copy = duc;
+  BOOST_CHECK_EQUAL( getSize( copy, pool ), mkByteSet(  0,  0 ) );
+
+  // a repo added between two computations
+  test.loadRepo( repodir/"repo", "repo2" );
+  PoolQuery q;
+  q.addRepo( "repo2" );
+  q.addDependency( sat::SolvAttr::name, "dutest", Rel::EQ, Edition("2.0") );
+  BOOST_REQUIRE_EQUAL( q.size(), 1 );
+  PoolItem up2b( *q.begin() );
+  BOOST_CHECK_EQUAL( getSize( duc, pool ), fresh() );
+  up2b.status().setTransact( true, ResStatus::USER );
+  BOOST_CHECK_EQUAL( getSize( duc, pool ), fresh() );
+  up2b.status().setTransact( false, ResStatus::USER );
+  BOOST_CHECK_EQUAL( getSize( duc, pool ), mkByteSet(  0,  0 ) );
 }
@@ -0,0 +1,75 @@
+#include <boost/test/unit_test.hpp>
+
+#include <zypp/RepoManager.h>
+#include <zypp/TmpPath.h>
+#include <zypp/PathInfo.h>
+#include <zypp/repo/RepoException.h>
+
+using namespace zypp;
+
+#define DATADIR (Pathname(TESTS_SRC_DIR) + "/repo/yum/data")
+
+static RepoInfo makeRepo( const std::string & alias_r, const std::vector<Url> & urls_r )
+{
+  RepoInfo repo;
+  repo.setAlias( alias_r );
+  repo.setGpgCheck( false );
+  for ( const Url & url : urls_r )
+    repo.addBaseUrl( url );
+  return repo;
+}
+
+static bool hasMetadata( const RepoManager & manager_r, const RepoInfo & repo_r )
+{ return PathInfo( manager_r.metadataPath( repo_r ) / "repodata/repomd.xml" ).isFile(); }
+
+BOOST_AUTO_TEST_CASE(refresh_metadata_partial_failure)
+{
+  filesystem::TmpDir tmp;
+  RepoManager manager( RepoManagerOptions::makeTestSetup( tmp ) );
+
+  const Url good { (DATADIR / "ZCHUNK").asDirUrl() };
+  const Url bad { (DATADIR / "nonexisting").asDirUrl() };
+
+  RepoInfoList repos {
+    makeRepo( "good", { good } ),
+    makeRepo( "bad", { bad } ),
+    makeRepo( "fallback", { bad, good } ),	// 1st url fails, 2nd one is used
+    makeRepo( "nourl", {} ),
+  };
+
+  RepoManager::RefreshMetadataErrors errors { manager.refreshMetadata( repos ) };
+  BOOST_CHECK_EQUAL( errors.size(), 2 );
+  BOOST_CHECK( errors.count( "bad" ) );
+  BOOST_CHECK( errors.count( "nourl" ) );
+  for ( const auto & [ alias, error ] : errors )
+  {
+    BOOST_CHECK_MESSAGE( error, alias );
+    BOOST_CHECK_THROW( std::rethrow_exception( error ), repo::RepoException );
+  }
+
+  // the failing repos do not stop the others
+  for ( const RepoInfo & repo : repos )
+    BOOST_CHECK_EQUAL( hasMetadata( manager, repo ), ! errors.count( repo.alias() ) );
+
+  // the same as refreshing them one by one
+  for ( const RepoInfo & repo : repos )
+  {
+    if ( errors.count( repo.alias() ) )
+      BOOST_CHECK_THROW( manager.refreshMetadata( repo ), repo::RepoException );
+    else
+      BOOST_CHECK_NO_THROW( manager.refreshMetadata( repo ) );
+  }
+}
+
+BOOST_AUTO_TEST_CASE(refresh_metadata_no_errors)
+{
+  filesystem::TmpDir tmp;
+  RepoManager manager( RepoManagerOptions::makeTestSetup( tmp ) );
+
+  RepoInfoList repos { makeRepo( "good", { (DATADIR / "ZCHUNK").asDirUrl() } ) };
+  BOOST_CHECK( manager.refreshMetadata( repos ).empty() );
+  BOOST_CHECK( hasMetadata( manager, repos.front() ) );
+  // up to date: nothing to do, but no error either
+  BOOST_CHECK( manager.refreshMetadata( repos ).empty() );
+  BOOST_CHECK( manager.refreshMetadata( RepoInfoList() ).empty() );
+}
@@ -0,0 +1,86 @@
+#include "TestSetup.h"
+#include <zypp/sat/Transaction.h>
+#include <zypp/Resolver.h>
+
+static PoolItem getAPi( TestSetup & test_r, const std::string & name_r )
+{
+  for ( const auto & pi : test_r.pool().byName( name_r ) )
+  { if ( ! pi.isSystem() ) return pi; }
+  return PoolItem();
+}
+
+static sat::SolvableQueue queueOf( std::initializer_list<PoolItem> items_r )
+{
+  sat::SolvableQueue ret;
+  for ( const PoolItem & pi : items_r )
+    ret.push( pi.satSolvable().id() );
+  return ret;
+}
+
+BOOST_AUTO_TEST_CASE(TransactionOrder)
+{
+  TestSetup test( Arch_x86_64 );
+  test.loadTestcaseRepos( TESTS_SRC_DIR"/data/TCTransactionOrder" );
+
+  PoolItem app  { getAPi( test, "app" ) };
+  PoolItem lib  { getAPi( test, "lib" ) };
+  PoolItem base { getAPi( test, "base" ) };
+  PoolItem tool { getAPi( test, "tool" ) };
+  BOOST_REQUIRE( app && lib && base && tool );
+
+  app.status().setTransact( true, ResStatus::USER );
+  tool.status().setTransact( true, ResStatus::USER );
+  BOOST_REQUIRE( test.resolver().resolvePool() );
+
+  sat::Transaction trans { test.resolver().getTransaction() };
+  BOOST_CHECK( ! trans.ordered() );
+  BOOST_CHECK( trans.orderPredecessors( app.satSolvable() ).empty() );
+  BOOST_CHECK( trans.orderComponents().empty() );
+
+  BOOST_REQUIRE( trans.order() );
+  BOOST_CHECK( trans.ordered() );
+
+  // app requires lib requires base; tool is independent
+  BOOST_CHECK_EQUAL( trans.orderPredecessors( app.satSolvable() ), queueOf( { lib } ) );
+  BOOST_CHECK_EQUAL( trans.orderPredecessors( lib.satSolvable() ), queueOf( { base } ) );
+  BOOST_CHECK( trans.orderPredecessors( base.satSolvable() ).empty() );
+  BOOST_CHECK( trans.orderPredecessors( tool.satSolvable() ).empty() );
+
+  std::vector<sat::SolvableQueue> components { trans.orderComponents() };
+  BOOST_REQUIRE_EQUAL( components.size(), 2 );
+  unsigned chain = components[0].size() == 1 ? 1 : 0;	// components are sorted by their first step
+  BOOST_CHECK_EQUAL( components[chain], queueOf( { base, lib, app } ) );
+  BOOST_CHECK_EQUAL( components[1-chain], queueOf( { tool } ) );
+}
+
+BOOST_AUTO_TEST_CASE(TransactionOrderCycle)
+{
+  TestSetup test( Arch_x86_64 );
+  test.loadTestcaseRepos( TESTS_SRC_DIR"/data/TCTransactionOrder" );
+
+  PoolItem cyc1 { getAPi( test, "cyc1" ) };
+  PoolItem cyc2 { getAPi( test, "cyc2" ) };
+  PoolItem cyc3 { getAPi( test, "cyc3" ) };
+  BOOST_REQUIRE( cyc1 && cyc2 && cyc3 );
+
+  cyc1.status().setTransact( true, ResStatus::USER );
+  BOOST_REQUIRE( test.resolver().resolvePool() );
+
+  sat::Transaction trans { test.resolver().getTransaction() };
+  BOOST_REQUIRE( trans.order() );
+
+  // cyc1 requires cyc2 requires cyc3 requires cyc1: one of the three
+  // edges is broken to order the cycle and must not be reported.
+  unsigned edges = 0;
+  for ( const PoolItem & pi : { cyc1, cyc2, cyc3 } )
+  {
+    const sat::SolvableQueue & pred { trans.orderPredecessors( pi.satSolvable() ) };
+    BOOST_CHECK_LE( pred.size(), 1U );
+    edges += pred.size();
+  }
+  BOOST_CHECK_EQUAL( edges, 2 );
+
+  std::vector<sat::SolvableQueue> components { trans.orderComponents() };
+  BOOST_REQUIRE_EQUAL( components.size(), 1 );
+  BOOST_CHECK_EQUAL( components[0].size(), 3 );
+}
@@ -0,0 +1,72 @@
+#include <iostream>
+#include <fstream>
+#include <algorithm>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <boost/test/unit_test.hpp>
+
+#include <zypp/base/String.h>
+#include <zypp/PathInfo.h>
+#include <zypp/TmpPath.h>
+#include <zypp/misc/CheckAccessDeleted.h>
+
+using namespace zypp;
+
+namespace
+{
+  /** The ProcInfo of our own process, if reported. */
+  const CheckAccessDeleted::ProcInfo * findSelf( const CheckAccessDeleted & check_r )
+  {
+    const std::string self { str::numstring( ::getpid() ) };
+    for ( const auto & pinfo : check_r )
+    {
+      if ( pinfo.pid == self )
+        return &pinfo;
+    }
+    return nullptr;
+  }
+}
+
+BOOST_AUTO_TEST_CASE(procscan_mapped_deleted_file)
+{
+  // '/tmp/' and '/var/' are never reported for memory mapped files
+  filesystem::TmpDir tmp( Pathname(TESTS_BUILD_DIR) );
+  const Pathname lib { tmp.path() / "libdeleted.so.1" };
+  if ( str::hasPrefix( lib.asString(), "/tmp/" ) || str::hasPrefix( lib.asString(), "/var/" ) )
+  {
+    BOOST_TEST_MESSAGE( "Skip: " << lib << " is not reported anyway" );
+    return;
+  }
+
+  {
+    std::ofstream out( lib.c_str() );
+    out << std::string( 8192, 'x' );
+  }
+  int fd = ::open( lib.c_str(), O_RDONLY );
+  BOOST_REQUIRE( fd >= 0 );
+  void * mapped = ::mmap( nullptr, 8192, PROT_READ, MAP_SHARED, fd, 0 );
+  ::close( fd );
+  BOOST_REQUIRE( mapped != MAP_FAILED );
+  BOOST_REQUIRE_EQUAL( filesystem::unlink( lib ), 0 );
+
+  const Pathname debugFile { tmp.path() / "debug.lsof" };
+  CheckAccessDeleted check( false );
+  check.setDebugOutputFile( debugFile );
+  check.check( /*verbose*/true );
+  ::munmap( mapped, 8192 );
+
+  const CheckAccessDeleted::ProcInfo * self { findSelf( check ) };
+  BOOST_REQUIRE( self );
+  BOOST_CHECK( std::find( self->files.begin(), self->files.end(), lib.asString() ) != self->files.end() );
+  BOOST_CHECK( ! self->command.empty() );
+
+  // the debug file replays the same result
+  CheckAccessDeleted replay( false );
+  replay.check( debugFile, /*verbose*/true );
+  const CheckAccessDeleted::ProcInfo * replayed { findSelf( replay ) };
+  BOOST_REQUIRE( replayed );
+  BOOST_CHECK_EQUAL( replayed->ppid, self->ppid );
+  BOOST_CHECK_EQUAL( replayed->puid, self->puid );
+  BOOST_CHECK( replayed->files == self->files );
+}
@@ -78,3 +78,56 @@ BOOST_AUTO_TEST_CASE(gz_seek)
     BOOST_REQUIRE_EQUAL( test, "Hello" );
   }
 }
+
+BOOST_AUTO_TEST_CASE(gz_readahead)
+{
+  const zypp::Pathname file = zypp::Pathname(TESTS_BUILD_DIR) / "testreadahead.gz";
+  const unsigned lines = 100000;
+
+  {
+    zypp::ofgzstream strOut( file.c_str() );
+    BOOST_REQUIRE( strOut.is_open() );
+    for ( unsigned i = 0; i < lines; ++i )
+      strOut << "line " << i << "\n";
+  }
+
+  {
+    zypp::ifgzstream str;
+    str.getbuf().setBufferSize( 1000 );
+    str.getbuf().setReadAhead( true );
+    str.open( file.c_str() );
+    BOOST_REQUIRE( str.is_open() );
+    BOOST_REQUIRE( str.getbuf().readAheadActive() );
+    BOOST_REQUIRE_EQUAL( str.getbuf().bufferSize(), 1000 );
+
+    std::string line;
+    unsigned cnt = 0;
+    while ( std::getline( str, line ) ) {
+      BOOST_REQUIRE_EQUAL( line, "line "+std::to_string(cnt) );
+      ++cnt;
+      if ( cnt == 10 ) {
+        // telling the position does not end the read-ahead
+        BOOST_REQUIRE_EQUAL( str.tellg(), 70 );
+        BOOST_REQUIRE( str.getbuf().readAheadActive() );
+      }
+    }
+    BOOST_CHECK_EQUAL( cnt, lines );
+
+    // seeking ends it, but still works
+    str.clear();
+    str.seekg( 5, std::ios_base::beg );
+    BOOST_REQUIRE ( !str.fail() );
+    BOOST_REQUIRE( !str.getbuf().readAheadActive() );
+    std::getline( str, line );
+    BOOST_REQUIRE_EQUAL( line, "0" );
+    std::getline( str, line );
+    BOOST_REQUIRE_EQUAL( line, "line 1" );
+  }
+
+  {
+    // big compressed files are read ahead per default
+    zypp::InputStream iStr( file );
+    BOOST_REQUIRE( typeid( iStr.stream() ) == typeid( zypp::ifgzstream& ) );
+    BOOST_CHECK( dynamic_cast<zypp::ifgzstream&>( iStr.stream() ).getbuf().readAheadActive() );
+  }
+}
@@ -6,6 +6,7 @@
 
 #include <zypp/base/Logger.h>
 #include <zypp/base/Exception.h>
+#include <zypp/base/String.h>
 #include <zypp/KeyRing.h>
 #include <zypp/PublicKey.h>
 #include <zypp/TmpPath.h>
@@ -231,6 +232,37 @@ BOOST_AUTO_TEST_CASE(signature_test)
   }
 }
 
+BOOST_AUTO_TEST_CASE(keyring_session)
+{
+  PublicKey key( DATADIR + "public.asc" );
+
+  TmpDir tmp_dir;
+  KeyRing keyring( tmp_dir.path() );
+  keyring.importKey( key, false );
+
+  // repeated verification uses the same context
+  for ( unsigned i = 0; i < 5; ++i )
+  {
+    BOOST_CHECK( keyring.verifyFileSignature( DATADIR + "repomd.xml", DATADIR + "repomd.xml.asc" ) );
+    BOOST_CHECK( ! keyring.verifyFileSignature( DATADIR + "repomd.xml.corrupted", DATADIR + "repomd.xml.asc" ) );
+  }
+
+  // lookups are case insensitive and accept the fingerprint
+  BOOST_CHECK_EQUAL( keyring.publicKeyData( key.id() ).fingerprint(), key.fingerprint() );
+  BOOST_CHECK_EQUAL( keyring.publicKeyData( str::toLower( key.id() ) ).fingerprint(), key.fingerprint() );
+  BOOST_CHECK_EQUAL( keyring.publicKeyData( key.fingerprint() ).id(), key.id() );
+  BOOST_CHECK( ! keyring.publicKeyData( "0123456789ABCDEF" ) );
+
+  // exported keys are reused until the keyring changes
+  PublicKey exported { keyring.exportPublicKey( key.keyData() ) };
+  BOOST_CHECK_EQUAL( keyring.exportPublicKey( key.keyData() ).path(), exported.path() );
+  BOOST_CHECK_EQUAL( exported.fingerprint(), key.fingerprint() );
+
+  keyring.deleteKey( key.id(), false );
+  BOOST_CHECK( ! keyring.publicKeyData( key.id() ) );
+  BOOST_CHECK( ! keyring.isKeyKnown( key.id() ) );
+}
+
 BOOST_AUTO_TEST_CASE(keyring_import)
 {
   // base sandbox for playing
@@ -8,6 +8,7 @@
 #include <zypp/PoolQueryUtil.tcc>
 #include <zypp/TmpPath.h>
 #include <zypp/Locks.h>
+#include <zypp/pool/LockMatcher.h>
 #include "TestSetup.h"
 
 #define BOOST_TEST_MODULE Locks
@@ -116,3 +117,60 @@ BOOST_AUTO_TEST_CASE( locks_empty )
   locks.removeEmpty();
   BOOST_CHECK( locks.size() == 0 );
 }
+
+BOOST_AUTO_TEST_CASE( locks_matcher )
+{
+  cout << "****precompiled lock matcher****"  << endl;
+  std::list<PoolQuery> queries;
+  {
+    PoolQuery q;        // plain name lock (libzypp style)
+    q.addAttribute( sat::SolvAttr::name, "zypper" );
+    q.addKind( ResKind::package );
+    q.setMatchExact();
+    q.setCaseSensitive( true );
+    queries.push_back( q );
+  }
+  {
+    PoolQuery q;        // plain name lock (zypper style glob without wildcards, any kind)
+    q.addAttribute( sat::SolvAttr::name, "libzypp" );
+    q.setMatchGlob();
+    q.setCaseSensitive( true );
+    queries.push_back( q );
+  }
+  {
+    PoolQuery q;        // needs a PoolQuery
+    q.addAttribute( sat::SolvAttr::name, "yast2-*" );
+    q.setMatchGlob();
+    q.setCaseSensitive( true );
+    queries.push_back( q );
+  }
+  {
+    PoolQuery q;        // needs a PoolQuery
+    q.addString( "zypper" );
+    q.addRepo( "opensuse" );
+    queries.push_back( q );
+  }
+
+  pool::LockMatcher matcher( queries.begin(), queries.end() );
+  BOOST_CHECK_EQUAL( matcher.indexedSize(), 2 );
+  BOOST_CHECK_EQUAL( matcher.queriesSize(), 2 );
+
+  PoolQueryResult expected( queries.begin(), queries.end() );
+  BOOST_CHECK( ! expected.empty() );
+  BOOST_CHECK_EQUAL( matcher.match().size(), expected.size() );
+  for ( sat::Solvable solv : expected )
+    BOOST_CHECK( matcher.match().contains( solv ) );
+
+  // restricted to the solvables of a single repo
+  Repository repo { ResPool::instance().reposFind( "@System" ) };
+  std::vector<sat::Solvable> candidates( repo.solvablesBegin(), repo.solvablesEnd() );
+  PoolQueryResult inRepo { matcher.match( candidates ) };
+  PoolQueryResult expectedInRepo;
+  for ( sat::Solvable solv : expected )
+    if ( solv.repository() == repo )
+      expectedInRepo += solv;
+  BOOST_CHECK( ! expectedInRepo.empty() );
+  BOOST_CHECK_EQUAL( inRepo.size(), expectedInRepo.size() );
+  for ( sat::Solvable solv : expectedInRepo )
+    BOOST_CHECK( inRepo.contains( solv ) );
+}
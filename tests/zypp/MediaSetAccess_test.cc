@@ -306,6 +306,25 @@ void msa_remote_tests_impl() {
     BOOST_CHECK(check_file_exists(file) == true);
   }
 
+  {
+    // providing several files in one batch
+    std::vector<OnMediaLocation> locs {
+      OnMediaLocation("/test.txt"),
+      OnMediaLocation("dir/test-big.txt").setDownloadSize( zypp::ByteCount(7135, zypp::ByteCount::B) ),
+      OnMediaLocation("/test-big.txt").setDownloadSize( zypp::ByteCount(7135, zypp::ByteCount::B) ),
+      OnMediaLocation("/testBADNAME.txt").setOptional( true ),
+    };
+    std::vector<Pathname> files = setaccess.provideFiles( locs );
+    BOOST_REQUIRE_EQUAL( files.size(), locs.size() );
+    BOOST_CHECK(CheckSum::sha1(sha1sum(files[0])) == CheckSum::sha1("2616e23301d7fcf7ac3324142f8c748cd0b6692b"));
+    BOOST_CHECK(check_file_exists(files[1]) == true);
+    BOOST_CHECK(check_file_exists(files[2]) == true);
+    BOOST_CHECK(files[3].empty());
+
+    // a missing file in the batch should throw
+    BOOST_CHECK_THROW(setaccess.provideFiles( { OnMediaLocation("/test.txt"), OnMediaLocation("/testBADNAME.txt") } ), media::MediaFileNotFoundException);
+  }
+
   srv.stop();
 }
 
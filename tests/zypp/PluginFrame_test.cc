@@ -2,10 +2,14 @@
 #include <signal.h>
 
 #include <iostream>
+#include <fstream>
 #include <sstream>
+#include <glib.h>
 
 #include "TestSetup.h"
 #include <zypp/PluginExecutor.h>
+#include <zypp/TmpPath.h>
+#include <zypp/PathInfo.h>
 
 BOOST_AUTO_TEST_CASE(InitialSettings)
 {
@@ -169,6 +173,33 @@ BOOST_AUTO_TEST_CASE(PluginScriptReceive)
   BOOST_CHECK_THROW(  scr.receive(), PluginScriptDiedUnexpectedly );
 }
 
+BOOST_AUTO_TEST_CASE(PluginScriptTryReceive)
+{
+  filesystem::TmpDir tmp;
+  const Pathname script { tmp.path() / "partial" };
+  {
+    // the answer arrives in two parts
+    std::ofstream out( script.c_str() );
+    out << "#!/bin/sh\n"
+        << "printf 'ACK\\n\\n'\n"
+        << "sleep 1\n"
+        << "printf '\\000'\n"
+        << "exec cat\n";
+  }
+  filesystem::chmod( script, 0755 );
+
+  PluginScript scr( script );
+  PluginFrame ret;
+  BOOST_CHECK_THROW( scr.tryReceive( ret ), PluginScriptNotConnected );
+
+  scr.open();
+  GPollFD rfd { scr.receiveFd(), G_IO_IN, 0 };
+  BOOST_REQUIRE_EQUAL( g_poll( &rfd, 1, 3000 ), 1 );
+  BOOST_CHECK( ! scr.tryReceive( ret ) );	// the partial frame is kept...
+  ret = scr.receive();				// ...and completed
+  BOOST_CHECK( ret.isAckCommand() );
+}
+
 BOOST_AUTO_TEST_CASE(PluginExecutorTest)
 {
   PluginExecutor exec;
@@ -190,3 +221,26 @@ BOOST_AUTO_TEST_CASE(PluginExecutorTest)
   exec.send( PluginFrame( "ERROR" ) );
   BOOST_CHECK_EQUAL( exec.size(), 0 );	// deleted failing scripts
 }
+
+BOOST_AUTO_TEST_CASE(PluginExecutorLatency)
+{
+  PluginExecutor exec;
+  BOOST_CHECK_EQUAL( exec.latencies().size(), 0 );
+
+  exec.load( "/bin/cat" );
+  exec.load( "/bin/cat" );
+  exec.send( PluginFrame( "ACK" ) );	// answered concurrently
+
+  const std::vector<PluginExecutor::Latency> & latencies { exec.latencies() };
+  BOOST_REQUIRE_EQUAL( latencies.size(), 2 );
+  for ( const auto & latency : latencies )
+  {
+    BOOST_CHECK_EQUAL( latency.script, "/bin/cat" );
+    BOOST_CHECK_EQUAL( latency.frames, 2 );	// PLUGINBEGIN and ACK
+    BOOST_CHECK( latency.max <= latency.total );
+  }
+
+  exec.send( PluginFrame( "ERROR" ) );
+  BOOST_CHECK_EQUAL( exec.size(), 0 );
+  BOOST_CHECK_EQUAL( exec.latencies().size(), 2 );	// closed plugins are kept
+}
@@ -46,3 +46,30 @@ BOOST_AUTO_TEST_CASE(repoinfo_test)
 
   web.stop();
 }
+
+BOOST_AUTO_TEST_CASE(repoinfo_interned_strings)
+{
+  RepoInfo a;
+  RepoInfo b;
+  BOOST_CHECK( a == b );
+  BOOST_CHECK( a.alias().empty() );
+
+  a.setAlias( "home/repo" );
+  BOOST_CHECK_EQUAL( a.alias(), "home/repo" );
+  BOOST_CHECK_EQUAL( a.escaped_alias(), "home_repo" );
+  BOOST_CHECK( a != b );
+  BOOST_CHECK( b < a );	// empty alias first
+
+  b.setAlias( std::string("home/") + "repo" );
+  BOOST_CHECK( a == b );
+  BOOST_CHECK( !( a < b ) && !( b < a ) );
+  b.setAlias( "home/repo2" );
+  BOOST_CHECK( a < b );
+
+  a.setService( "svc" );
+  a.setTargetDistribution( "" );
+  BOOST_CHECK_EQUAL( a.service(), "svc" );
+  BOOST_CHECK( a.targetDistribution().empty() );
+  a.setService( "" );
+  BOOST_CHECK( a.service().empty() );
+}
@@ -98,3 +98,25 @@ BOOST_AUTO_TEST_CASE(inrOnlyRequires)
   // Fillup only namespace recommends
   BOOST_checkresult( resolve( inrMode|onlyRequires ), { Apde } );
 }
+
+BOOST_AUTO_TEST_CASE(stats)
+{
+  Ap.status().setTransact( true, ResStatus::USER );
+  resolve();
+  Ap.status().setTransact( false, ResStatus::USER );
+
+  const ResolverStats & stats { test.resolver().stats() };
+  BOOST_CHECK_EQUAL( stats[ResolverStats::SolverInit].calls,     1 );
+  BOOST_CHECK_EQUAL( stats[ResolverStats::PoolPrepare].calls,    1 );
+  BOOST_CHECK_EQUAL( stats[ResolverStats::Solve].calls,          1 );
+  BOOST_CHECK_EQUAL( stats[ResolverStats::ResultTransfer].calls, 1 );
+  BOOST_CHECK_EQUAL( stats[ResolverStats::Problems].calls,       0 );
+  BOOST_CHECK( stats.totalWall() >= 0.0 );
+  BOOST_CHECK( stats.rules.total > 0 );
+  BOOST_CHECK_EQUAL( stats.rules.total, stats.rules.pkg + stats.rules.update + stats.rules.feature
+                                        + stats.rules.job + stats.rules.distupgrade + stats.rules.infarch
+                                        + stats.rules.best + stats.rules.choice + stats.rules.learnt + stats.rules.other );
+  BOOST_CHECK( stats.decisions > 0 );
+  BOOST_CHECK_EQUAL( stats.problems, 0 );
+  BOOST_CHECK( stats.pool.solvables > 0 );
+}
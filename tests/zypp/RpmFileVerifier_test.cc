@@ -0,0 +1,86 @@
+#include <fstream>
+#include <sys/stat.h>
+#include <utime.h>
+#include <boost/test/unit_test.hpp>
+
+#include <zypp/PathInfo.h>
+#include <zypp/TmpPath.h>
+#include <zypp/target/rpm/RpmHeader.h>
+#include <zypp/target/rpm/RpmFileVerifier.h>
+
+using namespace zypp;
+using target::rpm::RpmHeader;
+using target::rpm::RpmFileVerifier;
+
+#define DATADIR (Pathname(TESTS_SRC_DIR) / "/zypp/data/RpmPkgSigCheck")
+
+namespace
+{
+  void mkfile( const Pathname & file_r, const std::string & content_r, time_t mtime_r )
+  {
+    filesystem::assert_dir( file_r.dirname() );
+    std::ofstream( file_r.c_str() ) << content_r;
+    struct utimbuf times { mtime_r, mtime_r };
+    ::utime( file_r.c_str(), &times );
+  }
+}
+
+BOOST_AUTO_TEST_CASE(verify_size_and_mtime)
+{
+  filesystem::TmpDir root;
+  mkfile( root.path() / "usr/bin/same", "1234", 1000 );
+  mkfile( root.path() / "usr/bin/size", "12345", 1000 );
+  mkfile( root.path() / "usr/bin/mtime", "1234", 2000 );
+  mkfile( root.path() / "etc/nosize", "12345", 1000 );
+
+  RpmFileVerifier verifier( root.path() );
+  verifier.addFile( "a", "/usr/bin/same", 4, 1000 );
+  verifier.addFile( "a", "/usr/bin/size", 4, 1000 );
+  verifier.addFile( "b", "/usr/bin/mtime", 4, 1000 );
+  verifier.addFile( "b", "/usr/bin/missing", 4, 1000 );
+  verifier.addFile( "c", "/etc/nosize", 4, 1000, /*checkSize*/false );
+  BOOST_CHECK_EQUAL( verifier.size(), 5 );
+
+  auto changed { verifier.changedFiles() };
+  BOOST_CHECK_EQUAL( changed.size(), 2 );
+  BOOST_CHECK( changed["a"] == RpmFileVerifier::FileList{ "/usr/bin/size" } );
+  BOOST_CHECK( changed["b"] == RpmFileVerifier::FileList{ "/usr/bin/mtime" } );
+}
+
+BOOST_AUTO_TEST_CASE(verify_header)
+{
+  RpmHeader::constPtr hdr { RpmHeader::readPackage( DATADIR / "unsigned.rpm", RpmHeader::NOVERIFY ) };
+  BOOST_REQUIRE( hdr );
+
+  filesystem::TmpDir root;
+  {
+    // nothing installed: missing files are not reported
+    RpmFileVerifier verifier( root.path() );
+    verifier.add( hdr->tag_name(), *hdr );
+    BOOST_CHECK( verifier.changedFiles().empty() );
+  }
+
+  for ( const auto & info : hdr->tag_fileinfos() )
+  {
+    if ( info.ghost || ! S_ISREG( info.mode ) )
+      continue;
+
+    // a regular file with the expected size and mtime is unchanged
+    const Pathname file { root.path() / info.filename };
+    mkfile( file, std::string( info.size, 'x' ), info.mtime );
+    {
+      RpmFileVerifier verifier( root.path() );
+      verifier.add( hdr->tag_name(), *hdr );
+      BOOST_CHECK( verifier.changedFiles().empty() );
+    }
+
+    mkfile( file, std::string( info.size + 1, 'x' ), info.mtime );
+    {
+      RpmFileVerifier verifier( root.path() );
+      verifier.add( hdr->tag_name(), *hdr );
+      auto changed { verifier.changedFiles() };
+      BOOST_CHECK( changed[hdr->tag_name()] == RpmFileVerifier::FileList{ info.filename.asString() } );
+    }
+    break;
+  }
+}
@@ -0,0 +1,90 @@
+#include <boost/test/unit_test.hpp>
+
+#include <fstream>
+#include <sstream>
+#include <zypp/Pathname.h>
+#include <zypp/target/rpm/RpmHeaderPrefetch.h>
+
+using namespace zypp;
+using target::rpm::RpmHeaderPrefetch;
+
+#define DATADIR (Pathname(TESTS_SRC_DIR) / "/zypp/data/RpmPkgSigCheck")
+
+static std::string readAll( FILE * fp_r )
+{
+  std::string ret;
+  char buf[1024];
+  for ( size_t got; ( got = ::fread( buf, 1, sizeof(buf), fp_r ) ); )
+    ret.append( buf, got );
+  return ret;
+}
+
+static std::string readFile( const Pathname & file_r )
+{
+  std::ifstream in( file_r.c_str(), std::ios_base::in | std::ios_base::binary );
+  std::ostringstream buf;
+  buf << in.rdbuf();
+  return buf.str();
+}
+
+BOOST_AUTO_TEST_CASE(rpmheaderprefetch_memory_and_file)
+{
+  const std::string rpm { readFile( DATADIR / "signed.rpm" ) };
+  BOOST_REQUIRE( ! rpm.empty() );
+
+  RpmHeaderPrefetch prefetch;
+  prefetch.add( 1, DATADIR / "signed.rpm" );
+  prefetch.add( 2, DATADIR / "no.rpm" );		// empty file: not an rpm
+  prefetch.add( 3, DATADIR / "nonexisting.rpm" );
+  BOOST_CHECK( prefetch.contains( 1 ) );
+  BOOST_CHECK( ! prefetch.contains( 4 ) );
+
+  // from memory: lead, signature and header, but not the payload
+  {
+    AutoDispose<FILE*> fp { prefetch.open( 1 ) };
+    BOOST_REQUIRE( fp );
+    std::string header { readAll( fp ) };
+    BOOST_CHECK_EQUAL( header.size(), 6816 );
+    BOOST_CHECK( rpm.compare( 0, header.size(), header ) == 0 );
+  }
+  BOOST_CHECK_EQUAL( prefetch.hits(), 1 );
+  BOOST_CHECK_EQUAL( prefetch.misses(), 0 );
+
+  // header can not be read: opened as file
+  {
+    AutoDispose<FILE*> fp { prefetch.open( 2 ) };
+    BOOST_REQUIRE( fp );
+    BOOST_CHECK( readAll( fp ).empty() );
+  }
+  BOOST_CHECK_EQUAL( prefetch.misses(), 1 );
+
+  BOOST_CHECK( ! prefetch.open( 3 ) );
+  BOOST_CHECK( ! prefetch.open( 4 ) );
+  BOOST_CHECK_EQUAL( prefetch.misses(), 2 );	// unknown ids are not counted
+}
+
+BOOST_AUTO_TEST_CASE(rpmheaderprefetch_budget)
+{
+  const std::string rpm { readFile( DATADIR / "signed.rpm" ) };
+
+  // no memory at all: every package is opened as file
+  RpmHeaderPrefetch prefetch( 0 );
+  prefetch.add( 1, DATADIR / "signed.rpm" );
+  {
+    AutoDispose<FILE*> fp { prefetch.open( 1 ) };
+    BOOST_REQUIRE( fp );
+    BOOST_CHECK( readAll( fp ) == rpm );
+  }
+  BOOST_CHECK_EQUAL( prefetch.hits(), 0 );
+  BOOST_CHECK_EQUAL( prefetch.misses(), 1 );
+
+  // room for one header: the older one is dropped when the next window is read
+  RpmHeaderPrefetch small( 7000 );
+  small.add( 1, DATADIR / "signed.rpm" );
+  small.open( 1 );
+  small.add( 2, DATADIR / "signed.rpm" );
+  small.open( 2 );
+  small.open( 1 );
+  BOOST_CHECK_EQUAL( small.hits(), 2 );
+  BOOST_CHECK_EQUAL( small.misses(), 1 );
+}
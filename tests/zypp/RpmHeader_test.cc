@@ -0,0 +1,28 @@
+#include <boost/test/unit_test.hpp>
+
+#include <zypp/Pathname.h>
+#include <zypp/target/rpm/RpmHeader.h>
+
+using namespace zypp;
+using target::rpm::RpmHeader;
+
+#define DATADIR (Pathname(TESTS_SRC_DIR) / "/zypp/data/RpmPkgSigCheck")
+
+BOOST_AUTO_TEST_CASE(rpmheader_string_views)
+{
+  RpmHeader::constPtr hdr { RpmHeader::readPackage( DATADIR / "unsigned.rpm", RpmHeader::NOVERIFY ) };
+  BOOST_REQUIRE( hdr );
+
+  BOOST_CHECK_EQUAL( hdr->string_view( RPMTAG_NAME ), hdr->tag_name() );
+  BOOST_CHECK_EQUAL( hdr->string_view( RPMTAG_VERSION ), hdr->tag_version() );
+  BOOST_CHECK_EQUAL( hdr->string_view( RPMTAG_ARCH ), hdr->tag_arch().asString() );
+
+  std::vector<std::string_view> views;
+  const std::list<std::string> names { hdr->stringList_val( RPMTAG_PROVIDENAME ) };
+  BOOST_REQUIRE_EQUAL( hdr->string_views( RPMTAG_PROVIDENAME, views ), names.size() );
+  BOOST_CHECK( std::equal( views.begin(), views.end(), names.begin() ) );
+
+  // type mismatch: no values
+  BOOST_CHECK_EQUAL( hdr->string_views( RPMTAG_NAME, views ), 0 );
+  BOOST_CHECK( views.empty() );
+}
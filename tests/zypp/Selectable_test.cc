@@ -352,3 +352,117 @@ BOOST_AUTO_TEST_CASE(pickstatus_cycle)
 }
 
 /////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE(lazy_proxy)
+{
+  // Selectables are created on demand; a lookup and a later iteration must agree.
+  ResPoolProxy poolProxy( test.poolProxy() );
+  ui::Selectable::Ptr s( poolProxy.lookup( ResKind::package, "candidate" ) );
+  BOOST_REQUIRE( s );
+  BOOST_CHECK_EQUAL( poolProxy.lookup( ResKind::package, "candidate" ), s );
+  BOOST_CHECK( ! poolProxy.lookup( ResKind::package, "no_such_package" ) );
+
+  std::set<IdString> idents;
+  for ( const PoolItem & pi : test.pool().byKind<Package>() )
+    idents.insert( pi.ident() );
+  BOOST_CHECK_EQUAL( poolProxy.size<Package>(), idents.size() );
+
+  unsigned found = 0;
+  for ( const ui::Selectable::Ptr & sel : poolProxy.byKind<Package>() )
+  {
+    BOOST_CHECK_EQUAL( sel->kind(), ResKind::package );
+    BOOST_CHECK_EQUAL( poolProxy.lookup( sel->ident() ), sel );
+    if ( sel == s )
+      ++found;
+  }
+  BOOST_CHECK_EQUAL( found, 1 );
+  BOOST_CHECK( poolProxy.size() >= poolProxy.size<Package>() );
+}
+
+/////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE(save_restore_state)
+{
+  ResPoolProxy poolProxy( test.poolProxy() );
+  poolProxy.saveState();
+  BOOST_CHECK( ! poolProxy.diffState() );
+  BOOST_CHECK( poolProxy.diffStateIds().empty() );
+
+  ui::Selectable::Ptr sel( poolProxy.lookup( ResKind::package, "available_only" ) );
+  BOOST_REQUIRE( sel );
+  PoolItem pi( sel->candidateObj() );
+  BOOST_REQUIRE( pi );
+  ResStatus saved( pi.status() );
+
+  // solver changes are ignored...
+  pi.status().setTransact( true, ResStatus::SOLVER );
+  BOOST_CHECK( ! poolProxy.diffState() );
+  // ...user changes are not
+  pi.status().setTransact( true, ResStatus::USER );
+  BOOST_CHECK( poolProxy.diffState() );
+  BOOST_CHECK( poolProxy.diffState<Package>() );
+  BOOST_CHECK( ! poolProxy.diffState( ResKind::pattern ) );
+
+  sat::SolvableQueue ids( poolProxy.diffStateIds() );
+  BOOST_CHECK_EQUAL( ids.size(), 1U );
+  BOOST_CHECK( ids.contains( pi.id() ) );
+  BOOST_CHECK_EQUAL( poolProxy.diffStateIds<Package>().size(), 1U );
+
+  poolProxy.restoreState();
+  BOOST_CHECK_EQUAL( pi.status(), saved );
+  BOOST_CHECK( ! poolProxy.diffState() );
+}
+
+BOOST_AUTO_TEST_CASE(save_restore_state_shared)
+{
+  // A default constructed proxy saves and restores the PoolItems one by one.
+  // Both use the same snapshot.
+  ResPoolProxy poolProxy( test.poolProxy() );
+  ResPoolProxy itemProxy;
+
+  ui::Selectable::Ptr sel( poolProxy.lookup( ResKind::package, "available_only" ) );
+  BOOST_REQUIRE( sel );
+  PoolItem pi( sel->candidateObj() );
+  BOOST_REQUIRE( pi );
+  ResStatus saved( pi.status() );
+
+  itemProxy.saveState();
+  pi.status().setTransact( true, ResStatus::USER );
+  BOOST_CHECK( poolProxy.diffState() );
+  poolProxy.restoreState();
+  BOOST_CHECK_EQUAL( pi.status(), saved );
+  BOOST_CHECK( ! itemProxy.diffState() );
+
+  poolProxy.saveState();
+  pi.status().setTransact( true, ResStatus::USER );
+  BOOST_CHECK( itemProxy.diffState() );
+  itemProxy.restoreState();
+  BOOST_CHECK_EQUAL( pi.status(), saved );
+  BOOST_CHECK( ! poolProxy.diffState() );
+}
+
+/////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE(proxy_follows_pool_changes)
+{
+  ResPoolProxy poolProxy( test.poolProxy() );
+  ui::Selectable::Ptr sel( poolProxy.lookup( ResKind::package, "available_only" ) );
+  BOOST_REQUIRE( sel );
+  BOOST_CHECK_EQUAL( sel->availableSize(), 2 );
+  size_t packages = poolProxy.size<Package>();
+
+  // an additional repo adds items to the existing idents...
+  Repository repo( sat::Pool::instance().reposInsert( "proxy_follows_pool_changes" ) );
+  repo.addTesttags( TESTS_SRC_DIR"/data/TCSelectable/RepoLOW.repo" );
+  sel = poolProxy.lookup( ResKind::package, "available_only" );
+  BOOST_REQUIRE( sel );
+  BOOST_CHECK_EQUAL( sel->availableSize(), 4 );
+  BOOST_CHECK_EQUAL( poolProxy.size<Package>(), packages );
+
+  // ...and removing it restores the previous content
+  repo.eraseFromPool();
+  sel = poolProxy.lookup( ResKind::package, "available_only" );
+  BOOST_REQUIRE( sel );
+  BOOST_CHECK_EQUAL( sel->availableSize(), 2 );
+  BOOST_CHECK_EQUAL( poolProxy.size<Package>(), packages );
+}
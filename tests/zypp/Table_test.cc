@@ -0,0 +1,116 @@
+#include <boost/test/unit_test.hpp>
+#include <sstream>
+#include <zypp-tui/application.h>
+#include <zypp-tui/Table.h>
+
+using namespace ztui;
+
+namespace
+{
+  struct NoColorApplication : public Application
+  {
+    NoColorApplication()
+    { mutableConfig().do_colors = false; }
+  };
+
+  Table testTable()
+  {
+    Table tbl;
+    tbl.lineStyle( Ascii );
+    tbl << ( TableHeader() << table::Column( "Name", table::CStyle::SortCi ) << "Size" );
+    tbl << ( TableRow() << "pkg10" << "20" );
+    tbl << ( TableRow() << "pkg9"  << "3" );
+    tbl << ( TableRow() << "pkg2"  << "100" );
+    tbl << ( TableRow() << "pkg1"  << "3" );
+    return tbl;
+  }
+
+  std::string asString( const Table & tbl_r )
+  {
+    std::ostringstream str;
+    str << tbl_r;
+    return str.str();
+  }
+}
+
+BOOST_AUTO_TEST_CASE(sorted_table)
+{
+  NoColorApplication app;
+  Table tbl { testTable() };
+
+  // numeric column, rows with equal values keep their order
+  tbl.sort( 1 );
+  BOOST_CHECK_EQUAL( asString( tbl ),
+                     "Name  | Size\n"
+                     "------+-----\n"
+                     "pkg9  | 3\n"
+                     "pkg1  | 3\n"
+                     "pkg10 | 20\n"
+                     "pkg2  | 100\n" );
+
+  // string column in natural order
+  tbl.sort( 0 );
+  BOOST_CHECK_EQUAL( asString( tbl ),
+                     "Name  | Size\n"
+                     "------+-----\n"
+                     "pkg1  | 3\n"
+                     "pkg2  | 100\n"
+                     "pkg9  | 3\n"
+                     "pkg10 | 20\n" );
+
+  // both columns
+  tbl.sort( { 1, 0 } );
+  BOOST_CHECK_EQUAL( asString( tbl ),
+                     "Name  | Size\n"
+                     "------+-----\n"
+                     "pkg1  | 3\n"
+                     "pkg9  | 3\n"
+                     "pkg10 | 20\n"
+                     "pkg2  | 100\n" );
+}
+
+BOOST_AUTO_TEST_CASE(row_widths)
+{
+  NoColorApplication app;
+  TableRow row;
+  row << "pkg" << "3";
+  BOOST_CHECK_EQUAL( row.widths().size(), 2 );
+  BOOST_CHECK_EQUAL( row.widths()[0], 3 );
+  BOOST_CHECK_EQUAL( row.widths()[1], 1 );
+
+  // the cache follows changes to the columns
+  row.columns()[1] = "1000";
+  BOOST_CHECK_EQUAL( row.widths()[1], 4 );
+  row << "x86_64";
+  BOOST_REQUIRE_EQUAL( row.widths().size(), 3 );
+  BOOST_CHECK_EQUAL( row.widths()[2], 6 );
+}
+
+BOOST_AUTO_TEST_CASE(streamed_table)
+{
+  NoColorApplication app;
+  Table tbl { testTable() };
+  std::ostringstream str;
+  tbl.streamTo( str, { 5, 4 } );
+  tbl << ( TableRow() << "pkg100" << "7" );
+  BOOST_CHECK_EQUAL( str.str(),
+                     "Name  | Size\n"
+                     "------+-----\n"
+                     "pkg10 | 20\n"
+                     "pkg9  | 3\n"
+                     "pkg2  | 100\n"
+                     "pkg1  | 3\n"
+                     "pkg-> | 7\n" );
+
+  // the header is written once, even if there are no rows
+  Table empty;
+  empty.lineStyle( Ascii );
+  empty << ( TableHeader() << "Name" << "Size" );
+  std::ostringstream estr;
+  empty.streamTo( estr, { 5, 4 } );
+  estr << empty;
+  estr << empty;
+  BOOST_CHECK_EQUAL( estr.str(),
+                     "Name  | Size\n"
+                     "------+-----\n" );
+}
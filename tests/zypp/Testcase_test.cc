@@ -0,0 +1,87 @@
+#include <boost/test/unit_test.hpp>
+
+#include <fstream>
+#include <sstream>
+#include "TestSetup.h"
+#include <zypp/ResPool.h>
+#include <zypp/TmpPath.h>
+
+#define TCDIR (Pathname(TESTS_SRC_DIR) / "/data/TCNamespaceRecommends")
+
+namespace
+{
+  /** The pool content as "repo:name-edition.arch". */
+  std::set<std::string> poolContent()
+  {
+    std::set<std::string> ret;
+    for ( const sat::Solvable & solv : sat::Pool::instance().solvables() )
+      ret.insert( solv.repository().alias() + ":" + solv.asString() );
+    return ret;
+  }
+
+  /** Update aspell and return the transacting items. */
+  std::set<std::string> resolve( TestSetup & test )
+  {
+    for ( const PoolItem & pi : test.pool().byName( "aspell" ) )
+    {
+      if ( ! pi.isSystem() )
+        pi.status().setTransact( true, ResStatus::USER );
+    }
+    BOOST_REQUIRE( test.resolver().resolvePool() );
+
+    std::set<std::string> ret;
+    for ( const PoolItem & pi : test.pool() )
+    {
+      if ( pi.status().transacts() )
+        ret.insert( pi.repository().alias() + ":" + pi.satSolvable().asString() );
+    }
+    return ret;
+  }
+
+  std::string readFile( const Pathname & file_r )
+  {
+    std::ifstream in( file_r.c_str() );
+    std::ostringstream str;
+    str << in.rdbuf();
+    return str.str();
+  }
+}
+
+BOOST_AUTO_TEST_CASE(binary_testcase_roundtrip)
+{
+  filesystem::TmpDir tmp;
+  const Pathname textTc { tmp.path() / "text" };
+  const Pathname solvTc { tmp.path() / "solv" };
+
+  std::set<std::string> content;
+  std::set<std::string> result;
+  {
+    TestSetup test;
+    test.loadTestcaseRepos( TCDIR );
+    content = poolContent();
+    result = resolve( test );
+    BOOST_REQUIRE( ! result.empty() );
+
+    BOOST_REQUIRE( test.resolver().createSolverTestcase( textTc.asString(), true, false ) );
+    BOOST_REQUIRE( test.resolver().createSolverTestcase( solvTc.asString(), true, true ) );
+  }
+
+  // binary repos, no libsolv testcase
+  BOOST_CHECK( ! PathInfo( solvTc / "testcase.t" ).isExist() );
+  const std::string control { readFile( solvTc / "zypp-control.yaml" ) };
+  BOOST_CHECK( control.find( "format: solv" ) != std::string::npos );
+  BOOST_CHECK( control.find( "update.solv" ) != std::string::npos );
+  BOOST_CHECK_EQUAL( readFile( solvTc / "solver.result" ), readFile( textTc / "solver.result" ) );
+
+  // both testcases load the same pool and solve the same way
+  for ( const Pathname & tc : { textTc, solvTc } )
+  {
+    BOOST_TEST_MESSAGE( "Load " << tc );
+    TestSetup test;
+    test.loadTestcaseRepos( tc );
+    const std::set<std::string> & tcContent { poolContent() };
+    BOOST_CHECK_EQUAL_COLLECTIONS( tcContent.begin(), tcContent.end(), content.begin(), content.end() );
+    const std::set<std::string> & tcResult { resolve( test ) };
+    BOOST_CHECK_EQUAL_COLLECTIONS( tcResult.begin(), tcResult.end(), result.begin(), result.end() );
+  }
+}
@@ -0,0 +1,59 @@
+// Boost.Test
+#include <boost/test/unit_test.hpp>
+
+#include <zypp-core/base/ZstdStream>
+#include <zypp/Pathname.h>
+#include <zypp-core/base/InputStream>
+#include <zypp/PathInfo.h>
+
+BOOST_AUTO_TEST_CASE(zstd_simple_read_write)
+{
+  const zypp::Pathname file = zypp::Pathname(TESTS_BUILD_DIR) / "test.zst";
+  const std::string testString("HelloWorld");
+
+  {
+    zypp::ofzstdstream strOut( file.c_str() );
+    BOOST_REQUIRE( strOut.is_open() );
+    strOut << testString;
+  }
+
+  BOOST_REQUIRE_EQUAL( zypp::filesystem::zipType( file ), zypp::filesystem::ZT_ZSTD );
+
+  {
+    std::string test;
+    zypp::ifzstdstream str( file.c_str() );
+    str >> test;
+    BOOST_REQUIRE_EQUAL( test, testString );
+  }
+
+  {
+    zypp::InputStream iStr( file );
+    BOOST_REQUIRE( typeid( iStr.stream() ) == typeid( zypp::ifzstdstream& ) );
+  }
+}
+
+BOOST_AUTO_TEST_CASE(zstd_big_readahead)
+{
+  const zypp::Pathname file = zypp::Pathname(TESTS_BUILD_DIR) / "testbig.zst";
+  const unsigned lines = 100000;
+
+  {
+    zypp::ofzstdstream strOut( file.c_str() );
+    BOOST_REQUIRE( strOut.is_open() );
+    for ( unsigned i = 0; i < lines; ++i )
+      strOut << "line " << i << "\n";
+  }
+
+  zypp::ifzstdstream str;
+  str.getbuf().setReadAhead( true );
+  str.open( file.c_str() );
+  BOOST_REQUIRE( str.getbuf().readAheadActive() );
+
+  std::string line;
+  unsigned cnt = 0;
+  while ( std::getline( str, line ) ) {
+    BOOST_REQUIRE_EQUAL( line, "line "+std::to_string(cnt) );
+    ++cnt;
+  }
+  BOOST_CHECK_EQUAL( cnt, lines );
+}
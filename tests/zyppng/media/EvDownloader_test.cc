@@ -685,3 +685,80 @@ BOOST_DATA_TEST_CASE( dltest_auth, bdata::make( withSSL ), withSSL )
     BOOST_REQUIRE ( allStates == std::vector<zyppng::Download::State>({ zyppng::Download::InitialState, zyppng::Download::DlMetaLinkInfo, zyppng::Download::PrepareMulti, zyppng::Download::DlMetalink, zyppng::Download::Finished}) );
   }
 }
+
+bool withMetalink[] = { true, false };
+
+BOOST_DATA_TEST_CASE( dltest_conditional, bdata::make( withSSL ) * bdata::make( withMetalink ), withSSL, withMetalink )
+{
+  auto ev = zyppng::EventLoop::create();
+
+  zyppng::Downloader::Ptr downloader = std::make_shared<zyppng::Downloader>();
+
+  const std::string dummyContent = "This is just some dummy content,\nto test conditional downloads.\n";
+  const std::string etag = "\"abcdef-42\"";
+  const std::string lastModified = "Tue, 21 May 2019 08:30:59 GMT";
+
+  int countFullResponses = 0;
+  WebServer web((zypp::Pathname(TESTS_SRC_DIR)/"data"/"dummywebroot").c_str(), 10001, withSSL );
+  web.addRequestHandler( "getData", [&]( WebServer::Request &req ){
+    auto it = req.params.find( "HTTP_IF_NONE_MATCH" );
+    if ( it != req.params.end() && it->second == etag ) {
+      req.rout << "Status: 304 Not Modified\r\n"
+               << "ETag: " << etag << "\r\n\r\n";
+      return;
+    }
+    countFullResponses++;
+    req.rout << WebServer::makeResponseString( "200", { "ETag: " + etag, "Last-Modified: " + lastModified + "\r\n" }, dummyContent );
+  });
+  BOOST_REQUIRE( web.start() );
+
+  zypp::filesystem::TmpDir targetDir;
+  zyppng::Url weburl (web.url());
+  weburl.setPathName("/handler/getData");
+  zyppng::TransferSettings set = web.transferSettings();
+
+  const auto &runDownload = [&]( zyppng::DownloadSpec &&spec ) {
+    spec.setTransferSettings( set ).setMetalinkEnabled( withMetalink );
+    zyppng::Download::Ptr dl = downloader->downloadFile( std::move(spec) );
+    dl->sigFinished().connect([&]( zyppng::Download & ){
+      ev->quit();
+    });
+    dl->start();
+    ev->run();
+    return dl;
+  };
+
+  // no validators yet, we get the file and the validators to use next time
+  {
+    auto dl = runDownload( zyppng::DownloadSpec( weburl, targetDir.path() / "first" ) );
+    BOOST_TEST_REQ_SUCCESS( dl );
+    BOOST_REQUIRE( !dl->notModified() );
+    BOOST_REQUIRE_EQUAL( dl->responseETag(), etag );
+    BOOST_REQUIRE_EQUAL( dl->responseLastModified(), lastModified );
+    BOOST_REQUIRE_EQUAL( TestTools::readFile( targetDir.path() / "first" ), dummyContent );
+    BOOST_REQUIRE_EQUAL( countFullResponses, 1 );
+  }
+
+  // matching validator, nothing is downloaded
+  {
+    zyppng::DownloadSpec spec( weburl, targetDir.path() / "second" );
+    spec.setIfNoneMatch( etag ).setIfModifiedSince( lastModified );
+    auto dl = runDownload( std::move(spec) );
+    BOOST_TEST_REQ_SUCCESS( dl );
+    BOOST_REQUIRE( dl->notModified() );
+    BOOST_REQUIRE( !zypp::PathInfo( targetDir.path() / "second" ).isExist() );
+    BOOST_REQUIRE_EQUAL( countFullResponses, 1 );
+  }
+
+  // outdated validator, we get the file again
+  {
+    zyppng::DownloadSpec spec( weburl, targetDir.path() / "third" );
+    spec.setIfNoneMatch( "\"outdated\"" );
+    auto dl = runDownload( std::move(spec) );
+    BOOST_TEST_REQ_SUCCESS( dl );
+    BOOST_REQUIRE( !dl->notModified() );
+    BOOST_REQUIRE_EQUAL( dl->responseETag(), etag );
+    BOOST_REQUIRE_EQUAL( TestTools::readFile( targetDir.path() / "third" ), dummyContent );
+    BOOST_REQUIRE_EQUAL( countFullResponses, 2 );
+  }
+}
@@ -14,6 +14,7 @@
 #include <zypp-curl/parser/MetaLinkParser>
 #include <zypp-core/fs/PathInfo.h>
 #include <zypp-core/CheckSum.h>
+#include <zypp-media/MediaConfig>
 #include <zypp-media/ng/private/providedbg_p.h>
 
 
@@ -112,6 +113,15 @@ zyppng::expected<zyppng::worker::WorkerCaps> NetworkProvider::initialize( const
     MIL << "Got anonymous ID setting from controller" << std::endl;
     _dlManager->requestDispatcher()->setHostSpecificHeader("download.opensuse.org", "X-ZYpp-AnonymousId", val );
   }
+  {
+    // Only the controller knows the target root. Without a file the mirror
+    // health data are kept in memory, never in the hosts cache.
+    std::string healthFile;
+    if ( const auto &i = conf.find( std::string(zyppng::MIRROR_HEALTH_FILE) ); i != iEnd )
+      healthFile = i->second;
+    MIL << "Mirror health file: " << healthFile << std::endl;
+    zypp::MediaConfig::instance().setConfigValue( "main", "download.mirror_health_file", healthFile );
+  }
   if ( const auto &i = conf.find( std::string(zyppng::ATTACH_POINT) ); i != iEnd ) {
     const auto &val = i->second;
     MIL << "Got attachpoint from controller: " << val << std::endl;
@@ -298,6 +308,8 @@ void NetworkProvider::provide()
     const auto &expFilesize = req->_spec.value( zyppng::ProvideMsgFields::ExpectedFilesize );
     const auto &checkExistsOnly = req->_spec.value( zyppng::ProvideMsgFields::CheckExistOnly );
     const auto &deltaFile = req->_spec.value( zyppng::ProvideMsgFields::DeltaFile );
+    const auto &ifNoneMatch = req->_spec.value( zyppng::NETWORK_IF_NONE_MATCH );
+    const auto &ifModifiedSince = req->_spec.value( zyppng::NETWORK_IF_MODIFIED_SINCE );
 
     zyppng::DownloadSpec spec(
       url
@@ -307,7 +319,9 @@ void NetworkProvider::provide()
     spec
       .setCheckExistsOnly( checkExistsOnly.valid() ? checkExistsOnly.asBool() : false )
       .setDeltaFile ( deltaFile.valid() ? deltaFile.asString() : zypp::Pathname() )
-      .setMetalinkEnabled ( doMetalink );
+      .setMetalinkEnabled ( doMetalink )
+      .setIfNoneMatch ( ifNoneMatch.valid() ? ifNoneMatch.asString() : std::string() )
+      .setIfModifiedSince ( ifModifiedSince.valid() ? ifModifiedSince.asString() : std::string() );
 
     req->startDownload( _dlManager->downloadFile ( spec ) );
   }
@@ -393,6 +407,16 @@ void NetworkProvider::itemFinished( NetworkProvideItemRef item )
 
       zypp::filesystem::unlink( item->_stagingFileName );
 
+    } else if ( item->_dl->notModified() ) {
+      // 304: nothing was downloaded and no file is handed out, the result only carries
+      // the not-modified header. Nothing may end up in the cache directory where a later
+      // request for the same URL would pick it up as a cache hit.
+      zypp::filesystem::unlink( item->_stagingFileName );
+
+      zyppng::HeaderValueMap extra;
+      extra.set( std::string(zyppng::NETWORK_NOT_MODIFIED), true );
+      provideSuccess( item->_spec.requestId(), false, zypp::Pathname(), extra );
+
     } else {
       const auto errCode = zypp::filesystem::rename( item->_stagingFileName, item->_targetFileName );
       if( errCode ) {
@@ -409,7 +433,12 @@ void NetworkProvider::itemFinished( NetworkProvideItemRef item )
           , {} );
 
       } else {
-        provideSuccess( item->_spec.requestId(), false, item->_targetFileName );
+        zyppng::HeaderValueMap extra;
+        if ( item->_dl->responseETag().size() )
+          extra.set( std::string(zyppng::NETWORK_ETAG), item->_dl->responseETag() );
+        if ( item->_dl->responseLastModified().size() )
+          extra.set( std::string(zyppng::NETWORK_LAST_MODIFIED), item->_dl->responseLastModified() );
+        provideSuccess( item->_spec.requestId(), false, item->_targetFileName, extra );
       }
     }
   } else {
@@ -28,8 +28,11 @@ extern "C"
 #include "BinHeader.h"
 #include "errorcodes.h"
 
+#include <chrono>
 #include <cstdio>
+#include <cstdlib>
 #include <iostream>
+#include <optional>
 #include <signal.h>
 #include <unistd.h>
 
@@ -93,23 +96,138 @@ bool recvBytes ( int fd, char *buf, size_t n ) {
 }
 
 bool sendBytes ( int fd, const void *buf, size_t n ) {
-  const size_t written =  zyppng::eintrSafeCall( ::write, fd, buf, n );
-  return written == n;
+  size_t written = 0;
+  while ( written != n ) {
+    const auto w = zyppng::eintrSafeCall( ::write, fd, reinterpret_cast<const char *>(buf)+written, n - written );
+    if ( w <= 0 )
+      return false;
+
+    written += w;
+  }
+  return true;
 }
 
-template <typename Message>
-bool pushMessage ( const Message &msg ) {
+/*!
+ * The message channel to libzypp.
+ *
+ * Messages are framed like before (size + envelope), but collected in a buffer
+ * and written with a single syscall. Messages libzypp needs to see in time
+ * (begin/end of a step, errors) are written immediately, rpm log lines are
+ * batched until one of those arrives or the buffer is full.
+ *
+ * Progress messages are coalesced: unchanged values are dropped, changing ones
+ * are rate limited. The latest suppressed value is sent before the next
+ * message of any other kind, so libzypp always sees the final progress of a step.
+ */
+class MessageChannel
+{
+public:
+  static MessageChannel & instance() {
+    // never destroyed, librpm may still log while static objects are torn down
+    static MessageChannel *_instance = [](){
+      std::atexit( [](){ MessageChannel::instance().flush(); } );
+      return new MessageChannel();
+    }();
+    return *_instance;
+  }
 
-  zyppng::RpcMessage env;
-  env.set_messagetypename( msg.GetTypeName() );
-  env.set_value( msg.SerializeAsString() );
-  //msg.SerializeToString( env.mutable_value() );
+  template <typename Message>
+  bool push ( const Message &msg, bool batch_r = false ) {
+    flushPendingProgress();
+    enqueue( msg );
+    if ( batch_r && _buffer.size() < maxBatchSize )
+      return _ok;
+    return flush();
+  }
 
-  const auto &str = env.serialize();
-  zyppng::rpc::HeaderSizeType msgSize = str.length();
-  if ( !sendBytes( static_cast<int>( ExpectedFds::MessageFd ), reinterpret_cast< void* >( &msgSize), sizeof (zyppng::rpc::HeaderSizeType) ) )
-    return false;
-  return sendBytes( static_cast<int>( ExpectedFds::MessageFd ), str.c_str(), str.length() );
+  /*!
+   * Push a progress message for \a key_r (step, package or transaction).
+   * Returns \c true if the value was sent or remembered for later.
+   */
+  template <typename Message>
+  bool pushProgress ( const Message &msg, const std::string &key_r, uint32_t amount_r ) {
+    const auto now = std::chrono::steady_clock::now();
+    if ( key_r != _progressKey ) {
+      flushPendingProgress();
+      _progressKey = key_r;
+      _progressSent.reset();
+    } else if ( _progressSent && *_progressSent == amount_r ) {
+      return _ok; // nothing new
+    }
+
+    if ( _progressSent && amount_r != 100 && now - _progressTime < minProgressInterval ) {
+      // keep the latest value, it is sent with the next message
+      _pendingProgress = envelope( msg );
+      _pendingAmount = amount_r;
+      return _ok;
+    }
+
+    _pendingProgress.clear();
+    _progressSent = amount_r;
+    _progressTime = now;
+    enqueue( msg );
+    return flush();
+  }
+
+  bool flush () {
+    if ( _buffer.empty() )
+      return _ok;
+    if ( !sendBytes( static_cast<int>( ExpectedFds::MessageFd ), _buffer.data(), _buffer.size() ) )
+      _ok = false;
+    _buffer.clear();
+    return _ok;
+  }
+
+private:
+  static constexpr std::string::size_type maxBatchSize = 32 * 1024;
+  static constexpr std::chrono::milliseconds minProgressInterval { 100 };
+
+  MessageChannel() {
+    _buffer.reserve( maxBatchSize + 4096 );
+  }
+
+  template <typename Message>
+  static std::string envelope ( const Message &msg ) {
+    zyppng::RpcMessage env;
+    env.set_messagetypename( msg.GetTypeName() );
+    env.set_value( msg.SerializeAsString() );
+    return env.serialize();
+  }
+
+  void enqueueEnvelope ( const std::string &str ) {
+    zyppng::rpc::HeaderSizeType msgSize = str.length();
+    _buffer.append( reinterpret_cast<const char *>( &msgSize ), sizeof (zyppng::rpc::HeaderSizeType) );
+    _buffer.append( str );
+  }
+
+  template <typename Message>
+  void enqueue ( const Message &msg ) {
+    enqueueEnvelope( envelope( msg ) );
+  }
+
+  void flushPendingProgress () {
+    if ( _pendingProgress.empty() )
+      return;
+    enqueueEnvelope( _pendingProgress );
+    _pendingProgress.clear();
+    _progressSent = _pendingAmount;
+    _progressTime = std::chrono::steady_clock::now();
+  }
+
+private:
+  std::string _buffer;
+  bool _ok = true;
+
+  std::string _progressKey;
+  std::optional<uint32_t> _progressSent;
+  std::chrono::steady_clock::time_point _progressTime;
+  std::string _pendingProgress;
+  uint32_t _pendingAmount = 0;
+};
+
+template <typename Message>
+bool pushMessage ( const Message &msg ) {
+  return MessageChannel::instance().push( msg );
 }
 
 bool pushTransactionErrorMessage ( rpmps ps )
@@ -510,6 +628,7 @@ int main( int, char ** )
   // we need to go over the rpm problem set to mark those steps that have failed, we get no other hint on wether
   // it worked or not
   const auto transRes = ::rpmtsRun( ts, nullptr, tsProbFilterFlags );
+  MessageChannel::instance().flush();
   //data.finishCurrentStep( );
 
   if ( transRes != 0 ) {
@@ -738,7 +857,7 @@ void *rpmLibCallback( const void *h, const rpmCallbackType what, const rpm_loff_
       zypp::proto::target::PackageProgress step;
       step.set_stepid( iStep->stepid() );
       step.set_amount( progress );
-      pushMessage( step );
+      MessageChannel::instance().pushProgress( step, zypp::str::numstring( iStep->stepid() ), step.amount() );
 
       break;
     }
@@ -758,13 +877,13 @@ void *rpmLibCallback( const void *h, const rpmCallbackType what, const rpm_loff_
         zypp::proto::target::CleanupProgress step;
         step.set_nvra( header.nvra() );
         step.set_amount( progress );
-        pushMessage( step );
+        MessageChannel::instance().pushProgress( step, step.nvra(), step.amount() );
 
       } else {
         zypp::proto::target::PackageProgress step;
         step.set_stepid( iStep->stepid() );
         step.set_amount( progress );
-        pushMessage( step );
+        MessageChannel::instance().pushProgress( step, zypp::str::numstring( iStep->stepid() ), step.amount() );
       }
       break;
     }
@@ -803,7 +922,7 @@ void *rpmLibCallback( const void *h, const rpmCallbackType what, const rpm_loff_
                                       : 100.0);
       zypp::proto::target::TransProgress prog;
       prog.set_amount( percentage );
-      pushMessage( prog );
+      MessageChannel::instance().pushProgress( prog, "trans", prog.amount() );
       break;
     }
     case RPMCALLBACK_CPIO_ERROR:
@@ -862,7 +981,8 @@ int rpmLogCallback ( rpmlogRec rec, rpmlogCallbackData )
   zypp::proto::target::RpmLog log;
   log.set_level( rpmlogRecPriority(rec)  );
   log.set_line( zypp::str::asString( ::rpmlogRecMessage(rec) ) );
-  pushMessage( log );
+  // log lines are batched, they are sent along with the next step message
+  MessageChannel::instance().push( log, true /*batch*/ );
 
   return logRc;
 }
@@ -77,6 +77,11 @@ namespace zypp {
       getbuf() const
       { return _streambuf; }
 
+      //! Non const version, e.g. to tune the buffer before \ref open.
+      streambuf_type&
+      getbuf()
+      { return _streambuf; }
+
     private:
 
       streambuf_type _streambuf;
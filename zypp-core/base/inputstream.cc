@@ -19,6 +19,9 @@
 #ifdef ENABLE_ZCHUNK_COMPRESSION
   #include <zypp-core/base/ZckStream>
 #endif
+#ifdef ENABLE_ZSTD_COMPRESSION
+  #include <zypp-core/base/ZstdStream>
+#endif
 
 #include <zypp-core/fs/PathInfo.h>
 
@@ -40,15 +43,35 @@ namespace zypp
       return -1;
     }
 
+    /** Compressed files at least this big are decompressed in a read-ahead thread. */
+    constexpr off_t readAheadMinSize = 64 * 1024;
+
+    template <class TStream>
+    inline shared_ptr<std::istream> openStream( const Pathname & file_r, bool readAhead_r )
+    {
+      shared_ptr<TStream> ret { new TStream };
+      ret->getbuf().setReadAhead( readAhead_r );
+      ret->open( file_r.c_str() );
+      return ret;
+    }
+
     inline shared_ptr<std::istream> streamForFile ( const Pathname & file_r )
     {
+      const auto zType = filesystem::zipType( file_r );
+      // Let the parser and the decompression overlap, unless it's not worth the thread.
+      const bool readAhead = ( zType != filesystem::ZT_NONE && PathInfo( file_r ).size() >= readAheadMinSize );
+
 #ifdef ENABLE_ZCHUNK_COMPRESSION
-      if ( const auto zType = filesystem::zipType( file_r ); zType == filesystem::ZT_ZCHNK )
-        return shared_ptr<std::istream>( new ifzckstream( file_r.asString().c_str() ) );
+      if ( zType == filesystem::ZT_ZCHNK )
+        return openStream<ifzckstream>( file_r, readAhead );
+#endif
+#ifdef ENABLE_ZSTD_COMPRESSION
+      if ( zType == filesystem::ZT_ZSTD )
+        return openStream<ifzstdstream>( file_r, readAhead );
 #endif
 
       //fall back to gzstream
-      return shared_ptr<std::istream>( new ifgzstream( file_r.asString().c_str() ) );
+      return openStream<ifgzstream>( file_r, readAhead );
     }
 
     /////////////////////////////////////////////////////////////////
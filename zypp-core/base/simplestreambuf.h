@@ -12,8 +12,14 @@
 #ifndef ZYPP_CORE_BASE_SIMPLESTREAMBUF_H_DEFINED
 #define ZYPP_CORE_BASE_SIMPLESTREAMBUF_H_DEFINED
 
+#include <algorithm>
 #include <streambuf>
 #include <vector>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 
 namespace zypp {
   namespace detail {
@@ -48,6 +54,13 @@ namespace zypp {
      *  using FullStreamBuf = detail::SimpleStreamBuf<streambufimpl>;
      * \endcode
      *
+     * In read mode the backend may optionally be driven by a background thread
+     * (\ref setReadAhead), which reads and decompresses up to \ref readAheadChunks
+     * buffers ahead of the consumer. Parsing and decompressing then overlap. The
+     * backend is used by that thread only, until the stream is closed or a seek
+     * other than telling the current position is requested. Such a seek ends the
+     * read-ahead for the rest of the stream.
+     *
      * \note Currently only supports reading or writing at the same time, but can be extended to support both
      */
     template<typename Impl>
@@ -55,9 +68,37 @@ namespace zypp {
     {
 
       public:
+        /** Default size of the i/o buffer. */
+        static constexpr size_t defaultBufferSize = 64 * 1024;
+        /** Max. number of buffers read ahead in \ref setReadAhead mode. */
+        static constexpr size_t readAheadChunks = 4;
+
+      SimpleStreamBuf( size_t bufsize_r = defaultBufferSize ) : _buffer( std::max<size_t>( bufsize_r, 2 ) ) { }
+      ~SimpleStreamBuf() override { close(); stopReadAhead(); }
+
+        /** Set the size of the i/o buffer. Returns \c false if the stream is already open. */
+        bool setBufferSize( size_t bufsize_r ) {
+          if ( this->isOpen() )
+            return false;
+          _buffer.resize( std::max<size_t>( bufsize_r, 2 ) );
+          return true;
+        }
+
+        /** The size of the i/o buffer. */
+        size_t bufferSize() const
+        { return _buffer.size(); }
 
-      SimpleStreamBuf( size_t bufsize_r = 512) : _buffer( bufsize_r ) { }
-      ~SimpleStreamBuf() override { close(); }
+        /** Whether to read ahead in a background thread. Takes effect on the next \ref open in read mode. */
+        void setReadAhead( bool yesno_r )
+        { _readAhead = yesno_r; }
+
+        /** Whether read-ahead is requested. */
+        bool readAhead() const
+        { return _readAhead; }
+
+        /** Whether the read-ahead thread is currently driving the backend. */
+        bool readAheadActive() const
+        { return bool(_ra); }
 
       SimpleStreamBuf * open( const char * name_r, std::ios_base::openmode mode_r = std::ios_base::in ) {
 
@@ -67,6 +108,8 @@ namespace zypp {
           if ( this->canRead() ) {
             setp( NULL, NULL );
             setg( &(_buffer[0]), &(_buffer[0]), &(_buffer[0]) );
+            if ( _readAhead )
+              startReadAhead();
           } else {
             setp( &(_buffer[0]), &(_buffer[_buffer.size()-1]) );
             setg( NULL, NULL, NULL );
@@ -77,6 +120,8 @@ namespace zypp {
 
         SimpleStreamBuf * close() {
 
+          stopReadAhead();
+
           if ( !this->isOpen() )
             return nullptr;
 
@@ -129,6 +174,9 @@ namespace zypp {
             if ( gptr() < egptr() )
               return traits_type::to_int_type( *gptr() );
 
+            if ( _ra )
+              return underflowReadAhead();
+
             const std::streamsize got = this->readData( &(_buffer[0]), _buffer.size() );
             if ( got > 0 )
             {
@@ -167,6 +215,21 @@ namespace zypp {
               if ( !this->canRead() )
                 return ret;
 
+              if ( _ra ) {
+                // The backend is ahead of us; we know the offset of the buffers end.
+                const off_type currPtrFileOffset = _ra->_delivered - ( egptr() - gptr() );
+                if ( way_r == std::ios_base::cur && off_r == 0 )
+                  return pos_type( currPtrFileOffset );
+
+                stopReadAhead();
+                setg( &(_buffer[0]), &(_buffer[0]), &(_buffer[0]) );
+                if ( way_r == std::ios_base::cur ) {
+                  off_r += currPtrFileOffset;
+                  way_r = std::ios_base::beg;
+                }
+                return pos_type( this->seekTo( off_r, way_r, openMode ) );
+              }
+
               //current physical FP, should point to end of buffer
               const off_type buffEndOff = this->tell();
 
@@ -210,7 +273,91 @@ namespace zypp {
 
       private:
         using buffer_type = std::vector<char>;
+
+        /** State shared with the read-ahead thread. */
+        struct ReadAhead
+        {
+          std::thread _thread;
+          std::mutex _mutex;
+          std::condition_variable _cv;
+          std::deque<std::pair<buffer_type, std::streamsize>> _filled; //< buffers read and their size (<= 0 on EOF or error)
+          std::vector<buffer_type> _free;                               //< consumed buffers for reuse
+          bool _stop = false;
+          off_type _delivered = 0;                                      //< file offset of the end of the get area
+        };
+
+        void startReadAhead() {
+          _ra.reset( new ReadAhead );
+          _ra->_thread = std::thread( [this, bufsize = _buffer.size()]() { readAheadWorker( bufsize ); } );
+        }
+
+        void stopReadAhead() {
+          if ( !_ra )
+            return;
+          {
+            std::lock_guard<std::mutex> guard( _ra->_mutex );
+            _ra->_stop = true;
+          }
+          _ra->_cv.notify_all();
+          if ( _ra->_thread.joinable() )
+            _ra->_thread.join();
+          _ra.reset();
+        }
+
+        void readAheadWorker( size_t bufsize ) {
+          ReadAhead & ra { *_ra };
+          while ( true ) {
+            buffer_type buf;
+            {
+              std::unique_lock<std::mutex> lock( ra._mutex );
+              ra._cv.wait( lock, [&ra]() { return ra._stop || ra._filled.size() < readAheadChunks; } );
+              if ( ra._stop )
+                return;
+              if ( !ra._free.empty() ) {
+                buf.swap( ra._free.back() );
+                ra._free.pop_back();
+              }
+            }
+            buf.resize( bufsize );
+
+            const std::streamsize got = this->readData( buf.data(), buf.size() );
+            {
+              std::lock_guard<std::mutex> guard( ra._mutex );
+              ra._filled.emplace_back( std::move(buf), got );
+            }
+            ra._cv.notify_all();
+
+            if ( got <= 0 )
+              return; // EOF or error
+          }
+        }
+
+        int_type underflowReadAhead() {
+          std::unique_lock<std::mutex> lock( _ra->_mutex );
+          _ra->_cv.wait( lock, [this]() { return !_ra->_filled.empty(); } );
+
+          auto & [ buf, got ] = _ra->_filled.front();
+          if ( got <= 0 ) {
+            // EOF or error: leave it in the queue, so it is reported again on the next call.
+            setg( &(_buffer[0]), &(_buffer[0]), &(_buffer[0]) );
+            return traits_type::eof();
+          }
+
+          const std::streamsize size = got;
+          _buffer.swap( buf );
+          _ra->_free.push_back( std::move(buf) );
+          _ra->_filled.pop_front();
+          lock.unlock();
+          _ra->_cv.notify_all();
+
+          _ra->_delivered += size;
+          setg( &(_buffer[0]), &(_buffer[0]), &(_buffer.data()[size]) );
+          return traits_type::to_int_type( *gptr() );
+        }
+
         buffer_type              _buffer;
+        bool                     _readAhead = false;
+        std::unique_ptr<ReadAhead> _ra;
     };
   }
 }
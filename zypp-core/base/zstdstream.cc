@@ -0,0 +1,232 @@
+/*---------------------------------------------------------------------\
+|                          ____ _   __ __ ___                          |
+|                         |__  / \ / / . \ . \                         |
+|                           / / \ V /|  _/  _/                         |
+|                          / /__ | | | | | |                           |
+|                         /_____||_| |_| |_|                           |
+|                                                                      |
+\---------------------------------------------------------------------*/
+#include "zstdstream.h"
+#include <zypp-core/base/String.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <string.h>
+
+#include <zstd.h>
+
+namespace zypp {
+
+  namespace detail {
+
+    zstdstreambufimpl::~zstdstreambufimpl()
+    {
+      closeImpl();
+    }
+
+    bool zstdstreambufimpl::openImpl( const char *name_r, std::ios_base::openmode mode_r )
+    {
+      if ( isOpen() )
+        return false;
+
+      if ( mode_r == std::ios_base::in ) {
+        _fd = ::open( name_r, O_RDONLY | O_CLOEXEC );
+        _isReading = true;
+
+      } else if ( mode_r == std::ios_base::out ) {
+        _fd = ::open( name_r, O_WRONLY|O_CREAT|O_TRUNC|O_CLOEXEC, 0666 );
+        _isReading = false;
+      } else {
+        //unsupported mode
+        _lastErr = str::Format("Zstd backend does not support the given open mode.");
+        return false;
+      }
+
+      if ( _fd < 0 ) {
+        const int errSrv = errno;
+        _lastErr = str::Format("Opening file failed: %1%") % ::strerror( errSrv );
+        return false;
+      }
+
+      if ( _isReading ) {
+        _dContext = ::ZSTD_createDCtx();
+        _io.resize( ::ZSTD_DStreamInSize() );
+      } else {
+        _cContext = ::ZSTD_createCCtx();
+        _io.resize( ::ZSTD_CStreamOutSize() );
+      }
+      if ( !_dContext && !_cContext ) {
+        _lastErr = "Unable to create the zstd context.";
+        ::close( _fd );
+        _fd = -1;
+        return false;
+      }
+
+      _ioPos = _ioSize = 0;
+      _eof = false;
+      _frameDone = true;
+      _currfp = 0;
+      return true;
+    }
+
+    bool zstdstreambufimpl::closeImpl()
+    {
+      if ( !isOpen() )
+        return true;
+
+      bool success = true;
+
+      if ( _cContext ) {
+        // flush and finish the frame
+        size_t remaining = 0;
+        do {
+          ZSTD_inBuffer in { nullptr, 0, 0 };
+          ZSTD_outBuffer out { _io.data(), _io.size(), 0 };
+          remaining = ::ZSTD_compressStream2( _cContext, &out, &in, ZSTD_e_end );
+          if ( ::ZSTD_isError( remaining ) ) {
+            _lastErr = ::ZSTD_getErrorName( remaining );
+            success = false;
+            break;
+          }
+          if ( !writeOut( out.pos ) ) {
+            success = false;
+            break;
+          }
+        } while ( remaining != 0 );
+
+        ::ZSTD_freeCCtx( _cContext );
+        _cContext = nullptr;
+      }
+
+      if ( _dContext ) {
+        ::ZSTD_freeDCtx( _dContext );
+        _dContext = nullptr;
+      }
+
+      if ( ::close( _fd ) != 0 && success ) {
+        const int errSrv = errno;
+        _lastErr = str::Format("Closing file failed: %1%") % ::strerror( errSrv );
+        success = false;
+      }
+      _fd = -1;
+      return success;
+    }
+
+    bool zstdstreambufimpl::writeOut( size_t count_r )
+    {
+      const char * data = _io.data();
+      while ( count_r ) {
+        const ssize_t wrote = ::write( _fd, data, count_r );
+        if ( wrote < 0 ) {
+          const int errSrv = errno;
+          if ( errSrv == EINTR )
+            continue;
+          _lastErr = str::Format("Writing file failed: %1%") % ::strerror( errSrv );
+          return false;
+        }
+        data += wrote;
+        count_r -= wrote;
+      }
+      return true;
+    }
+
+    std::streamsize zstdstreambufimpl::readData(char *buffer_r, std::streamsize maxcount_r)
+    {
+      if ( !isOpen() || !canRead() )
+        return -1;
+
+      ZSTD_outBuffer out { buffer_r, size_t(maxcount_r), 0 };
+      while ( out.pos == 0 ) {
+        if ( _ioPos == _ioSize && !_eof ) {
+          const ssize_t got = ::read( _fd, _io.data(), _io.size() );
+          if ( got < 0 ) {
+            const int errSrv = errno;
+            if ( errSrv == EINTR )
+              continue;
+            _lastErr = str::Format("Reading file failed: %1%") % ::strerror( errSrv );
+            return -1;
+          }
+          if ( got == 0 )
+            _eof = true;
+          _ioPos = 0;
+          _ioSize = got;
+        }
+
+        ZSTD_inBuffer in { _io.data(), _ioSize, _ioPos };
+        const size_t ret = ::ZSTD_decompressStream( _dContext, &out, &in );
+        _ioPos = in.pos;
+        if ( ::ZSTD_isError( ret ) ) {
+          _lastErr = ::ZSTD_getErrorName( ret );
+          return -1;
+        }
+        _frameDone = ( ret == 0 );
+
+        if ( _eof && out.pos == 0 && _ioPos == _ioSize ) {
+          if ( !_frameDone ) {
+            _lastErr = "Unexpected end of zstd file.";
+            return -1;
+          }
+          break; // EOF
+        }
+      }
+
+      _currfp += out.pos;
+      return out.pos;
+    }
+
+    bool zstdstreambufimpl::writeData(const char *buffer_r, std::streamsize count_r)
+    {
+      if ( !isOpen() || !canWrite() )
+        return false;
+
+      ZSTD_inBuffer in { buffer_r, size_t(count_r), 0 };
+      while ( in.pos < in.size ) {
+        ZSTD_outBuffer out { _io.data(), _io.size(), 0 };
+        const size_t ret = ::ZSTD_compressStream2( _cContext, &out, &in, ZSTD_e_continue );
+        if ( ::ZSTD_isError( ret ) ) {
+          _lastErr = ::ZSTD_getErrorName( ret );
+          return false;
+        }
+        if ( !writeOut( out.pos ) )
+          return false;
+      }
+
+      _currfp += count_r;
+      return true;
+    }
+
+    bool zstdstreambufimpl::isOpen() const
+    {
+      return ( _fd >= 0 );
+    }
+
+    bool zstdstreambufimpl::canRead() const
+    {
+      return _isReading;
+    }
+
+    bool zstdstreambufimpl::canWrite() const
+    {
+      return !_isReading;
+    }
+
+    bool zstdstreambufimpl::canSeek( std::ios_base::seekdir ) const
+    {
+      return false;
+    }
+
+    off_t zstdstreambufimpl::seekTo(off_t, std::ios_base::seekdir , std::ios_base::openmode)
+    {
+      return -1;
+    }
+
+    off_t zstdstreambufimpl::tell() const
+    {
+      return _currfp;
+    }
+  }
+
+}
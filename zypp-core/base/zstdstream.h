@@ -0,0 +1,86 @@
+/*---------------------------------------------------------------------\
+|                          ____ _   __ __ ___                          |
+|                         |__  / \ / / . \ . \                         |
+|                           / / \ V /|  _/  _/                         |
+|                          / /__ | | | | | |                           |
+|                         /_____||_| |_| |_|                           |
+|                                                                      |
+\---------------------------------------------------------------------*/
+#ifndef ZYPP_CORE_BASE_ZSTDSTREAM_H
+#define ZYPP_CORE_BASE_ZSTDSTREAM_H
+
+#include <iosfwd>
+#include <streambuf>
+#include <string>
+#include <vector>
+#include <zypp-core/base/SimpleStreambuf>
+#include <zypp-core/base/fXstream>
+
+using ZSTD_DCtx = struct ZSTD_DCtx_s;
+using ZSTD_CCtx = struct ZSTD_CCtx_s;
+
+namespace zypp {
+
+  namespace detail {
+
+    /**
+     * @short Streambuffer reading or writing zstd files.
+     *
+     * Read and write mode are mutual exclusive. Seek is not supported.
+     * Files containing multiple concatenated frames are read as a whole.
+     *
+     * This streambuf is used in @ref ifzstdstream and  @ref ofzstdstream.
+     **/
+    class zstdstreambufimpl {
+      public:
+
+        using error_type = std::string;
+
+        ~zstdstreambufimpl();
+
+        bool isOpen   () const;
+        bool canRead  () const;
+        bool canWrite () const;
+        bool canSeek  ( std::ios_base::seekdir way_r ) const;
+
+        std::streamsize readData ( char * buffer_r, std::streamsize maxcount_r  );
+        bool writeData( const char * buffer_r, std::streamsize count_r );
+        off_t seekTo( off_t off_r, std::ios_base::seekdir way_r, std::ios_base::openmode omode_r );
+        off_t tell() const;
+
+        error_type error() const { return _lastErr; }
+
+      protected:
+        bool openImpl( const char * name_r, std::ios_base::openmode mode_r );
+        bool closeImpl ();
+
+      private:
+        bool writeOut( size_t count_r );
+        int _fd = -1;
+        bool _isReading = false;
+        ZSTD_DCtx *_dContext = nullptr;
+        ZSTD_CCtx *_cContext = nullptr;
+        std::vector<char> _io;  //< compressed data read from or written to the file
+        size_t _ioPos = 0;
+        size_t _ioSize = 0;
+        bool _eof = false;
+        bool _frameDone = true;
+        off_t _currfp = 0;
+        error_type _lastErr;
+
+    };
+    using ZstdStreamBuf = detail::SimpleStreamBuf<detail::zstdstreambufimpl>;
+  }
+
+  /**
+   * istream reading zstd files.
+   **/
+  using ifzstdstream = detail::fXstream<std::istream,detail::ZstdStreamBuf>;
+
+  /**
+   * ostream writing zstd files.
+   **/
+  using ofzstdstream = detail::fXstream<std::ostream,detail::ZstdStreamBuf>;
+}
+
+#endif
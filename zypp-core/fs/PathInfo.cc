@@ -1143,6 +1143,8 @@ namespace zypp
           } else if ( magic[0] == '\0' && magic[1] == 'Z' && magic[2] == 'C' && magic[3] == 'K' && magic[4] == '1') {
             ret = ZT_ZCHNK;
 
+          } else if ( magic[0] == 0x28 && magic[1] == 0xB5 && magic[2] == 0x2F && magic[3] == 0xFD ) {
+            ret = ZT_ZSTD;
           }
         }
         close( fd );
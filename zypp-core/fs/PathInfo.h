@@ -757,11 +757,11 @@ namespace zypp
     /** \name Misc. */
     //@{
     /**
-     * Test whether a file is compressed (gzip/bzip2).
+     * Test whether a file is compressed (gzip/bzip2/zchunk/zstd).
      *
-     * @return ZT_GZ, ZT_BZ2 if file is compressed, otherwise ZT_NONE.
+     * @return ZT_GZ, ZT_BZ2, ZT_ZCHNK, ZT_ZSTD if file is compressed, otherwise ZT_NONE.
      **/
-    enum ZIP_TYPE { ZT_NONE, ZT_GZ, ZT_BZ2, ZT_ZCHNK };
+    enum ZIP_TYPE { ZT_NONE, ZT_GZ, ZT_BZ2, ZT_ZCHNK, ZT_ZSTD };
 
     ZIP_TYPE zipType( const Pathname & file );
 
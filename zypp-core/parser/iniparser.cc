@@ -140,6 +140,56 @@ void IniParser::parse( const InputStream & input_r, const ProgressData::Receiver
   MIL << "Done parsing " << input_r << endl;
 }
 
+///////////////////////////////////////////////////////////////////
+/// \class IniParser::Recorder
+/// \brief IniParser remembering the callbacks.
+///////////////////////////////////////////////////////////////////
+class IniParser::Recorder : public IniParser
+{
+public:
+  void consume( const std::string & section_r ) override
+  { _recording.push_back( Event{ Event::Section, 0, section_r, std::string(), std::string() } ); }
+
+  void consume( const std::string & section_r, const std::string & key_r, const std::string & value_r ) override
+  { _recording.push_back( Event{ Event::Entry, 0, section_r, key_r, value_r } ); }
+
+  void garbageLine( const std::string & section_r, const std::string & line_r ) override
+  { _recording.push_back( Event{ Event::Garbage, _line_nr, section_r, line_r, std::string() } ); }
+
+  Recording _recording;
+};
+
+IniParser::Recording IniParser::record( const InputStream & input_r )
+{
+  Recorder recorder;
+  recorder.parse( input_r );
+  return std::move(recorder._recording);
+}
+
+void IniParser::replay( const Recording & recording_r, const std::string & inputname_r )
+{
+  _inputname = inputname_r;
+  beginParse();
+  for ( const Event & event : recording_r )
+  {
+    switch ( event.type )
+    {
+      case Event::Section:
+        consume( event.section );
+        break;
+      case Event::Entry:
+        consume( event.section, event.key, event.value );
+        break;
+      case Event::Garbage:
+        _line_nr = event.lineNo;
+        garbageLine( event.section, event.key );
+        break;
+    }
+  }
+  endParse();
+  _inputname.clear();
+}
+
 /////////////////////////////////////////////////////////////////
 } // namespace parser
 ///////////////////////////////////////////////////////////////////
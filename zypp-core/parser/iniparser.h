@@ -15,6 +15,7 @@
 #include <iosfwd>
 #include <string>
 #include <list>
+#include <vector>
 
 #include <zypp-core/base/PtrTypes.h>
 #include <zypp-core/base/NonCopyable.h>
@@ -40,6 +41,20 @@ namespace parser
 ///
 class IniParser : private base::NonCopyable
 {
+public:
+  /** A callback remembered by \ref record. */
+  struct Event
+  {
+    enum Type : char { Section, Entry, Garbage };
+    Type type;
+    int lineNo;			///< line number (\c Garbage)
+    std::string section;
+    std::string key;		///< key (\c Entry) or line (\c Garbage)
+    std::string value;		///< value (\c Entry)
+  };
+  /** The callbacks a \ref parse invoked, in order. */
+  using Recording = std::vector<Event>;
+
 public:
   /** Default ctor */
   IniParser();
@@ -52,6 +67,18 @@ public:
   */
   void parse( const InputStream & imput_r, const ProgressData::ReceiverFnc & progress = ProgressData::ReceiverFnc() );
 
+  /** Parse the stream, but just remember the callbacks.
+   * Garbage lines are remembered, not reported. Passing the result to
+   * \ref replay invokes the callbacks exactly as \ref parse would do.
+   */
+  static Recording record( const InputStream & input_r );
+
+  /** Invoke the callbacks remembered by \ref record.
+   * \a inputname_r is used in messages as if \ref parse read the stream.
+   * \throw ParseException like \ref parse.
+   */
+  void replay( const Recording & recording_r, const std::string & inputname_r );
+
 public:
   /** Called when start parsing. */
   virtual void beginParse();
@@ -80,6 +107,9 @@ public:
     return _inputname;
   }
 
+private:
+  class Recorder;
+
 private:
   std::string _inputname;
   std::string _current_section;
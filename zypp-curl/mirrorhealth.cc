@@ -0,0 +1,229 @@
+/*---------------------------------------------------------------------\
+|                          ____ _   __ __ ___                          |
+|                         |__  / \ / / . \ . \                         |
+|                           / / \ V /|  _/  _/                         |
+|                          / /__ | | | | | |                           |
+|                         /_____||_| |_| |_|                           |
+|                                                                      |
+\---------------------------------------------------------------------*/
+/** \file zypp-curl/mirrorhealth.cc
+ *
+*/
+#include "private/mirrorhealth_p.h"
+
+#include <zypp-core/fs/PathInfo.h>
+#include <zypp-core/base/LogTools.h>
+#include <zypp-media/MediaConfig>
+
+#include <algorithm>
+#include <fstream>
+#include <locale>
+#include <sstream>
+
+using std::endl;
+
+namespace zypp::media {
+
+  namespace {
+    constexpr double   smoothing        = 0.3;              //< weight of a new sample in the moving averages
+    constexpr unsigned maxSamples       = 50;               //< counters are halved above, so a mirror can recover
+    constexpr time_t   maxAge           = 30 * 24 * 60 * 60; //< entries not updated for 30 days are dropped
+    constexpr double   unknownRtt       = 250.0;            //< ms assumed if the connect time is not known
+    constexpr double   unknownXfer      = 1024.0 * 1024.0;  //< bytes per second assumed if the throughput is not known
+    constexpr double   minSuccessRate   = 0.1;
+
+    constexpr const char * fileHeader   = "# zypp mirror health v1";
+
+    inline double smooth( double old_r, double sample_r )
+    { return old_r > 0.0 ? ( 1.0 - smoothing ) * old_r + smoothing * sample_r : sample_r; }
+  }
+
+  double MirrorHealth::Stats::successRate() const
+  {
+    const unsigned total = successes + failures;
+    return total ? double(successes) / total : 1.0;
+  }
+
+  double MirrorHealth::Stats::score() const
+  {
+    const double ms = ( rtt > 0.0 ? rtt : unknownRtt )
+                    + 1000.0 * ( 1024.0 * 1024.0 ) / ( throughput > 0.0 ? throughput : unknownXfer );
+    return ms / std::max( successRate(), minSuccessRate );
+  }
+
+  MirrorHealth & MirrorHealth::instance()
+  {
+    static MirrorHealth _instance( MediaConfig::instance().download_mirror_health_file() );
+    return _instance;
+  }
+
+  MirrorHealth::MirrorHealth( Pathname file_r )
+  : _file( std::move(file_r) )
+  , _lastSave( std::chrono::steady_clock::now() )
+  { load(); }
+
+  MirrorHealth::~MirrorHealth()
+  {
+    try { save(); } catch(...) {}	// no throw in dtor
+  }
+
+  std::string MirrorHealth::makeKey( const Url & url_r )
+  {
+    return url_r.asString( Url::ViewOptions::WITH_SCHEME +
+                           Url::ViewOptions::WITH_HOST +
+                           Url::ViewOptions::WITH_PORT +
+                           Url::ViewOptions::EMPTY_AUTHORITY );
+  }
+
+  std::optional<MirrorHealth::Stats> MirrorHealth::stats( const Url & url_r ) const
+  {
+    std::lock_guard<std::mutex> guard( _lock );
+    const auto it = _stats.find( makeKey( url_r ) );
+    if ( it == _stats.end() )
+      return {};
+    return it->second;
+  }
+
+  double MirrorHealth::score( const Url & url_r ) const
+  {
+    const auto s = stats( url_r );
+    return ( s ? *s : Stats() ).score();
+  }
+
+  MirrorHealth::Stats & MirrorHealth::touch( const Url & url_r )
+  {
+    Stats & s { _stats[makeKey( url_r )] };
+    s.lastUpdate = ::time( nullptr );
+    _dirty = true;
+    return s;
+  }
+
+  void MirrorHealth::recordConnectTime( const Url & url_r, std::chrono::milliseconds connTime_r )
+  {
+    std::lock_guard<std::mutex> guard( _lock );
+    Stats & s { touch( url_r ) };
+    // a 0ms connect time would mean unknown, e.g. for a reused connection
+    s.rtt = smooth( s.rtt, std::max<double>( connTime_r.count(), 1.0 ) );
+  }
+
+  void MirrorHealth::recordTransfer( const Url & url_r, bool success_r, double bytesPerSecond_r )
+  {
+    std::lock_guard<std::mutex> guard( _lock );
+    Stats & s { touch( url_r ) };
+    if ( success_r ) {
+      ++s.successes;
+      if ( bytesPerSecond_r > 0.0 )
+        s.throughput = smooth( s.throughput, bytesPerSecond_r );
+    } else {
+      ++s.failures;
+    }
+
+    if ( s.successes + s.failures > maxSamples ) {
+      s.successes /= 2;
+      s.failures /= 2;
+    }
+  }
+
+  void MirrorHealth::sortByHealth( std::vector<Url> & urls_r ) const
+  {
+    if ( urls_r.size() < 2 )
+      return;
+
+    std::vector<std::pair<double, Url>> scored;
+    scored.reserve( urls_r.size() );
+    for ( auto & url : urls_r )
+      scored.push_back( std::make_pair( score( url ), std::move(url) ) );
+
+    std::stable_sort( scored.begin(), scored.end(), []( const auto & lhs, const auto & rhs ) {
+      return lhs.first < rhs.first;
+    });
+
+    for ( size_t i = 0; i < scored.size(); ++i )
+      urls_r[i] = std::move( scored[i].second );
+  }
+
+  void MirrorHealth::load()
+  {
+    if ( _file.empty() || ! PathInfo( _file ).isFile() )
+      return;
+
+    std::ifstream in( _file.c_str() );
+    if ( ! in ) {
+      WAR << "Unable to read mirror health file " << _file << endl;
+      return;
+    }
+
+    const time_t now = ::time( nullptr );
+    std::string line;
+    while ( std::getline( in, line ) ) {
+      if ( line.empty() || line[0] == '#' )
+        continue;
+
+      std::istringstream str( line );
+      str.imbue( std::locale::classic() );
+      std::string key;
+      Stats s;
+      if ( ! ( str >> key >> s.successes >> s.failures >> s.rtt >> s.throughput >> s.lastUpdate ) ) {
+        WAR << "Ignore malformed line in " << _file << ": " << line << endl;
+        continue;
+      }
+      if ( now - s.lastUpdate > maxAge )
+        continue;
+      _stats[key] = s;
+    }
+    DBG << "Loaded health data of " << _stats.size() << " mirrors from " << _file << endl;
+  }
+
+  void MirrorHealth::saveIfDue( std::chrono::seconds interval_r )
+  {
+    {
+      std::lock_guard<std::mutex> guard( _lock );
+      if ( std::chrono::steady_clock::now() - _lastSave < interval_r )
+        return;
+    }
+    save();
+  }
+
+  void MirrorHealth::save()
+  {
+    std::lock_guard<std::mutex> guard( _lock );
+    _lastSave = std::chrono::steady_clock::now();
+    if ( ! _dirty || _file.empty() )
+      return;
+
+    if ( filesystem::assert_dir( _file.dirname() ) != 0 ) {
+      DBG << "Unable to create directory for " << _file << endl;
+      return;
+    }
+
+    const Pathname tmpfile { _file.extend( ".new" ) };
+    {
+      std::ofstream out( tmpfile.c_str(), std::ios_base::out | std::ios_base::trunc );
+      if ( ! out ) {
+        // e.g. no permission as non root user, that's fine.
+        DBG << "Unable to write mirror health file " << _file << endl;
+        return;
+      }
+
+      out.imbue( std::locale::classic() );
+      out << fileHeader << endl;
+      for ( const auto & [ key, s ] : _stats ) {
+        out << key << ' ' << s.successes << ' ' << s.failures << ' '
+            << s.rtt << ' ' << s.throughput << ' ' << s.lastUpdate << '\n';
+      }
+      if ( ! out.flush() ) {
+        WAR << "Unable to write mirror health file " << _file << endl;
+        filesystem::unlink( tmpfile );
+        return;
+      }
+    }
+
+    if ( filesystem::rename( tmpfile, _file ) != 0 ) {
+      WAR << "Unable to replace mirror health file " << _file << endl;
+      filesystem::unlink( tmpfile );
+      return;
+    }
+    _dirty = false;
+  }
+
+} // namespace zypp::media
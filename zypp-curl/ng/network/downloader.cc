@@ -141,6 +141,9 @@ namespace zyppng {
     _emittedSigStart   = false;
     _stoppedOnMetalink = false;
     _lastTriedAuthTime = 0;
+    _notModified       = false;
+    _responseETag.clear();
+    _responseLastModified.clear();
 
     // restart the statemachine
     if ( cState == Download::Finished )
@@ -197,6 +200,21 @@ namespace zyppng {
     return res;
   }
 
+  void DownloadPrivateBase::addConditionalHeaders( TransferSettings &set ) const
+  {
+    if ( _spec.ifNoneMatch().size() )
+      set.addHeader( "If-None-Match: " + _spec.ifNoneMatch() );
+    if ( _spec.ifModifiedSince().size() )
+      set.addHeader( "If-Modified-Since: " + _spec.ifModifiedSince() );
+  }
+
+  void DownloadPrivateBase::takeResponseValidators( const NetworkRequest &req )
+  {
+    _notModified          = req.notModified();
+    _responseETag         = req.responseETag();
+    _responseLastModified = req.responseLastModified();
+  }
+
   Download::Download(zyppng::Downloader &parent, std::shared_ptr<zyppng::NetworkRequestDispatcher> requestDispatcher, std::shared_ptr<zyppng::MirrorControl> mirrors, zyppng::DownloadSpec &&spec)
     : Base( *new DownloadPrivate( parent, std::move(requestDispatcher), std::move(mirrors), std::move(spec), *this )  )
   { }
@@ -283,6 +301,21 @@ namespace zyppng {
     return d_func()->_stoppedOnMetalink;
   }
 
+  bool Download::notModified() const
+  {
+    return d_func()->_notModified;
+  }
+
+  const std::string &Download::responseETag() const
+  {
+    return d_func()->_responseETag;
+  }
+
+  const std::string &Download::responseLastModified() const
+  {
+    return d_func()->_responseLastModified;
+  }
+
   DownloadSpec &Download::spec()
   {
     return d_func()->_spec;
@@ -207,6 +207,20 @@ namespace zyppng {
      */
     bool stoppedOnMetalink () const;
 
+    /*!
+     * Returns true if the download was conditional ( \ref DownloadSpec::setIfNoneMatch, \ref DownloadSpec::setIfModifiedSince )
+     * and the server answered with \c 304 \c Not \c Modified. The target file is not created in that case,
+     * the caller is supposed to keep using its local copy.
+     */
+    bool notModified () const;
+
+    /*!
+     * The \c ETag and \c Last-Modified headers sent by the server along with the file. They can be passed to
+     * \ref DownloadSpec when the same file is downloaded the next time. Empty if the server did not send them.
+     */
+    const std::string &responseETag () const;
+    const std::string &responseLastModified () const;
+
     /*!
      * Returns a reference to the internally used download spec.
      * \sa zyppng::DownloadSpec
@@ -33,6 +33,8 @@ namespace zyppng {
     zypp::ByteCount _headerSize;     //< Optional file header size for things like zchunk
     std::optional<zypp::CheckSum> _headerChecksum; //< Optional file header checksum
     zypp::ByteCount _preferred_chunk_size = 0;
+    std::string _ifNoneMatch;        //< Optional ETag for a conditional request
+    std::string _ifModifiedSince;    //< Optional Last-Modified date for a conditional request
   };
 
   ZYPP_IMPL_PRIVATE( DownloadSpec )
@@ -166,4 +168,31 @@ namespace zyppng {
     }
     return *this;
   }
+
+  DownloadSpec &DownloadSpec::setIfNoneMatch( const std::string &etag )
+  {
+    d_ptr->_ifNoneMatch = etag;
+    return *this;
+  }
+
+  const std::string &DownloadSpec::ifNoneMatch() const
+  {
+    return d_ptr->_ifNoneMatch;
+  }
+
+  DownloadSpec &DownloadSpec::setIfModifiedSince( const std::string &date )
+  {
+    d_ptr->_ifModifiedSince = date;
+    return *this;
+  }
+
+  const std::string &DownloadSpec::ifModifiedSince() const
+  {
+    return d_ptr->_ifModifiedSince;
+  }
+
+  bool DownloadSpec::isConditional() const
+  {
+    return !( d_ptr->_ifNoneMatch.empty() && d_ptr->_ifModifiedSince.empty() );
+  }
 }
@@ -107,6 +107,25 @@ namespace zyppng {
     const std::optional<zypp::CheckSum> &headerChecksum () const;
     DownloadSpec &setHeaderChecksum ( const zypp::CheckSum &sum );
 
+    /*!
+     * Makes the download conditional. If the server answers with \c 304 \c Not \c Modified no
+     * data is downloaded and \ref Download::notModified returns true. The values are the \c ETag and
+     * \c Last-Modified headers remembered from a previous download of the same file, they are sent as
+     * \c If-None-Match and \c If-Modified-Since headers. Empty values are not sent.
+     *
+     * \note This applies to the metalink detection request as well as to the plain download.
+     */
+    DownloadSpec &setIfNoneMatch ( const std::string &etag );
+    const std::string &ifNoneMatch () const;
+
+    DownloadSpec &setIfModifiedSince ( const std::string &date );
+    const std::string &ifModifiedSince () const;
+
+    /*!
+     * Returns true if \ref setIfNoneMatch or \ref setIfModifiedSince was set.
+     */
+    bool isConditional () const;
+
   private:
     zypp::RWCOW_pointer<DownloadSpecPrivate> d_ptr;
   };
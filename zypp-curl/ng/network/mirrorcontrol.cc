@@ -8,6 +8,7 @@
 ----------------------------------------------------------------------*/
 #include "private/mirrorcontrol_p.h"
 #include "private/mediadebug_p.h"
+#include <zypp-curl/private/mirrorhealth_p.h>
 #include <zypp-core/zyppng/base/EventDispatcher>
 #include <zypp-core/zyppng/base/Signals>
 #include <zypp-core/base/String.h>
@@ -18,6 +19,7 @@ namespace zyppng {
   constexpr uint penaltyIncrease = 100;
   constexpr uint defaultSampleTime = 2;
   constexpr uint defaultMaxConnections = 5;
+  constexpr time_t maxRatingAge = 24 * 60 * 60; //< stored transfer results older than this are ignored
 
   MirrorControl::Mirror::Mirror( MirrorControl &parent ) : _parent( parent )
   {}
@@ -37,6 +39,7 @@ namespace zyppng {
       penalty += penaltyIncrease;
       failedTransfers++;
     }
+    zypp::media::MirrorHealth::instance().recordTransfer( mirrorUrl, success );
     transferUnref();
   }
 
@@ -111,6 +114,8 @@ namespace zyppng {
     // do not send signals to us while we are destructing
     _queueEmptyConn.disconnect();
 
+    zypp::media::MirrorHealth::instance().saveIfDue();
+
     if ( _dispatcher->count() > 0 ) {
       MIL << "Destroying MirrorControl while measurements are still running, aborting" << std::endl;
       for ( auto &mirr : _handles )  {
@@ -146,6 +151,13 @@ namespace zyppng {
         mirrorHandle->mirrorUrl       = mirror.url;
         mirrorHandle->mirrorUrl.setPathName("/");
 
+        // recently failed transfers make the rating worse, the probe below still checks the mirror is up
+        const auto health = zypp::media::MirrorHealth::instance().stats( mirrorHandle->mirrorUrl );
+        if ( health && ::time( nullptr ) - health->lastUpdate < maxRatingAge ) {
+          mirrorHandle->rating += static_cast<uint>( ( 1.0 - health->successRate() ) * penaltyIncrease * 10 );
+          DBG_MEDIA << "Stored rating for mirror: " << mirrorHandle->mirrorUrl << ", rating is " << mirrorHandle->rating << std::endl;
+        }
+
         mirrorHandle->_request = std::make_shared<NetworkRequest>( mirrorHandle->mirrorUrl, "/dev/null", NetworkRequest::WriteShared );
         mirrorHandle->_request->setOptions( NetworkRequest::ConnectionTest );
         mirrorHandle->_request->transferSettings().setTimeout( defaultSampleTime );
@@ -159,9 +171,11 @@ namespace zyppng {
           std::chrono::milliseconds connTime;
           if ( timings ) {
             connTime = std::chrono::duration_cast<std::chrono::milliseconds>(timings->connect - timings->namelookup);
+            zypp::media::MirrorHealth::instance().recordConnectTime( mirrorHandle->mirrorUrl, connTime );
           } else {
             // we can not get any measurements, maximum penalty
             connTime = std::chrono::seconds( defaultSampleTime );
+            zypp::media::MirrorHealth::instance().recordTransfer( mirrorHandle->mirrorUrl, false );
           }
 
           DBG_MEDIA << "Got rating for mirror: " <<  mirrorHandle->mirrorUrl << ", rating was " << mirrorHandle->rating;
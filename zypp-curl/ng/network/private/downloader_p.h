@@ -53,6 +53,8 @@ namespace zyppng {
 #endif
     Transition< InitialState, &InitialState::sigTransitionToDlNormalFileState,   DlNormalFileState >,
 
+    Transition< DetectMetalinkState, &DetectMetalinkState::sigFinished,   FinishedState, &DetectMetalinkState::toFinishedGuard, &DetectMetalinkState::toFinishedState >,
+
     Transition< DetectMetalinkState, &DetectMetalinkState::sigFinished,   DlMetaLinkInfoState, &DetectMetalinkState::toMetalinkGuard, &DetectMetalinkState::toDlMetaLinkInfoState >,
 #if ENABLE_ZCHUNK_COMPRESSION
     Transition< DetectMetalinkState, &DetectMetalinkState::sigFinished,   DLZckHeadState,      &DetectMetalinkState::toZckHeadDownloadGuard, &DetectMetalinkState::toDLZckHeadState  >,
@@ -86,6 +86,17 @@ namespace zyppng {
 
     NetworkRequestError safeFillSettingsFromURL ( const Url &url, TransferSettings &set );
 
+    /*!
+     * Adds the \c If-None-Match and \c If-Modified-Since headers to \a set if
+     * the \ref DownloadSpec asks for a conditional download.
+     */
+    void addConditionalHeaders ( TransferSettings &set ) const;
+
+    /*!
+     * Remembers the validators and the \c 304 state of a finished request.
+     */
+    void takeResponseValidators ( const NetworkRequest &req );
+
 #if ENABLE_ZCHUNK_COMPRESSION
     bool hasZckInfo () const;
 #endif
@@ -103,6 +114,9 @@ namespace zyppng {
     time_t _lastTriedAuthTime = 0; //< if initialized this shows the last timestamp that got from user code for a auth request
     bool _stopOnMetalink     = false; //< Stop the download if a metalink was received for external parsing
     bool _stoppedOnMetalink  = false; //< Statemachine was stopped after receiving a metalink file
+    bool _notModified        = false; //< Server answered the conditional request with 304 Not Modified
+    std::string _responseETag;         //< ETag header of the response that finished the download
+    std::string _responseLastModified; //< Last-Modified header of the response that finished the download
     NetworkRequest::Priority _defaultSubRequestPriority = NetworkRequest::High;
 
     Signal< void ( Download &req )> _sigStarted;
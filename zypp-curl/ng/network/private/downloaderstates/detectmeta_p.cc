@@ -13,6 +13,7 @@
 
 #include "detectmeta_p.h"
 #include "metalinkinfo_p.h"
+#include "final_p.h"
 
 namespace zyppng {
 
@@ -36,6 +37,7 @@ namespace zyppng {
     _request->transferSettings() = sm._spec.settings();
     _request->transferSettings().addHeader("Accept: */*, application/metalink+xml, application/metalink4+xml");
     _request->setOptions( _request->options() | NetworkRequest::HeadRequest );
+    sm.addConditionalHeaders( _request->transferSettings() );
 
     _request->connectSignals( *this );
     sm._requestDispatcher->enqueue( _request );
@@ -72,6 +74,16 @@ namespace zyppng {
       return _sigFinished.emit();
     }
 
+    // remember the validators of the original URL, in case a metalink is used the
+    // data itself comes from mirrors which do not know about them
+    stateMachine().takeResponseValidators( req );
+    if ( req.notModified() ) {
+      // conditional request and the file did not change, no need to check for a metalink
+      MIL << req.nativeHandle() << " " << "File on " << req.url() << " was not modified." << std::endl;
+      _gotMetalink = false;
+      return _sigFinished.emit();
+    }
+
     std::string cType = req.contentType();
     _gotMetalink = ( cType.find("application/metalink+xml") == 0 || cType.find("application/metalink4+xml") == 0 );
     MIL << req.nativeHandle() << " " << "Metalink detection result on url " << req.url() << " is " << _gotMetalink << std::endl;
@@ -86,19 +98,29 @@ namespace zyppng {
     return nState;
   }
 
+  bool DetectMetalinkState::toFinishedGuard() const
+  {
+    return stateMachine()._notModified;
+  }
+
+  std::shared_ptr<FinishedState> DetectMetalinkState::toFinishedState()
+  {
+    return std::make_shared<FinishedState>( NetworkRequestError(), stateMachine() );
+  }
+
   bool DetectMetalinkState::toSimpleDownloadGuard() const
   {
 #if ENABLE_ZCHUNK_COMPRESSION
-    return !toMetalinkGuard() && !toZckHeadDownloadGuard();
+    return !toFinishedGuard() && !toMetalinkGuard() && !toZckHeadDownloadGuard();
 #else
-    return !toMetalinkGuard();
+    return !toFinishedGuard() && !toMetalinkGuard();
 #endif
   }
 
 #if ENABLE_ZCHUNK_COMPRESSION
   bool DetectMetalinkState::toZckHeadDownloadGuard() const
   {
-    return !toMetalinkGuard() && stateMachine().hasZckInfo();
+    return !toFinishedGuard() && !toMetalinkGuard() && stateMachine().hasZckInfo();
   }
 
   std::shared_ptr<DLZckHeadState> DetectMetalinkState::toDLZckHeadState()
@@ -20,6 +20,7 @@
 namespace zyppng {
 
   struct DlMetaLinkInfoState;
+  struct FinishedState;
 #if ENABLE_ZCHUNK_COMPRESSION
   struct DLZckHeadState;
 #endif
@@ -63,6 +64,13 @@ namespace zyppng {
 
     bool toSimpleDownloadGuard () const;
 
+    /*!
+     * The server answered the conditional request with \c 304 \c Not \c Modified,
+     * we can skip the download completely.
+     */
+    bool toFinishedGuard () const;
+    std::shared_ptr<FinishedState> toFinishedState();
+
 #if ENABLE_ZCHUNK_COMPRESSION
     bool toZckHeadDownloadGuard () const;
     std::shared_ptr<DLZckHeadState> toDLZckHeadState();
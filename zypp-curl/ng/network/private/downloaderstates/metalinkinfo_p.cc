@@ -50,11 +50,24 @@ namespace zyppng {
   {
     MIL << "Requesting Metadata info from server!" << std::endl;
     r->transferSettings().addHeader("Accept: */*, application/x-zsync, application/metalink+xml, application/metalink4+xml");
+    if ( !r->_myMirror )
+      stateMachine().addConditionalHeaders( r->transferSettings() );
     return BasicDownloaderStateBase::initializeRequest(r);
   }
 
   void DlMetaLinkInfoState::gotFinished()
   {
+    // remember the validators of the original URL, in case a metalink is used the
+    // data itself comes from mirrors which do not know about them
+    auto &sm = stateMachine();
+    if ( !_request->_myMirror ) {
+      sm.takeResponseValidators( *_request );
+      if ( sm._notModified ) {
+        MIL << "Downloading on " << sm._spec.url() << " was not needed, file was not modified. " << std::endl;
+        return BasicDownloaderStateBase::gotFinished();
+      }
+    }
+
     // some proxies do not store the content type, so also look at the file to find
     // out if we received a metalink (bnc#649925)
     if ( _detectedMetaType == MetaDataType::None )
@@ -65,7 +78,6 @@ namespace zyppng {
       return BasicDownloaderStateBase::gotFinished();
     }
 
-    auto &sm = stateMachine();
     if ( sm._stopOnMetalink ) {
       MIL << "Stopping after receiving MetaData as requested" << std::endl;
       sm._stoppedOnMetalink = true;
@@ -26,6 +26,26 @@ namespace zyppng {
     MIL << "About to enter DlNormalFileState for url " << parent._spec.url() << std::endl;
   }
 
+  bool DlNormalFileState::initializeRequest( std::shared_ptr<Request> &r )
+  {
+    // conditional requests only make sense against the URL the validators were taken from,
+    // a mirror might carry a different ETag or an older timestamp
+    if ( !r->_myMirror )
+      stateMachine().addConditionalHeaders( r->transferSettings() );
+    return BasicDownloaderStateBase::initializeRequest( r );
+  }
+
+  void DlNormalFileState::gotFinished()
+  {
+    auto &sm = stateMachine();
+    if ( _request && !_request->_myMirror ) {
+      sm.takeResponseValidators( *_request );
+      if ( sm._notModified )
+        MIL << _request->nativeHandle() << " " << "File on " << sm._spec.url() << " was not modified." << std::endl;
+    }
+    BasicDownloaderStateBase::gotFinished();
+  }
+
   std::shared_ptr<FinishedState> DlNormalFileState::transitionToFinished()
   {
     return std::make_shared<FinishedState>( std::move(_error), stateMachine() );
@@ -34,6 +34,9 @@ namespace zyppng {
 
     std::shared_ptr<FinishedState> transitionToFinished ();
 
+    bool initializeRequest( std::shared_ptr<Request> &r ) override;
+    void gotFinished () override;
+
     SignalProxy< void () > sigFinished() {
       return _sigFinished;
     }
@@ -120,6 +120,9 @@ namespace zyppng {
     NetworkRequest::Priority            _priority = NetworkRequest::Normal;
 
     std::string _lastRedirect;	///< to log/report redirections
+    std::string _responseETag;	///< ETag header of the last response
+    std::string _responseLastModified;	///< Last-Modified header of the last response
+    bool _notModified = false;	///< server answered a conditional request with 304 Not Modified
     const std::string _currentCookieFile = "/var/lib/YaST2/cookies";
 
     void *_easyHandle = nullptr; // the easy handle that controlling this request
@@ -495,7 +495,7 @@ namespace zyppng {
       resState._downloaded = rmode._downloaded;
       resState._contentLenght = rmode._contentLenght;
 
-      if ( resState._result.type() == NetworkRequestError::NoError && !(_options & NetworkRequest::HeadRequest) && !(_options & NetworkRequest::ConnectionTest) ) {
+      if ( resState._result.type() == NetworkRequestError::NoError && !_notModified && !(_options & NetworkRequest::HeadRequest) && !(_options & NetworkRequest::ConnectionTest) ) {
         if ( _requestedRanges.size( ) ) {
           //we have a successful download lets see if we got everything we needed
           if ( !rmode._partialHelper->verifyData() ){
@@ -519,7 +519,8 @@ namespace zyppng {
       }
 
       // finally check the file digest if we have one
-      if ( _fileVerification && resState._result.type() == NetworkRequestError::NoError ) {
+      // ( a 304 answer has no body, the caller keeps using its local copy )
+      if ( _fileVerification && !_notModified && resState._result.type() == NetworkRequestError::NoError ) {
         const UByteArray &calcSum = _fileVerification->_fileDigest.digestVector ();
         const UByteArray &expSum  = zypp::Digest::hexStringToUByteArray( _fileVerification->_fileChecksum.checksum () );
         if ( calcSum != expSum  ) {
@@ -544,6 +545,9 @@ namespace zyppng {
     _headers.reset( nullptr );
     _errorBuf.fill( 0 );
     _runningMode = pending_t();
+    _responseETag.clear();
+    _responseLastModified.clear();
+    _notModified = false;
 
     if ( _fileVerification )
       _fileVerification->_fileDigest.reset ();
@@ -637,10 +641,27 @@ namespace zyppng {
         long statuscode = 0;
         (void)curl_easy_getinfo( _easyHandle, CURLINFO_RESPONSE_CODE, &statuscode);
 
+        // validators belong to the final response, forget the ones seen on a redirect
+        _responseETag.clear();
+        _responseLastModified.clear();
+        _notModified = ( statuscode == 304 );
+
         // if we have a status 204 we need to create a empty file
         if( statuscode == 204 && !( _options & NetworkRequest::ConnectionTest ) && !( _options & NetworkRequest::HeadRequest ) )
           assertOutputFile();
 
+        // a 304 answer to a conditional request has no body, the target file is not touched
+        if ( _notModified )
+          DBG << _easyHandle << " " << "Server reports 304 Not Modified" << std::endl;
+
+      } else if ( zypp::strv::hasPrefixCI( hdr, "ETag:" ) ) {
+        auto val = str::trim( hdr.substr( 5 ), zypp::str::TRIM );
+        _responseETag = std::string( val.data(), val.length() );
+
+      } else if ( zypp::strv::hasPrefixCI( hdr, "Last-Modified:" ) ) {
+        auto val = str::trim( hdr.substr( 14 ), zypp::str::TRIM );
+        _responseLastModified = std::string( val.data(), val.length() );
+
       } else if ( zypp::strv::hasPrefixCI( hdr, "Location:" ) ) {
         _lastRedirect = hdr.substr( 9 );
         DBG << _easyHandle << " " << "redirecting to " << _lastRedirect << std::endl;
@@ -853,6 +874,21 @@ namespace zyppng {
     return d_func()->_lastRedirect;
   }
 
+  bool NetworkRequest::notModified() const
+  {
+    return d_func()->_notModified;
+  }
+
+  const std::string &NetworkRequest::responseETag() const
+  {
+    return d_func()->_responseETag;
+  }
+
+  const std::string &NetworkRequest::responseLastModified() const
+  {
+    return d_func()->_responseLastModified;
+  }
+
   void *NetworkRequest::nativeHandle() const
   {
     return d_func()->_easyHandle;
@@ -151,6 +151,23 @@ namespace zyppng {
      */
     const std::string &lastRedirectInfo() const;
 
+    /*!
+     * Returns true if the server answered a conditional request
+     * ( \c If-None-Match or \c If-Modified-Since header added via \ref transferSettings )
+     * with \c 304 \c Not \c Modified. No data is written to the target file in that case.
+     */
+    bool notModified() const;
+
+    /*!
+     * Returns the value of the \c ETag header of the last response, or an empty string.
+     */
+    const std::string &responseETag() const;
+
+    /*!
+     * Returns the value of the \c Last-Modified header of the last response, or an empty string.
+     */
+    const std::string &responseLastModified() const;
+
     /*!
      * Returns a pointer to the native CURL easy handle
      *
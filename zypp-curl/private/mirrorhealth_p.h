@@ -0,0 +1,116 @@
+/*---------------------------------------------------------------------\
+|                          ____ _   __ __ ___                          |
+|                         |__  / \ / / . \ . \                         |
+|                           / / \ V /|  _/  _/                         |
+|                          / /__ | | | | | |                           |
+|                         /_____||_| |_| |_|                           |
+|                                                                      |
+----------------------------------------------------------------------/
+*
+* This file contains private API, this might break at any time between releases.
+* You have been warned!
+*
+*/
+#ifndef ZYPP_CURL_PRIVATE_MIRRORHEALTH_P_H
+#define ZYPP_CURL_PRIVATE_MIRRORHEALTH_P_H
+
+#include <zypp-core/Globals.h>
+#include <zypp-core/Pathname.h>
+#include <zypp-core/Url.h>
+
+#include <chrono>
+#include <ctime>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace zypp::media {
+
+  /*!
+   * Persistent store remembering how mirrors performed in past runs.
+   *
+   * Per mirror host (scheme, host and port of the URL) the number of
+   * successful and failed transfers, the smoothed connect time and the
+   * smoothed throughput are kept. \ref MirrorControl and \ref MediaMultiCurl
+   * use it to rank the mirrors they got from a metalink file, \ref RepoMirrorList
+   * to rank the mirrors of a repo. So a slow or broken mirror is no longer
+   * re-learned by every process.
+   *
+   * The data are loaded from \ref MediaConfig::download_mirror_health_file
+   * on first use and written back when the store is destroyed. Downloads
+   * call \ref saveIfDue, so long running processes write them at most
+   * every 10 minutes. Entries not updated for 30 days are dropped when
+   * loading. Concurrent processes do not merge their data, the last one
+   * saving wins.
+   */
+  class ZYPP_TESTS MirrorHealth
+  {
+  public:
+    struct Stats
+    {
+      unsigned successes = 0;   ///< successful transfers
+      unsigned failures = 0;    ///< failed transfers
+      double rtt = 0.0;         ///< smoothed connect time in ms, \c 0 if unknown
+      double throughput = 0.0;  ///< smoothed throughput in bytes per second, \c 0 if unknown
+      time_t lastUpdate = 0;
+
+      /** Ratio of successful transfers, \c 1.0 if there were none yet. */
+      double successRate() const;
+
+      /** Estimated time in ms to fetch 1MiB, lower is better. Unknown values are guessed, failures punished. */
+      double score() const;
+    };
+
+    /** The store backed by \ref MediaConfig::download_mirror_health_file. */
+    static MirrorHealth & instance();
+
+    /** A store backed by \a file_r, an empty path keeps the data in memory only. */
+    explicit MirrorHealth( Pathname file_r );
+
+    /** Dtor writing changed data back. */
+    ~MirrorHealth();
+
+    MirrorHealth( const MirrorHealth & ) = delete;
+    MirrorHealth & operator=( const MirrorHealth & ) = delete;
+
+    /** The stats of the mirror \a url_r serves, if known. */
+    std::optional<Stats> stats( const Url & url_r ) const;
+
+    /** The \ref Stats::score of \a url_r, the score of an unknown mirror if there are no stats. */
+    double score( const Url & url_r ) const;
+
+    /** Remember the connect time measured for \a url_r. */
+    void recordConnectTime( const Url & url_r, std::chrono::milliseconds connTime_r );
+
+    /** Remember the outcome of a transfer from \a url_r and the throughput if it is known (\c >0). */
+    void recordTransfer( const Url & url_r, bool success_r, double bytesPerSecond_r = 0.0 );
+
+    /** Stable sort \a urls_r by their \ref score, best first. */
+    void sortByHealth( std::vector<Url> & urls_r ) const;
+
+    /** Write the data back to the file if they were changed. */
+    void save();
+
+    /** \ref save if the last save is at least \a interval_r ago. */
+    void saveIfDue( std::chrono::seconds interval_r = std::chrono::minutes( 10 ) );
+
+    /** The key a mirror is stored with. */
+    static std::string makeKey( const Url & url_r );
+
+  private:
+    void load();
+    Stats & touch( const Url & url_r );
+
+  private:
+    mutable std::mutex _lock;
+    Pathname _file;
+    std::unordered_map<std::string, Stats> _stats;
+    bool _dirty = false;
+    std::chrono::steady_clock::time_point _lastSave;
+  };
+
+} // namespace zypp::media
+
+#endif // ZYPP_CURL_PRIVATE_MIRRORHEALTH_P_H
@@ -14,6 +14,9 @@
 #include <zypp-core/Pathname.h>
 #include <zypp-core/base/String.h>
 
+#include <functional>
+#include <optional>
+
 namespace zypp {
 
   class MediaConfigPrivate {
@@ -37,6 +40,8 @@ namespace zypp {
     int download_max_silent_tries;
     int download_transfer_timeout;
     int download_connect_timeout;
+    std::optional<Pathname> download_mirror_health_file;	///< as configured
+    std::function<Pathname()> mirror_health_file_default;
 
   };
 
@@ -87,6 +92,10 @@ namespace zypp {
         if ( d->download_transfer_timeout < 0 )		d->download_transfer_timeout = 0;
         else if ( d->download_transfer_timeout > 3600 )	d->download_transfer_timeout = 3600;
         return true;
+
+      } else if ( entry == "download.mirror_health_file" ) {
+        d->download_mirror_health_file = Pathname(value);
+        return true;
       }
     }
     return false;
@@ -124,6 +133,18 @@ namespace zypp {
   long MediaConfig::download_connect_timeout() const
   { return d_func()->download_connect_timeout; }
 
+  Pathname MediaConfig::download_mirror_health_file() const
+  {
+    Z_D();
+    if ( d->download_mirror_health_file )
+      return *d->download_mirror_health_file;
+    return ( d->mirror_health_file_default ?
+               d->mirror_health_file_default() : Pathname("/var/cache/zypp/mirror-health") );
+  }
+
+  void MediaConfig::setDefaultMirrorHealthFile( std::function<Pathname()> default_r )
+  { d_func()->mirror_health_file_default = std::move(default_r); }
+
   ZYPP_IMPL_PRIVATE(MediaConfig)
 }
 
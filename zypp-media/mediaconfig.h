@@ -15,6 +15,7 @@
 #include <zypp-core/base/NonCopyable.h>
 #include <zypp-core/Pathname.h>
 #include <zypp-core/zyppng/base/zyppglobal.h>
+#include <functional>
 #include <memory>
 #include <string>
 
@@ -90,6 +91,20 @@ namespace zypp {
      */
     long download_connect_timeout() const;
 
+    /*!
+     * File storing the per mirror health data (\ref media::MirrorHealth).
+     * An empty path disables it. If not configured, the value of
+     * \ref setDefaultMirrorHealthFile is used, /var/cache/zypp/mirror-health
+     * if there is none. The media workers get it from the controller.
+     */
+    Pathname download_mirror_health_file() const;
+
+    /*!
+     * Compute the \ref download_mirror_health_file if it is not configured.
+     * \ref ZConfig places it in the root prefixed repo cache directory.
+     */
+    void setDefaultMirrorHealthFile( std::function<Pathname()> default_r );
+
   private:
     MediaConfig();
     std::unique_ptr<MediaConfigPrivate> d_ptr;
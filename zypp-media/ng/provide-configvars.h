@@ -18,11 +18,19 @@ namespace zyppng {
   constexpr std::string_view ANON_ID_CONF("zconfig://media/AnonymousId");
   constexpr std::string_view ATTACH_POINT("zconfig://media/AttachPoint");
   constexpr std::string_view PROVIDER_ROOT("zconfig://media/ProviderRoot");
+  constexpr std::string_view MIRROR_HEALTH_FILE("zconfig://media/MirrorHealthFile"); //< The target roots mirror health file, empty if disabled
 
 
   // request related settings:
   constexpr std::string_view NETWORK_METALINK_ENABLED("zypp-nw-metalink-enabled");  //< Enable or disable metalink for a specific request
   constexpr std::string_view HANDLER_SPECIFIC_DEVICES("zypp-req-specific-devices"); //< Limit the request to a set of devices. Devices are comma seperated.
+  constexpr std::string_view NETWORK_IF_NONE_MATCH("zypp-nw-if-none-match");         //< ETag of a previous download, makes the request conditional
+  constexpr std::string_view NETWORK_IF_MODIFIED_SINCE("zypp-nw-if-modified-since"); //< Last-Modified date of a previous download, makes the request conditional
+
+  // response related headers:
+  constexpr std::string_view NETWORK_NOT_MODIFIED("zypp-nw-not-modified");   //< The server answered a conditional request with 304, the result carries no file
+  constexpr std::string_view NETWORK_ETAG("zypp-nw-etag");                   //< ETag sent by the server along with the file
+  constexpr std::string_view NETWORK_LAST_MODIFIED("zypp-nw-last-modified"); //< Last-Modified date sent by the server along with the file
 }
 
 #endif
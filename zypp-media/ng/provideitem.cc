@@ -674,7 +674,11 @@ namespace zyppng {
         const bool doesDownload     = wConf.worker_type() == ProvideQueue::Config::Downloading;
         const bool fileNeedsCleanup = doesDownload || ( wConf.worker_type() == ProvideQueue::Config::CPUBound && wConf.cfg_flags() & ProvideQueue::Config::FileArtifacts );
 
-        if ( doesDownload ) {
+        if ( msg.value( NETWORK_NOT_MODIFIED, false ).asBool() ) {
+          // the server answered a conditional request with 304, there is no file, just the headers
+          resFile = zypp::ManagedFile();
+
+        } else if ( doesDownload ) {
 
           resFile = provider().addToFileCache ( locFilename );
           if ( !resFile ) {
@@ -17,6 +17,7 @@
 #include <zypp-core/base/StringV.h>
 #include <zypp-media/ng/provide-configvars.h>
 #include <zypp-media/MediaException>
+#include <zypp-media/MediaConfig>
 #include <zypp-media/auth/CredentialManager>
 
 #include <zypp/APIConfig.h>
@@ -340,6 +341,7 @@ namespace zyppng {
     conf.insert ( { AGENT_STRING_CONF.data (), "ZYpp " LIBZYPP_VERSION_STRING } );
     conf.insert ( { ATTACH_POINT.data (), _workerProc->workingDirectory().asString() } );
     conf.insert ( { PROVIDER_ROOT.data (), _parent.z_func()->providerWorkdir().asString() } );
+    conf.insert ( { MIRROR_HEALTH_FILE.data (), zypp::MediaConfig::instance().download_mirror_health_file().asString() } );
 
     const auto &cleanupOnErr = [&](){
       readAllStderr();
@@ -433,7 +435,7 @@ namespace zyppng {
         if ( reqIter == _activeItems.end() ) {
           if (  provMsg->code() == ProvideMessage::Code::ProvideFinished && fileNeedsCleanup ) {
             const auto locFName = provMsg->value( ProvideFinishedMsgFields::LocalFilename ).asString();
-            if ( !_parent.isInCache(locFName) ) {
+            if ( !locFName.empty() && !_parent.isInCache(locFName) ) {
               MIL << "Received a ProvideFinished message for a non existant request. Since this worker reported to create file artifacts, the file is cleaned up." << std::endl;
               zypp::filesystem::unlink( locFName );
             }
@@ -476,7 +478,8 @@ namespace zyppng {
             }
 
             // when a worker is downloading we keep a internal book of cache files
-            if ( doesDownload ) {
+            // a not modified result comes without a file, there is nothing to keep
+            if ( doesDownload && !provMsg->value( NETWORK_NOT_MODIFIED, false ).asBool() ) {
               const auto locFName = provMsg->value( ProvideFinishedMsgFields::LocalFilename ).asString();
               if ( provMsg->value( ProvideFinishedMsgFields::CacheHit, false ).asBool()) {
                 dataRef = _parent.addToFileCache ( locFName );
@@ -8,6 +8,7 @@
 ----------------------------------------------------------------------*/
 
 #include <iostream>
+#include <algorithm>
 #include <cstring>
 #include <cstdlib>
 
@@ -71,12 +72,36 @@ namespace {
   inline bool bothNotDigits( const wchar_t & l, const wchar_t & r )
   { return not ( isDigit( l ) || isDigit( r ) ); }
 
+  /// Iterator over a decoded \ref TableRow::Less::SortKey (same interface as \ref mbs::MbsIteratorNoSGR).
+  struct SortKeyIterator
+  {
+    SortKeyIterator( const std::wstring & key_r )
+    : _pos( key_r.data() )
+    , _end( key_r.data() + key_r.size() )
+    {}
+
+    bool atEnd() const
+    { return _pos == _end; }
+
+    wchar_t operator*() const
+    { return atEnd() ? L'\0' : *_pos; }
+
+    SortKeyIterator & operator++()
+    { if ( ! atEnd() ) ++_pos; return *this; }
+
+  private:
+    const wchar_t * _pos;
+    const wchar_t * _end;
+  };
+
   /// Whether both are at the end of the string.
-  inline bool bothAtEnd( const mbs::MbsIteratorNoSGR & lit, const mbs::MbsIteratorNoSGR & rit )
+  template <class TIterator>
+  inline bool bothAtEnd( const TIterator & lit, const TIterator & rit )
   { return lit.atEnd() && rit.atEnd(); }
 
   /// Whether there are one or more trailing Zeros.
-  inline bool skipTrailingZeros( mbs::MbsIteratorNoSGR & it )
+  template <class TIterator>
+  inline bool skipTrailingZeros( TIterator & it )
   {
     if ( isZero( *it ) ) {
       do { ++it; } while ( isZero( *it ) );
@@ -86,7 +111,8 @@ namespace {
   }
 
   /// compare like numbers: longer digit sequence wins, otherwise first difference
-  inline int wcnumcmpValue( mbs::MbsIteratorNoSGR & lit, mbs::MbsIteratorNoSGR & rit )
+  template <class TIterator>
+  inline int wcnumcmpValue( TIterator & lit, TIterator & rit )
   {
     // PRE: no leading Zeros
     // POST: if 0(equal) is returned, all digis were skipped
@@ -108,60 +134,89 @@ namespace {
       }
     }
   }
-} // namespace
 
-int TableRow::Less::defaultStrComp( bool ci_r, const std::string & lhs, const std::string & rhs )
-{
-  auto wcharcmp = &wccmp; // always start with case sensitive compare
-  int nbias = 0;          // remember the 1st difference (in case num compare equal)
-  int cbias = 0;          // remember the 1st difference (in case ci compare equal)
-  int cmp = 0;
-  mbs::MbsIteratorNoSGR lit { lhs };
-  mbs::MbsIteratorNoSGR rit { rhs };
-  while ( true ) {
-
-    // Endgame: tricky: trailing Zeros are ignored, but count as nbias if there is none.
-    if ( lit.atEnd() ) {
-      if ( skipTrailingZeros( rit ) && not nbias ) return -1;
-      return rit.atEnd() ? (nbias ? nbias : cbias) : -1;
-    }
-    if ( rit.atEnd() ) {
-      if ( skipTrailingZeros( lit ) && not nbias ) return 1;
-      return lit.atEnd() ? (nbias ? nbias : cbias) : 1;
-    }
+  /// Natural('sort -V' like) [case insensitive] compare of the wchar_t sequences.
+  template <class TIterator>
+  int naturalStrComp( bool ci_r, TIterator lit, TIterator rit )
+  {
+    auto wcharcmp = &wccmp; // always start with case sensitive compare
+    int nbias = 0;          // remember the 1st difference (in case num compare equal)
+    int cbias = 0;          // remember the 1st difference (in case ci compare equal)
+    int cmp = 0;
+    while ( true ) {
+
+      // Endgame: tricky: trailing Zeros are ignored, but count as nbias if there is none.
+      if ( lit.atEnd() ) {
+        if ( skipTrailingZeros( rit ) && not nbias ) return -1;
+        return rit.atEnd() ? (nbias ? nbias : cbias) : -1;
+      }
+      if ( rit.atEnd() ) {
+        if ( skipTrailingZeros( lit ) && not nbias ) return 1;
+        return lit.atEnd() ? (nbias ? nbias : cbias) : 1;
+      }
 
-    // num <> num?
-    if ( bothDigits( *lit, *rit ) ) {
-      if ( isZero( *lit ) || isZero( *rit ) ) {
-        int lead = 0; // the more leasing zeros a number has, the less: 001 01 1
-        while ( isZero( *lit ) ) { ++lit; --lead; }
-        while ( isZero( *rit ) ) { ++rit; ++lead; }
-        if ( not nbias && lead )
-          nbias = bothAtEnd( lit, rit ) ? -lead : lead;  // the less trailing zeros, the less: a a0 a00
+      // num <> num?
+      if ( bothDigits( *lit, *rit ) ) {
+        if ( isZero( *lit ) || isZero( *rit ) ) {
+          int lead = 0; // the more leasing zeros a number has, the less: 001 01 1
+          while ( isZero( *lit ) ) { ++lit; --lead; }
+          while ( isZero( *rit ) ) { ++rit; ++lead; }
+          if ( not nbias && lead )
+            nbias = bothAtEnd( lit, rit ) ? -lead : lead;  // the less trailing zeros, the less: a a0 a00
+        }
+        if ( (cmp = wcnumcmpValue( lit, rit )) )
+          return cmp;
+        continue; // already skipped all digits
       }
-      if ( (cmp = wcnumcmpValue( lit, rit )) )
-        return cmp;
-      continue; // already skipped all digits
-    }
-    else {
-      if ( (cmp = wcharcmp( *lit, *rit )) ) {
-        if ( not cbias ) cbias = cmp; // remember the 1st difference (by wccmp)
-        if ( ci_r ) {
-          if ( (cmp = wccasecmp( *lit, *rit )) )
+      else {
+        const wchar_t lch = *lit;
+        const wchar_t rch = *rit;
+        if ( (cmp = wcharcmp( lch, rch )) ) {
+          if ( not cbias ) cbias = cmp; // remember the 1st difference (by wccmp)
+          if ( ci_r ) {
+            if ( (cmp = wccasecmp( lch, rch )) )
+              return cmp;
+            wcharcmp = &wccasecmp;
+            ci_r = false;
+          }
+          else
             return cmp;
-          wcharcmp = &wccasecmp;
-          ci_r = false;
         }
-        else
-          return cmp;
       }
+      ++lit; ++rit;
     }
-    ++lit; ++rit;
   }
+} // namespace
+
+int TableRow::Less::defaultStrComp( bool ci_r, const std::string & lhs, const std::string & rhs )
+{ return naturalStrComp( ci_r, mbs::MbsIteratorNoSGR( lhs ), mbs::MbsIteratorNoSGR( rhs ) ); }
+
+int TableRow::Less::defaultKeyComp( bool ci_r, const SortKey & lhs, const SortKey & rhs )
+{ return naturalStrComp( ci_r, SortKeyIterator( lhs ), SortKeyIterator( rhs ) ); }
+
+TableRow::Less::SortKey TableRow::Less::sortKey( const std::string & str_r )
+{
+  SortKey ret;
+  ret.reserve( str_r.size() );
+  for ( mbs::MbsIteratorNoSGR it { str_r }; ! it.atEnd(); ++it )
+    ret.push_back( *it );
+  return ret;
+}
+
+TableRow::Less::SortKeys TableRow::Less::sortKeys( const TableRow & row_r ) const
+{
+  SortKeys ret;
+  ret.reserve( _by_columns.size() );
+  for ( const SortParam & sortParam : _by_columns ) {
+    unsigned byColumn = std::get<0>( sortParam );
+    ret.push_back( byColumn < row_r._columns.size() ? sortKey( row_r._columns[byColumn] ) : SortKey() );
+  }
+  return ret;
 }
 
 TableRow & TableRow::add( std::string s )
 {
+  _widths.clear();
   if ( _translateColumns )
     _translatedColumns.push_back( _(s.c_str()) );
   _columns.push_back( std::move(s) );
@@ -175,6 +230,19 @@ TableRow & TableRow::addDetail( std::string s )
 }
 
 // 1st implementation: no width calculation, just tabs
+const std::vector<unsigned> & TableRow::widths() const
+{
+  const container & cols { columns() };
+  if ( _widths.size() != cols.size() )
+  {
+    _widths.clear();
+    _widths.reserve( cols.size() );
+    for ( const std::string & col : cols )
+      _widths.push_back( mbs_width( col ) );
+  }
+  return _widths;
+}
+
 std::ostream & TableRow::dumbDumpTo( std::ostream & stream ) const
 {
   bool seen_first = false;
@@ -244,10 +312,10 @@ std::ostream & TableRow::dumpTo( std::ostream & stream, const Table & parent ) c
       seen_first = true;
 
     // stream.width (widths[c]); // that does not work with multibyte chars
-    ssize = mbs_width( s );
+    ssize = _translateColumns ? mbs_width( s ) : widths()[c];
     if ( ssize > parent._max_width[c] )
     {
-      unsigned cutby = parent._max_width[c] - 2;
+      unsigned cutby = parent._max_width[c] > 2 ? parent._max_width[c] - 2 : 0;
       std::string cutstr = mbs_substr_by_width( s, 0, cutby );
       stream << ( _ctxt << cutstr ) << std::string(cutby - mbs_width( cutstr ), ' ') << "->";
     }
@@ -328,10 +396,95 @@ Table::Table()
 
 Table & Table::add( TableRow tr )
 {
+  if ( _stream )
+  {
+    streamRow( tr );
+    return *this;
+  }
   _rows.push_back( std::move(tr) );
   return *this;
 }
 
+void Table::sortRows( const TableRow::Less & less_r )
+{
+  if ( _rows.size() < 2 )
+    return;
+
+  // Decode the sort columns once per row, not on every comparison.
+  std::vector<std::pair<container::iterator,TableRow::Less::SortKeys>> keyed;
+  keyed.reserve( _rows.size() );
+  for ( auto it = _rows.begin(); it != _rows.end(); ++it )
+    keyed.emplace_back( it, less_r.sortKeys( *it ) );
+
+  std::stable_sort( keyed.begin(), keyed.end(), [&less_r]( const auto & lhs, const auto & rhs ) {
+    return less_r( *lhs.first, lhs.second, *rhs.first, rhs.second );
+  });
+
+  container sorted;
+  for ( auto & el : keyed )
+    sorted.splice( sorted.end(), _rows, el.first );
+  _rows.swap( sorted );
+}
+
+void Table::streamTo( std::ostream & stream_r, std::vector<unsigned> widths_r )
+{
+  _stream = &stream_r;
+  _streamStarted = false;
+  _fixedWidths = widths_r.size();
+  _max_width = std::move(widths_r);
+  if ( _max_width.empty() )
+    _max_width.push_back( 0 );
+  _max_col = _max_width.size()-1;
+
+  // rows added so far go first
+  container rows;
+  rows.swap( _rows );
+  for ( const auto & row : rows )
+    streamRow( row );
+}
+
+void Table::updateStreamedColWidths( const TableRow & tr ) const
+{
+  // Fixed columns keep their width, additional ones grow as needed.
+  const auto & widths { tr.widths() };
+  if ( _max_width.size() < widths.size() )
+  {
+    _max_width.resize( widths.size(), 0 );
+    _max_col = _max_width.size()-1;
+  }
+  for ( unsigned c = _fixedWidths; c < widths.size(); ++c )
+  {
+    if ( _max_width[c] < widths[c] )
+      _max_width[c] = widths[c];
+  }
+
+  int sepwidth = _style == none ? 2 : 3;
+  _width = -sepwidth;
+  for ( unsigned w : _max_width )
+    _width += w + sepwidth;
+  _width += _margin * 2;
+}
+
+void Table::startStream( std::ostream & stream ) const
+{
+  if ( _streamStarted )
+    return;
+  _streamStarted = true;
+  if ( _has_header )
+  {
+    updateStreamedColWidths( _header );
+    dumpHeader( stream );
+  }
+}
+
+void Table::streamRow( const TableRow & tr ) const
+{
+  startStream( *_stream );
+  updateStreamedColWidths( tr );
+  tr.dumpTo( *_stream, *this );
+  ++_streamedRows;
+}
+
 Table & Table::setHeader( TableHeader tr )
 {
   _header = std::move(tr);
@@ -365,11 +518,11 @@ void Table::updateColWidths( const TableRow & tr ) const
     _max_col = _max_width.size()-1;
   }
 
-  unsigned c = 0;
-  for ( const auto & col : columns )
+  const auto & widths { tr.widths() };
+  for ( unsigned c = 0; c < columns.size(); ++c )
   {
-    unsigned &max = _max_width[c++];
-    unsigned cur = mbs_width( col );
+    unsigned &max = _max_width[c];
+    unsigned cur = widths[c];
 
     if ( max < cur )
       max = cur;
@@ -400,8 +553,23 @@ void Table::dumpRule( std::ostream &stream ) const
   stream << std::endl;
 }
 
+void Table::dumpHeader( std::ostream & stream ) const
+{
+  zypp::DtorReset inHeader( _inHeader, false );
+  _inHeader = true;
+  _header.dumpTo( stream, *this );
+  dumpRule( stream );
+}
+
 std::ostream & Table::dumpTo( std::ostream & stream ) const
 {
+  if ( _stream )
+  {
+    // rows are already written; just the header if there were none
+    startStream( stream );
+    return stream;
+  }
+
   // compute column sizes
   if ( _has_header )
     updateColWidths( _header );
@@ -425,12 +593,7 @@ std::ostream & Table::dumpTo( std::ostream & stream ) const
   }
 
   if ( _has_header )
-  {
-    zypp::DtorReset inHeader( _inHeader, false );
-    _inHeader = true;
-    _header.dumpTo( stream, *this );
-    dumpRule (stream);
-  }
+    dumpHeader( stream );
 
   for ( const auto & row : _rows )
     row.dumpTo( stream, *this );
@@ -231,13 +231,16 @@ public:
   { return _translateColumns ? _translatedColumns : _columns; }
 
   container & columns()
-  { return _translateColumns ? _translatedColumns : _columns; }
+  { _widths.clear(); return _translateColumns ? _translatedColumns : _columns; }
 
   const container & columnsNoTr() const
   { return _columns; }
 
   container & columnsNoTr()
-  { return _columns; }
+  { _widths.clear(); return _columns; }
+
+  /** The display width of the \ref columns (computed once and cached). */
+  const std::vector<unsigned> & widths() const;
 
 protected:
   bool      _translateColumns = false;
@@ -247,6 +250,7 @@ private:
   container _details;
   ColorContext _ctxt;
   boost::any _userData;	///< user defined sort index, e.g. if string values don't work due to coloring
+  mutable std::vector<unsigned> _widths;	///< cached display widths of the columns
 };
 
 /** \relates TableRow Add colummn. */
@@ -323,6 +327,8 @@ TableHeader && operator<<( TableHeader && th, Tp_ && val )
 struct TableRow::Less
 {
   using SortParam = std::tuple<unsigned,bool>;  ///< column and sortCI
+  using SortKey   = std::wstring;               ///< a column value decoded for \ref defaultKeyComp (ANSI SGR stripped)
+  using SortKeys  = std::vector<SortKey>;       ///< a rows \ref SortKey per sort column
 
   Less( const TableHeader & header_r, const std::list<unsigned>& by_columns_r )
   {
@@ -335,14 +341,30 @@ struct TableRow::Less
   {
     int c = 0;
     for ( const SortParam &sortParam : _by_columns ) {
-      if ( (c = compCol( sortParam, a_r, b_r )) )
+      if ( (c = compCol( sortParam, a_r, b_r, nullptr, nullptr )) )
+        return c < 0;
+    }
+    return false;
+  }
+
+  /** \overload using the rows precomputed \ref sortKeys. */
+  bool operator()( const TableRow & a_r, const SortKeys & akeys_r, const TableRow & b_r, const SortKeys & bkeys_r ) const
+  {
+    int c = 0;
+    unsigned idx = 0;
+    for ( const SortParam &sortParam : _by_columns ) {
+      if ( (c = compCol( sortParam, a_r, b_r, &akeys_r[idx], &bkeys_r[idx] )) )
         return c < 0;
+      ++idx;
     }
     return false;
   }
 
+  /** The \ref SortKey of each sort column in \a row_r (empty if the row has no such column). */
+  SortKeys sortKeys( const TableRow & row_r ) const;
+
 private:
-  int compCol( const SortParam & sortParam_r, const TableRow & a_r, const TableRow & b_r ) const
+  int compCol( const SortParam & sortParam_r, const TableRow & a_r, const TableRow & b_r, const SortKey * akey_r, const SortKey * bkey_r ) const
   {
     const auto & [ byColumn, sortCI ] { sortParam_r };
     bool noL = byColumn >= a_r._columns.size();
@@ -384,12 +406,20 @@ private:
       } else
         return ( noL && ! noR ? -1 : ! noL && noR ?  1 : 0);
     }
+    if ( akey_r && bkey_r )
+      return defaultKeyComp( sortCI, *akey_r, *bkey_r );
     return defaultStrComp( sortCI, a_r._columns[byColumn], b_r._columns[byColumn] );
   }
 
   /** Natural('sort -V' like) [case insensitive] compare ignoring ANSI SGR chars. */
   static int defaultStrComp( bool ci_r, const std::string & lhs, const std::string & rhs );
 
+  /** \ref defaultStrComp on already decoded values. */
+  static int defaultKeyComp( bool ci_r, const SortKey & lhs, const SortKey & rhs );
+
+  /** Decode \a str_r for \ref defaultKeyComp. */
+  static SortKey sortKey( const std::string & str_r );
+
 private:
   std::list<SortParam> _by_columns;
 };
@@ -408,7 +438,17 @@ public:
 
 
   std::ostream & dumpTo( std::ostream & stream ) const;
-  bool empty() const { return _rows.empty(); }
+  bool empty() const { return _rows.empty() && ! _streamedRows; }
+
+  /** Stream rows to \a stream_r as they are added, rather than buffering them.
+   *
+   * The columns are laid out using the fixed \a widths_r; longer values are
+   * cut. Columns without a fixed width grow as needed, so they may not be
+   * aligned. The header is written before the first row. Rows already added
+   * are written immediately. Sorting and abbreviation do not apply to
+   * streamed rows.
+   */
+  void streamTo( std::ostream & stream_r, std::vector<unsigned> widths_r );
 
 
   /** Unsorted - pseudo sort column indicating not to sort. */
@@ -426,9 +466,9 @@ public:
   void sort()					{ sort( unsigned(_defaultSortColumn ) ); }
 
   /** Sort by \a byColumn_r */
-  void sort( unsigned byColumn_r )		        { if ( byColumn_r != Unsorted ) _rows.sort( TableRow::Less( header(), { byColumn_r } ) ); }
-  void sort( const std::list<unsigned> & byColumns_r )	{ if ( byColumns_r.size() ) _rows.sort( TableRow::Less( header(), byColumns_r ) ); }
-  void sort( std::list<unsigned> && byColumns_r )	{ if ( byColumns_r.size() ) _rows.sort( TableRow::Less( header(), std::move(byColumns_r) ) ); }
+  void sort( unsigned byColumn_r )		        { if ( byColumn_r != Unsorted ) sortRows( TableRow::Less( header(), { byColumn_r } ) ); }
+  void sort( const std::list<unsigned> & byColumns_r )	{ if ( byColumns_r.size() ) sortRows( TableRow::Less( header(), byColumns_r ) ); }
+  void sort( std::list<unsigned> && byColumns_r )	{ if ( byColumns_r.size() ) sortRows( TableRow::Less( header(), std::move(byColumns_r) ) ); }
 
   /** Custom sort */
   template<class TCompare, std::enable_if_t<!std::is_integral_v<TCompare>, int> = 0>
@@ -450,7 +490,15 @@ public:
 
 private:
   void dumpRule( std::ostream & stream ) const;
+  /** The header line followed by the rule. */
+  void dumpHeader( std::ostream & stream ) const;
   void updateColWidths( const TableRow & tr ) const;
+  void updateStreamedColWidths( const TableRow & tr ) const;
+  /** Write the header once when streaming starts. */
+  void startStream( std::ostream & stream ) const;
+  void streamRow( const TableRow & tr ) const;
+  /** Stable sort using precomputed sort keys. */
+  void sortRows( const TableRow::Less & less_r );
 
   bool _has_header;
   TableHeader _header;
@@ -480,6 +528,15 @@ private:
 
   mutable bool _inHeader;
 
+  //! \ref streamTo target, if streaming
+  std::ostream * _stream = nullptr;
+  //! number of columns with a fixed width when streaming
+  unsigned _fixedWidths = 0;
+  //! whether the header was written when streaming
+  mutable bool _streamStarted = false;
+  //! number of rows written when streaming
+  mutable unsigned _streamedRows = 0;
+
   friend class TableRow;
 };
 
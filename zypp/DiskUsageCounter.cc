@@ -16,6 +16,8 @@ extern "C"
 
 #include <iostream>
 #include <fstream>
+#include <unordered_map>
+#include <vector>
 
 #include <zypp/base/Easy.h>
 #include <zypp/base/LogTools.h>
@@ -25,7 +27,9 @@ extern "C"
 #include <zypp/DiskUsageCounter.h>
 #include <zypp/ExternalProgram.h>
 #include <zypp/sat/Pool.h>
+#include <zypp/sat/LookupAttr.h>
 #include <zypp/sat/detail/PoolImpl.h>
+#include <zypp/base/SerialNumber.h>
 
 using std::endl;
 
@@ -37,22 +41,24 @@ namespace zypp
   namespace
   { /////////////////////////////////////////////////////////////////
 
-    DiskUsageCounter::MountPointSet calcDiskUsage( DiskUsageCounter::MountPointSet result, const Bitmap & installedmap_r )
+    /** Per mountpoint data size and number of files (in the order of the MountPointSet). */
+    struct DUEntry
     {
-      if ( result.empty() )
-      {
-        // partitioning is not set
-        return result;
-      }
+      long long kbytes = 0;
+      long long files = 0;
+    };
+    using DUVector = std::vector<DUEntry>;
 
+    DUVector calcDUChanges( const DiskUsageCounter::MountPointSet & mps_r, const Bitmap & installedmap_r )
+    {
       sat::Pool satpool( sat::Pool::instance() );
 
       // init libsolv result vector with mountpoints
       static const ::DUChanges _initdu = { 0, 0, 0, 0 };
-      std::vector< ::DUChanges> duchanges( result.size(), _initdu );
+      std::vector< ::DUChanges> duchanges( mps_r.size(), _initdu );
       {
         unsigned idx = 0;
-        for_( it, result.begin(), result.end() )
+        for_( it, mps_r.begin(), mps_r.end() )
         {
           duchanges[idx].path = it->dir.c_str();
           if ( it->growonly )
@@ -66,43 +72,181 @@ namespace zypp
                              &duchanges[0],
                              duchanges.size() );
 
-      // and process the result
+      DUVector ret( duchanges.size() );
+      for ( unsigned idx = 0; idx < duchanges.size(); ++idx )
       {
-        unsigned idx = 0;
-        for_( it, result.begin(), result.end() )
-        {
-          // Limit estimated waste (half block per file) as it does not apply to
-          // btrfs, which reports up to 64K blocksize (bsc#974275,bsc#965322)
-          static const ByteCount blockAdjust( 2, ByteCount::K ); // (files * blocksize) / 2 / 1K; result value in K!
-
-          it->pkg_size = it->used_size          // current usage
-                       + duchanges[idx].kbytes  // package data size
-                       + ( duchanges[idx].files * ( it->fstype == "btrfs" ? 4096 : it->block_size ) / blockAdjust ); // half block per file
-          ++idx;
-        }
+        ret[idx].kbytes = duchanges[idx].kbytes;
+        ret[idx].files  = duchanges[idx].files;
       }
+      return ret;
+    }
 
+    DiskUsageCounter::MountPointSet applyDUChanges( DiskUsageCounter::MountPointSet result, const DUVector & duchanges_r )
+    {
+      unsigned idx = 0;
+      for_( it, result.begin(), result.end() )
+      {
+        // Limit estimated waste (half block per file) as it does not apply to
+        // btrfs, which reports up to 64K blocksize (bsc#974275,bsc#965322)
+        static const ByteCount blockAdjust( 2, ByteCount::K ); // (files * blocksize) / 2 / 1K; result value in K!
+
+        it->pkg_size = it->used_size              // current usage
+                     + duchanges_r[idx].kbytes    // package data size
+                     + ( duchanges_r[idx].files * ( it->fstype == "btrfs" ? 4096 : it->block_size ) / blockAdjust ); // half block per file
+        ++idx;
+      }
       return result;
     }
 
+    DiskUsageCounter::MountPointSet calcDiskUsage( DiskUsageCounter::MountPointSet result, const Bitmap & installedmap_r )
+    {
+      if ( result.empty() )
+      {
+        // partitioning is not set
+        return result;
+      }
+      DUVector duchanges { calcDUChanges( result, installedmap_r ) };
+      return applyDUChanges( std::move(result), duchanges );
+    }
+
+    /** Whether \a solv_r provides disk usage data. */
+    inline bool hasDUData( sat::Solvable solv_r )
+    { return ! sat::LookupAttr( sat::SolvAttr::diskusage, solv_r ).empty(); }
+
     /////////////////////////////////////////////////////////////////
   } // namespace
   ///////////////////////////////////////////////////////////////////
 
-  DiskUsageCounter::MountPointSet DiskUsageCounter::disk_usage( const ResPool & pool_r ) const
+  ///////////////////////////////////////////////////////////////////
+  /// \class DiskUsageCounter::DeltaCache
+  /// \brief The last \ref DiskUsageCounter::disk_usage(const ResPool&) computation.
+  ///
+  /// \c pool_calc_duchanges adds the DU of all uninstalled solvables in the
+  /// installedmap and subtracts the DU of all installed solvables not in
+  /// the map (except on growonly mountpoints). So we remember the map and
+  /// the per mountpoint totals and, if just a few solvables change their
+  /// state, add or subtract their DU. The DU of a single solvable is computed
+  /// once and cached.
+  ///
+  /// The sum is not linear if an uninstalled solvable without DU data
+  /// is in the map: libsolv then ignores the DU of the installed solvables
+  /// it obsoletes. As long as there are such solvables in the map, the
+  /// full computation is used.
+  ///////////////////////////////////////////////////////////////////
+  class DiskUsageCounter::DeltaCache
   {
-    Bitmap bitmap( Bitmap::poolSize );
+  public:
+    /** Don't bother with single solvables if that many changed. */
+    static constexpr unsigned maxDelta = 64;
 
-    // build installedmap (installed != transact)
-    // stays installed or gets installed
-    for_( it, pool_r.begin(), pool_r.end() )
+    DiskUsageCounter::MountPointSet disk_usage( const ResPool & pool_r, const MountPointSet & mps_r )
     {
-      if ( it->status().isInstalled() != it->status().transacts() )
+      sat::Pool satpool( sat::Pool::instance() );
+      if ( _watcher.remember( satpool.serial() ) )
+      {
+        // pool content changed: start over
+        _map = Bitmap( Bitmap::poolSize );
+        _scratch = Bitmap( Bitmap::poolSize );
+        _solvableDU.clear();
+        _totalValid = false;
+        _noDUData = 0;
+      }
+
+      std::vector<sat::Solvable> changed;
+      for ( const PoolItem & pi : pool_r )
       {
-        bitmap.set( sat::asSolvable()(*it).id() );
+        // installedmap: stays installed or gets installed (installed != transact)
+        bool inmap = pi.status().isInstalled() != pi.status().transacts();
+        sat::Solvable solv { pi.satSolvable() };
+        if ( inmap == _map.test( solv.id() ) )
+          continue;
+
+        _map.assign( solv.id(), inmap );
+        if ( ! solv.isSystem() && ! hasDUData( solv ) )
+        {
+          if ( inmap )
+            ++_noDUData;
+          else
+            --_noDUData;
+        }
+        if ( _totalValid )
+          changed.push_back( solv );
       }
+
+      if ( _noDUData || ! _totalValid || changed.size() > maxDelta )
+      {
+        DUVector total { calcDUChanges( mps_r, _map ) };
+        // The totals are just the linear sum, if there are no solvables without DU data in the map.
+        _totalValid = ! _noDUData;
+        if ( _totalValid )
+          _total = total;
+        return applyDUChanges( mps_r, total );
+      }
+
+      std::vector<bool> growonly;
+      for ( const MountPoint & mp : mps_r )
+        growonly.push_back( mp.growonly );
+
+      for ( sat::Solvable solv : changed )
+      {
+        const DUVector & du { solvableDU( solv, mps_r ) };
+        bool inmap = _map.test( solv.id() );
+        for ( unsigned idx = 0; idx < du.size(); ++idx )
+        {
+          if ( solv.isSystem() && growonly[idx] )
+            continue;	// removing installed solvables does not free space here
+          if ( inmap )
+          {
+            _total[idx].kbytes += du[idx].kbytes;
+            _total[idx].files  += du[idx].files;
+          }
+          else
+          {
+            _total[idx].kbytes -= du[idx].kbytes;
+            _total[idx].files  -= du[idx].files;
+          }
+        }
+      }
+      return applyDUChanges( mps_r, _total );
     }
-    return calcDiskUsage( _mps, bitmap );
+
+  private:
+    /** The DU of \a solv_r on each mountpoint (as if it were not installed). */
+    const DUVector & solvableDU( sat::Solvable solv_r, const MountPointSet & mps_r )
+    {
+      auto it { _solvableDU.find( solv_r.id() ) };
+      if ( it == _solvableDU.end() )
+      {
+        _scratch.set( solv_r.id() );
+        // temp. unset @system Repo
+        DtorReset tmp( sat::Pool::instance().get()->installed );
+        sat::Pool::instance().get()->installed = nullptr;
+        it = _solvableDU.emplace( solv_r.id(), calcDUChanges( mps_r, _scratch ) ).first;
+        _scratch.clear( solv_r.id() );
+      }
+      return it->second;
+    }
+
+  private:
+    SerialNumberWatcher _watcher;	///< sat pool content the cache refers to
+    Bitmap _map;			///< last installedmap
+    DUVector _total;			///< per mountpoint totals of the last installedmap (if _totalValid)
+    bool _totalValid = false;
+    unsigned _noDUData = 0;		///< uninstalled solvables without DU data in the map
+    std::unordered_map<sat::detail::SolvableIdType, DUVector> _solvableDU;
+    Bitmap _scratch;			///< to compute a single solvables DU
+  };
+
+  DiskUsageCounter::MountPointSet DiskUsageCounter::disk_usage( const ResPool & pool_r ) const
+  {
+    if ( _mps.empty() )
+    {
+      // partitioning is not set
+      return _mps;
+    }
+    if ( ! _deltaCache )
+      _deltaCache.reset( new DeltaCache );
+    return _deltaCache->disk_usage( pool_r, _mps );
   }
 
   DiskUsageCounter::MountPointSet DiskUsageCounter::disk_usage( sat::Solvable solv_r ) const
@@ -28,6 +28,15 @@ namespace zypp
   ///////////////////////////////////////////////////////////////////
   /// \class DiskUsageCounter
   /// \brief Compute disk space occupied by packages across partitions/directories
+  ///
+  /// \ref disk_usage(const ResPool&) remembers its last result. As long as
+  /// the pools content and the MountPointSet do not change, subsequent
+  /// calls just add or subtract the (cached) contributions of the solvables
+  /// which changed their state. So recomputing the disk usage after each
+  /// selection change does not re-walk the dirlists of all selected solvables.
+  ///
+  /// The remembered result belongs to the instance; copies start without
+  /// one, so they do not interfere with each other.
   ///////////////////////////////////////////////////////////////////
   class ZYPP_API DiskUsageCounter
   {
@@ -161,9 +170,21 @@ namespace zypp
     : _mps(std::move( mps_r ))
     {}
 
+    /** Copy the MountPointSet but not the last disk_usage(const ResPool&) computation. */
+    DiskUsageCounter( const DiskUsageCounter & rhs )
+    : _mps( rhs._mps )
+    {}
+
+    /** \overload */
+    DiskUsageCounter & operator=( const DiskUsageCounter & rhs )
+    { if ( this != &rhs ) { _mps = rhs._mps; _deltaCache.reset(); } return *this; }
+
+    DiskUsageCounter( DiskUsageCounter && ) = default;
+    DiskUsageCounter & operator=( DiskUsageCounter && ) = default;
+
     /** Set a MountPointSet to compute */
     void setMountPoints( const MountPointSet & mps_r )
-    { _mps = mps_r; }
+    { _mps = mps_r; _deltaCache.reset(); }
 
     /** Get the current MountPointSet */
     const MountPointSet & getMountPoints() const
@@ -180,7 +201,10 @@ namespace zypp
     static MountPointSet justRootPartition();
 
 
-    /** Compute disk usage if the current transaction woud be commited. */
+    /** Compute disk usage if the current transaction woud be commited.
+     * Subsequent calls are computed incrementally from the solvables which
+     * changed their state since the last call (see \ref DiskUsageCounter).
+     */
     MountPointSet disk_usage( const ResPool & pool ) const;
 
     /** Compute disk usage of a single Solvable */
@@ -206,7 +230,9 @@ namespace zypp
     }
 
   private:
+    class DeltaCache;
     MountPointSet _mps;
+    mutable shared_ptr<DeltaCache> _deltaCache;	///< last disk_usage(const ResPool&) computation
   };
   ///////////////////////////////////////////////////////////////////
 
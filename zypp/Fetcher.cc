@@ -21,6 +21,7 @@
 #include <zypp-core/base/DefaultIntegral>
 #include <zypp/base/String.h>
 #include <zypp-media/MediaException>
+#include <zypp-media/MediaConfig>
 #include <zypp/Fetcher.h>
 #include <zypp/ZYppFactory.h>
 #include <zypp/CheckSum.h>
@@ -108,6 +109,7 @@ namespace zypp
     //CompositeFileChecker checkers;
     std::list<FileChecker> checkers;
     Flags flags;
+    DefaultIntegral<bool,false> precached;	///< already passed to MediaSetAccess::precacheFiles
   };
 
   ZYPP_DECLARE_OPERATORS_FOR_FLAGS(FetcherJob::Flags);
@@ -221,6 +223,14 @@ namespace zypp
        */
       void provideToDest( MediaSetAccess & media_r, const Pathname & destDir_r , const FetcherJob_Ptr & jobp_r );
 
+      /**
+       * Pass the next batch of file jobs starting at \a begin_r, which are not
+       * already in the cache, to \ref MediaSetAccess::precacheFiles. A network
+       * media downloads them concurrently.
+       */
+      void precacheJobs( MediaSetAccess & media_r, const Pathname & destDir_r,
+                         std::list<FetcherJob_Ptr>::const_iterator begin_r );
+
   private:
     friend Impl * rwcowClone<Impl>( const Impl * rhs );
     /** clone for RWCOW_pointer */
@@ -243,9 +253,6 @@ namespace zypp
 
   void Fetcher::Impl::enqueueDigested( const OnMediaLocation &resource, const FileChecker & )
   {
-    if ( _mediaSetAccess )
-      _mediaSetAccess->precacheFiles( {resource} );
-
     FetcherJob_Ptr job;
     job.reset(new FetcherJob(resource));
     job->flags |= FetcherJob:: AlwaysVerifyChecksum;
@@ -297,9 +304,6 @@ namespace zypp
 
   void Fetcher::Impl::enqueue( const OnMediaLocation &resource, const FileChecker &checker )
   {
-    if ( _mediaSetAccess )
-      _mediaSetAccess->precacheFiles( {resource} );
-
     FetcherJob_Ptr job;
     job.reset(new FetcherJob(resource));
     if ( checker )
@@ -579,6 +583,38 @@ namespace zypp
     }
   }
 
+  void Fetcher::Impl::precacheJobs( MediaSetAccess & media_r, const Pathname & destDir_r,
+                                    std::list<FetcherJob_Ptr>::const_iterator begin_r )
+  {
+    const size_t batchSize = 4 * std::max( 1L, MediaConfig::instance().download_max_concurrent_connections() );
+
+    std::vector<OnMediaLocation> batch;
+    for ( auto it = begin_r; it != _resources.end() && batch.size() < batchSize; ++it )
+    {
+      const FetcherJob_Ptr & jobp { *it };
+      if ( jobp->precached || ( jobp->flags & FetcherJob::Directory ) )
+        continue;
+
+      jobp->precached = true;
+      if ( locateInCache( jobp->location, destDir_r ).empty() )
+        batch.push_back( jobp->location );
+    }
+
+    if ( batch.empty() )
+      return;
+
+    try
+    {
+      DBG << "Precaching " << batch.size() << " files" << endl;
+      media_r.precacheFiles( batch );
+    }
+    catch ( const Exception & excpt )
+    {
+      // not an error, the files are downloaded on demand
+      ZYPP_CAUGHT( excpt );
+    }
+  }
+
   // helper class to consume a content file
   struct ContentReaderHelper : public parser::susetags::ContentFileReader
   {
@@ -753,8 +789,14 @@ namespace zypp
 
     downloadAndReadIndexList(media, dest_dir);
 
-    for ( const FetcherJob_Ptr & jobp : _resources )
+    // Files from a downloading media are precached in batches, so they are
+    // transferred concurrently. Providing and validating them is still done
+    // job by job in order.
+    const bool doPrecache = media.url().schemeIsDownloading();
+
+    for ( auto it = _resources.cbegin(); it != _resources.cend(); ++it )
     {
+      const FetcherJob_Ptr & jobp { *it };
       if ( jobp->flags & FetcherJob::Directory )
       {
           const OnMediaLocation location(jobp->location);
@@ -762,6 +804,9 @@ namespace zypp
           continue;
       }
 
+      if ( doPrecache && ! jobp->precached )
+        precacheJobs( media, dest_dir, it );
+
       // may be this code can be factored out
       // together with the autodiscovery of indexes
       // of addDirJobs
@@ -324,6 +324,11 @@ namespace zypp
     * The file tree will be replicated inside this
     * directory
     *
+    * If the media is downloading (e.g. http), files are precached in
+    * batches and transferred concurrently, limited by the
+    * \c download.max_concurrent_connections setting. They are
+    * still checked and moved to \a dest_dir one by one, in the
+    * order they were enqueued.
     */
     void start( const Pathname &dest_dir,
       const ProgressData::ReceiverFnc & progress = ProgressData::ReceiverFnc() );
@@ -15,6 +15,7 @@
 #include <iostream>
 #include <fstream>
 #include <optional>
+#include <chrono>
 #include <sys/file.h>
 #include <cstdio>
 #include <unistd.h>
@@ -123,13 +124,13 @@ namespace zypp
 
   KeyManagerCtx &CachedPublicKeyData::Manip::keyManagerCtx() {
     if ( not _context ) {
-      _context = KeyManagerCtx::createForOpenPGP( _keyring );
+      _context = &_cache.context( _keyring );
     }
     // frankly: don't remember why an explicit setDirty was introduced and
     // why WatchFile was not enough. Maybe some corner case when the keyrings
     // are created?
     _cache.setDirty( _keyring );
-    return _context.value();
+    return *_context;
   }
 
   CachedPublicKeyData::Cache::Cache() {}
@@ -164,18 +165,63 @@ namespace zypp
 
   CachedPublicKeyData::Manip CachedPublicKeyData::manip(filesystem::Pathname keyring_r) { return Manip( *this, std::move(keyring_r) ); }
 
+  KeyManagerCtx &CachedPublicKeyData::context(const filesystem::Pathname &keyring_r) const
+  {
+    Cache & cache( _cacheMap[keyring_r] );
+    if ( not cache._context ) {
+      cache._context = KeyManagerCtx::createForOpenPGP( keyring_r );
+    }
+    return *cache._context;
+  }
+
+  PublicKeyData CachedPublicKeyData::lookup(const filesystem::Pathname &keyring_r, const std::string &id_r) const
+  {
+    Cache & cache( assertData( keyring_r ) );
+    // PublicKeyData::providesKey is case insensitive
+    const std::string key { str::toUpper( id_r ) };
+    auto it = cache._lookup.find( key );
+    if ( it == cache._lookup.end() ) {
+      PublicKeyData found;
+      for ( const PublicKeyData & data : cache._data ) {
+        if ( data.providesKey( id_r ) ) {
+          found = data;
+          break;
+        }
+      }
+      it = cache._lookup.emplace( key, found ).first;
+    }
+    return it->second;
+  }
+
+  filesystem::TmpFile CachedPublicKeyData::exported(const filesystem::Pathname &keyring_r, const std::string &id_r,
+                                                    const std::function<filesystem::TmpFile ()> &export_r) const
+  {
+    Cache & cache( assertData( keyring_r ) );
+    auto it = cache._exported.find( id_r );
+    if ( it == cache._exported.end() ) {
+      it = cache._exported.emplace( id_r, export_r() ).first;
+    }
+    return it->second;
+  }
+
   const std::list<PublicKeyData> &CachedPublicKeyData::getData(const filesystem::Pathname &keyring_r) const
+  { return assertData( keyring_r )._data; }
+
+  CachedPublicKeyData::Cache &CachedPublicKeyData::assertData(const filesystem::Pathname &keyring_r) const
   {
     Cache & cache( _cacheMap[keyring_r] );
     // init new cache entry
     cache.assertCache( keyring_r );
-    return getData( keyring_r, cache );
+    getData( keyring_r, cache );
+    return cache;
   }
 
   const std::list<PublicKeyData> &CachedPublicKeyData::getData(const filesystem::Pathname &keyring_r, Cache &cache_r) const
   {
     if ( cache_r.hasChanged() ) {
-      cache_r._data = KeyManagerCtx::createForOpenPGP( keyring_r ).listKeys();
+      cache_r._data = context( keyring_r ).listKeys();
+      cache_r._lookup.clear();
+      cache_r._exported.clear();
       MIL << "Found keys: " << cache_r._data  << std::endl;
     }
     return cache_r._data;
@@ -280,15 +326,7 @@ namespace zypp
       preloadCachedKeys();
     }
 
-    PublicKeyData ret;
-    for ( const PublicKeyData & key : publicKeyData( keyring ) )
-    {
-      if ( key.providesKey( id ) )
-      {
-        ret = key;
-        break;
-      }
-    }
+    PublicKeyData ret { cachedPublicKeyData.lookup( keyring, id ) };
     DBG << (ret ? "Found" : "No") << " key [" << id << "] in keyring " << keyring << endl;
     return ret;
   }
@@ -366,18 +404,20 @@ namespace zypp
 
   void KeyRing::Impl::dumpPublicKey( const std::string & id, const Pathname & keyring, std::ostream & stream )
   {
-    KeyManagerCtx::createForOpenPGP( keyring ).exportKey(id, stream);
+    cachedPublicKeyData.context( keyring ).exportKey(id, stream);
   }
 
   filesystem::TmpFile KeyRing::Impl::dumpPublicKeyToTmp( const std::string & id, const Pathname & keyring )
   {
-    filesystem::TmpFile tmpFile( _base_dir, "pubkey-"+id+"-" );
-    MIL << "Going to export key [" << id << "] from " << keyring << " to " << tmpFile.path() << endl;
-
-    std::ofstream os( tmpFile.path().c_str() );
-    dumpPublicKey( id, keyring, os );
-    os.close();
-    return tmpFile;
+    return cachedPublicKeyData.exported( keyring, id, [&]() {
+      filesystem::TmpFile tmpFile( _base_dir, "pubkey-"+id+"-" );
+      MIL << "Going to export key [" << id << "] from " << keyring << " to " << tmpFile.path() << endl;
+
+      std::ofstream os( tmpFile.path().c_str() );
+      dumpPublicKey( id, keyring, os );
+      os.close();
+      return tmpFile;
+    });
   }
 
   std::list<PublicKey> KeyRing::Impl::publicKeys( const Pathname & keyring )
@@ -421,7 +461,9 @@ namespace zypp
 
     MIL << "Determining key id of signature " << signature << endl;
 
-    std::list<std::string> fprs = KeyManagerCtx::createForOpenPGP().readSignatureFingerprints( signature );
+    if ( not _volatileCtx )
+      _volatileCtx = KeyManagerCtx::createForOpenPGP();
+    std::list<std::string> fprs = _volatileCtx->readSignatureFingerprints( signature );
     if ( ! fprs.empty() ) {
       std::string &id = fprs.back();
       MIL << "Determined key id [" << id << "] for signature " << signature << endl;
@@ -432,7 +474,11 @@ namespace zypp
 
   bool KeyRing::Impl::verifyFile( const Pathname & file, const Pathname & signature, const Pathname & keyring )
   {
-    return KeyManagerCtx::createForOpenPGP( keyring ).verify( file, signature );
+    const auto start = std::chrono::steady_clock::now();
+    bool ret = cachedPublicKeyData.context( keyring ).verify( file, signature );
+    const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>( std::chrono::steady_clock::now() - start );
+    MIL << "Verified " << file << " (" << (ret ? "good" : "bad") << ") in " << elapsed.count() << "ms" << endl;
+    return ret;
   }
 
   ///////////////////////////////////////////////////////////////////
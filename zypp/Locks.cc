@@ -8,6 +8,8 @@
 \---------------------------------------------------------------------*/
 
 #include <set>
+#include <optional>
+#include <vector>
 #include <fstream>
 #include <algorithm>
 
@@ -22,6 +24,7 @@
 #include <zypp/sat/SolvAttr.h>
 #include <zypp/sat/Solvable.h>
 #include <zypp/PathInfo.h>
+#include <zypp/pool/LockMatcher.h>
 
 #undef ZYPP_BASE_LOGGER_LOGGROUP
 #define ZYPP_BASE_LOGGER_LOGGROUP "locks"
@@ -77,7 +80,15 @@ public:
   { return _locks; }
 
   LockSet & MANIPlocks()
-  { if ( !_APIdirty ) _APIdirty = true; return _locks; }
+  { if ( !_APIdirty ) _APIdirty = true; _matcher.reset(); return _locks; }
+
+  /** The stable locks compiled into a single matcher. */
+  const pool::LockMatcher & matcher() const
+  {
+    if ( !_matcher )
+      _matcher = pool::LockMatcher( _locks.begin(), _locks.end() );
+    return *_matcher;
+  }
 
   const LockList & APIlocks() const
   {
@@ -95,6 +106,7 @@ private:
   LockSet _locks;
   mutable LockList _APIlocks;
   mutable bool _APIdirty;
+  mutable std::optional<pool::LockMatcher> _matcher;
 };
 
 Locks::Locks() : _pimpl(new Impl){}
@@ -111,38 +123,22 @@ Locks::LockList::size_type Locks::size() const
 bool Locks::empty() const
 { return _pimpl->locks().empty(); }
 
-struct ApplyLock
+namespace
 {
-  void operator()(const PoolQuery& query) const
+  /** Lock all solvables matched by \a matcher_r (restricted to \a candidates_r if not empty). */
+  void applyLocks( const pool::LockMatcher & matcher_r, const std::vector<sat::Solvable> & candidates_r = std::vector<sat::Solvable>() )
   {
-    for ( const PoolItem & item : query.poolItem() )
+    if ( matcher_r.empty() )
+      return;
+    DBG << "apply " << matcher_r << endl;
+    const PoolQueryResult locked { candidates_r.empty() ? matcher_r.match() : matcher_r.match( candidates_r ) };
+    for ( const PoolItem & item : locked.poolItem() )
     {
       item.status().setLock(true,ResStatus::USER);
       DBG << "lock "<< item.name();
     }
   }
-};
-
-/**
- * iterator that takes lock, lock all solvables from query
- * and send query to output iterator
- */
-template <class OutputIterator>
-struct LockingOutputIterator
-{
-  LockingOutputIterator(OutputIterator& out_)
-    : out(out_)
-    {}
-
-  void operator()(const PoolQuery& query) const
-  {
-    ApplyLock a;a(query);
-    *out++ = query;
-  }
-
-  private:
-  OutputIterator& out;
-};
+}
 
 void Locks::readAndApply( const Pathname& file )
 {
@@ -150,9 +146,11 @@ void Locks::readAndApply( const Pathname& file )
   PathInfo pinfo(file);
   if ( pinfo.isExist() )
   {
-    std::insert_iterator<LockSet> ii( _pimpl->MANIPlocks(), _pimpl->MANIPlocks().end() );
-    LockingOutputIterator<std::insert_iterator<LockSet> > lout(ii);
-    readPoolQueriesFromFile( file, boost::make_function_output_iterator(lout) );
+    // apply just the locks read (and all of them at once)
+    LockSet newLocks;
+    readPoolQueriesFromFile( file, std::insert_iterator<LockSet>( newLocks, newLocks.end() ) );
+    applyLocks( pool::LockMatcher( newLocks.begin(), newLocks.end() ) );
+    _pimpl->MANIPlocks().insert( newLocks.begin(), newLocks.end() );
   }
   else
     MIL << "file does not exist(or cannot be stat), no lock added." << endl;
@@ -173,7 +171,15 @@ void Locks::read( const Pathname& file )
 void Locks::apply() const
 {
   DBG << "apply locks" << endl;
-  for_each(_pimpl->locks().begin(), _pimpl->locks().end(), ApplyLock());
+  applyLocks( _pimpl->matcher() );
+}
+
+void Locks::apply( const Repository & repo_r ) const
+{
+  DBG << "apply locks to " << repo_r << endl;
+  const std::vector<sat::Solvable> candidates( repo_r.solvablesBegin(), repo_r.solvablesEnd() );
+  if ( ! candidates.empty() )
+    applyLocks( _pimpl->matcher(), candidates );
 }
 
 
@@ -4,6 +4,7 @@
 #include <zypp/ResPool.h>
 #include <zypp/Pathname.h>
 #include <zypp/PoolQuery.h>
+#include <zypp/Repository.h>
 #include <zypp/ZConfig.h>
 
 namespace zypp
@@ -104,9 +105,18 @@ namespace zypp
 
     /**
      * Applies locks in stable list (locks which is not changed during session).
+     * The locks are compiled into a single matcher, so the pool is
+     * scanned once for all plain name locks.
      */
     void apply() const;
 
+    /**
+     * Applies locks in stable list to the solvables of \a repo_r only.
+     * Use it after a repo was added to the pool, instead of re-applying
+     * all locks to the whole pool.
+     */
+    void apply( const Repository & repo_r ) const;
+
     /**
      * Merges toAdd and ToRemove list to stable list and
      * save that stable list to file.
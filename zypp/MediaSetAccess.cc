@@ -167,6 +167,39 @@ IMPL_PTR_TYPE(MediaSetAccess);
     return op.result;
   }
 
+  std::vector<Pathname> MediaSetAccess::provideFiles( const std::vector<OnMediaLocation> & resources, ProvideFileOptions options )
+  {
+    // Let a network media download the files concurrently first. This is just
+    // a hint: files failing here are downloaded again by provideFile, which
+    // does the reporting and the error handling for each file.
+    std::vector<OnMediaLocation> precache;
+    for ( const auto & resource : resources ) {
+      if ( ! resource.optional() )
+        precache.push_back( resource );
+    }
+    try
+    {
+      for ( const auto & resource : precache )
+        getMediaAccessId( resource.medianr() ); // precacheFiles skips media not open
+      precacheFiles( precache );
+    }
+    catch ( const Exception & excpt_r )
+    {
+      ZYPP_CAUGHT( excpt_r );
+      MIL << "Precaching " << precache.size() << " files failed, providing them one by one" << endl;
+    }
+
+    std::vector<Pathname> ret;
+    ret.reserve( resources.size() );
+    for ( const auto & resource : resources ) {
+      if ( resource.optional() )
+        ret.push_back( provideOptionalFile( resource.filename(), resource.medianr() ) );
+      else
+        ret.push_back( provideFile( resource, options ) );
+    }
+    return ret;
+  }
+
   Pathname MediaSetAccess::provideFile( const OnMediaLocation & resource, ProvideFileOptions options, const Pathname &deltafile )
   {
     return provideFile( OnMediaLocation( resource ).setDeltafile( deltafile ), options );
@@ -237,19 +270,23 @@ IMPL_PTR_TYPE(MediaSetAccess);
   {
     media::MediaManager media_mgr;
 
+    std::map<media::MediaNr, std::vector<OnMediaLocation>> byMedia;
     for ( const auto &resource : files ) {
-           unsigned media_nr(resource.medianr());
+      byMedia[resource.medianr()].push_back( resource );
+    }
+
+    for ( const auto &[ media_nr, resources ] : byMedia ) {
       media::MediaAccessId media = getMediaAccessId( media_nr );
 
       if ( !media_mgr.isOpen( media ) ) {
-        MIL << "Skipping precache of file " << resource.filename() << " media is not open";
+        MIL << "Skipping precache of " << resources.size() << " files, media " << media_nr << " is not open" << endl;
         continue;
       }
 
       if ( ! media_mgr.isAttached(media) )
         media_mgr.attach(media);
 
-      media_mgr.precacheFiles( media, { resource } );
+      media_mgr.precacheFiles( media, resources );
     }
   }
 
@@ -111,6 +111,12 @@ namespace zypp
       void setLabel( const std::string & label_r )
       { _label = label_r; }
 
+      /**
+       * The media (set) url passed to the ctor.
+       */
+      const Url & url() const
+      { return _url; }
+
       enum ProvideFileOption
       {
         /**
@@ -124,11 +130,15 @@ namespace zypp
       /**
          * Tries to fetch the given files and precaches them. Those files
          * need to be queried using provideFile and can be read from the cache directly.
-         * The implementation is not allowed to block but needs to use seperate means to
-         * download the files concurrently.
+         * Files are passed to the media handler grouped by media number, so a
+         * network handler is able to download them concurrently. Files located
+         * on a media which is not open are skipped.
          * A backend can choose to completely ignore this functionaly, the default implementation
          * does nothing.
          *
+         * \note Failing to precache a file is not an error. The file is simply
+         * downloaded again when it is requested via provideFile.
+         *
          * \param files List of files that should be precached
          */
       void precacheFiles(const std::vector<OnMediaLocation> &files);
@@ -162,6 +172,25 @@ namespace zypp
        */
       Pathname provideFile( const OnMediaLocation & resource, ProvideFileOptions options = PROVIDE_DEFAULT );
 
+      /**
+       * Provides several files from media locations.
+       *
+       * Like calling \ref provideFile for each resource, but the files are passed
+       * to \ref precacheFiles first, so a network media is able to download them
+       * concurrently.
+       *
+       * \param resources locations of the files on media
+       * \return local pathnames of the requested files (in the order of \a resources)
+       *
+       * \note Each file is then provided by \ref provideFile, so errors, media
+       * changes and skipping are handled per file. Optional resources are not
+       * precached, an empty \ref Pathname is returned for those not present
+       * on the media.
+       *
+       * \throws MediaException, SkipRequestException like \ref provideFile
+       */
+      std::vector<Pathname> provideFiles( const std::vector<OnMediaLocation> & resources, ProvideFileOptions options = PROVIDE_DEFAULT );
+
       /**
        * \deprecated The deltafile argument is part of the OnMediaLocation now, use the version of \ref provideFile( const OnMediaLocation & resource, ProvideFileOptions options )
        */
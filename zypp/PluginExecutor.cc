@@ -9,7 +9,12 @@
 /** \file	zypp/PluginExecutor.cc
  */
 #include <iostream>
+#include <algorithm>
+#include <climits>
+#include <glib.h>
+
 #include <zypp/base/LogTools.h>
+#include <zypp/base/Errno.h>
 #include <zypp/base/NonCopyable.h>
 
 #include <zypp/ZConfig.h>
@@ -24,12 +29,40 @@ using std::endl;
 ///////////////////////////////////////////////////////////////////
 namespace zypp
 {
+  namespace
+  {
+    using Clock = std::chrono::steady_clock;
+
+    inline void record( PluginExecutor::Latency & latency_r, Clock::duration elapsed_r )
+    {
+      auto elapsed { std::chrono::duration_cast<std::chrono::microseconds>( elapsed_r ) };
+      ++latency_r.frames;
+      latency_r.total += elapsed;
+      if ( elapsed > latency_r.max )
+        latency_r.max = elapsed;
+    }
+  }
+
   ///////////////////////////////////////////////////////////////////
   /// \class PluginExecutor::Impl
   /// \brief PluginExecutor implementation.
   ///////////////////////////////////////////////////////////////////
   class PluginExecutor::Impl : private base::NonCopyable
   {
+    /** An open plugin and where to record its response times. */
+    struct Plugin
+    {
+      PluginScript script;
+      Latency * latency;
+    };
+
+    /** A plugin a response is expected from. */
+    struct Pending
+    {
+      Plugin * plugin;
+      Clock::time_point sent;
+    };
+
   public:
     Impl()
     {}
@@ -43,6 +76,13 @@ namespace zypp
       if ( ! empty() )
         send( PluginFrame( "PLUGINEND" ) );
       // ~PluginScript will disconnect all remaining plugins!
+
+      for ( const Latency & latency : _latencies )
+      {
+        if ( latency.frames )
+          MIL << "Plugin " << latency.script << " answered " << latency.frames << " frames: avg "
+              << ( latency.total / latency.frames ).count() << "us, max " << latency.max.count() << "us" << endl;
+      }
     }
 
     bool empty() const
@@ -87,10 +127,21 @@ namespace zypp
     void send( const PluginFrame & frame_r )
     {
       DBG << "+++++++++++++++ send " << frame_r << endl;
+      // Send the frame to all plugins first, so they process it concurrently...
+      std::vector<Pending> pending;
+      pending.reserve( _scripts.size() );
+      for ( Plugin & plugin : _scripts )
+      {
+        Clock::time_point sent { Clock::now() };
+        if ( doSendFrame( plugin.script, frame_r ) )
+          pending.push_back( Pending{ &plugin, sent } );
+      }
+      // ...then collect the responses in the order they arrive.
+      receiveAll( pending, frame_r );
+
       for ( auto it = _scripts.begin(); it != _scripts.end(); )
       {
-        doSend( *it, frame_r );
-        if ( it->isOpen() )
+        if ( it->script.isOpen() )
           ++it;
         else
           it = _scripts.erase( it );
@@ -98,8 +149,16 @@ namespace zypp
       DBG << "--------------- send " << frame_r << endl;
     }
 
+    std::vector<Latency> latencies() const
+    { return std::vector<Latency>( _latencies.begin(), _latencies.end() ); }
+
     const std::list<PluginScript> scripts() const
-    { return _scripts; }
+    {
+      std::list<PluginScript> ret;
+      for ( const Plugin & plugin : _scripts )
+        ret.push_back( plugin.script );
+      return ret;
+    }
 
   private:
     /** Launch a plugin sending PLUGINSTART message. */
@@ -114,9 +173,16 @@ namespace zypp
         if ( ZConfig::instance().hasUserData() )
           frame.setHeader( "userdata", ZConfig::instance().userData() );
 
-        doSend( plugin, frame );	// closes on error
+        _latencies.push_back( Latency{ pi_r.path() } );
+        Plugin loaded { plugin, &_latencies.back() };
+        Clock::time_point sent { Clock::now() };
+        if ( doSendFrame( plugin, frame ) )	// closes on error
+        {
+          std::vector<Pending> pending { Pending{ &loaded, sent } };
+          receiveAll( pending, frame );
+        }
         if ( plugin.isOpen() )
-          _scripts.push_back( plugin );
+          _scripts.push_back( loaded );
       }
       catch( const zypp::Exception & e )
       {
@@ -124,32 +190,108 @@ namespace zypp
       }
     }
 
-    PluginFrame doSend( PluginScript & script_r, const PluginFrame & frame_r )
+    /** Wait for the \a pending_r plugins to answer \a frame_r.
+     * Plugins not answering completely within their receive timeout are closed.
+     */
+    void receiveAll( std::vector<Pending> & pending_r, const PluginFrame & frame_r )
     {
-      PluginFrame ret;
+      std::vector<GPollFD> fds;
+      while ( true )
+      {
+        // Read whatever is available. This also picks up data already
+        // buffered by the scripts input FILE, which poll does not see.
+        Clock::time_point now { Clock::now() };
+        for ( size_t i = pending_r.size(); i--; )
+        {
+          bool done = doReceiveFrame( pending_r[i], frame_r );
+          if ( ! done && now >= deadline( pending_r[i] ) )
+          {
+            PluginScript & script { pending_r[i].plugin->script };
+            WAR << "Not ready to read within timeout: " << script << endl;
+            script.close();
+            done = true;
+          }
+          if ( done )
+            pending_r.erase( pending_r.begin() + i );
+        }
+        if ( pending_r.empty() )
+          break;
 
+        Clock::duration wait { Clock::duration::max() };
+        fds.clear();
+        for ( const Pending & pending : pending_r )
+        {
+          fds.push_back( GPollFD{ pending.plugin->script.receiveFd(), G_IO_IN | G_IO_HUP | G_IO_ERR, 0 } );
+          wait = std::min( wait, std::max( deadline( pending ) - now, Clock::duration::zero() ) );
+        }
+
+        int timeout = std::min<long long>( std::chrono::ceil<std::chrono::milliseconds>( wait ).count(), INT_MAX );
+        if ( g_poll( fds.data(), fds.size(), timeout ) == -1 && errno != EINTR )
+        {
+          ERR << "poll(): " << Errno() << endl;
+          for ( const Pending & pending : pending_r )
+            pending.plugin->script.close();
+          break;
+        }
+      }
+    }
+
+    Clock::time_point deadline( const Pending & pending_r ) const
+    { return pending_r.sent + std::chrono::seconds( pending_r.plugin->script.receiveTimeout() ); }
+
+    /** Send \a frame_r, closing the plugin on error. */
+    bool doSendFrame( PluginScript & script_r, const PluginFrame & frame_r )
+    {
       try {
         script_r.send( frame_r );
-        ret = script_r.receive();
+        return true;
       }
       catch( const zypp::Exception & e )
       {
         ZYPP_CAUGHT(e);
         WAR << e.asUserHistory() << endl;
       }
+      checkResponse( script_r, frame_r, PluginFrame() );
+      return false;
+    }
 
+    /** Receive the response to \a frame_r if it is complete, closing the plugin on error.
+     * Returns whether the plugin is done with \a frame_r.
+     */
+    bool doReceiveFrame( const Pending & pending_r, const PluginFrame & frame_r )
+    {
+      PluginScript & script { pending_r.plugin->script };
+      PluginFrame ret;
+
+      try {
+        if ( ! script.tryReceive( ret ) )
+          return false;
+        record( *pending_r.plugin->latency, Clock::now() - pending_r.sent );
+      }
+      catch( const zypp::Exception & e )
+      {
+        ZYPP_CAUGHT(e);
+        WAR << e.asUserHistory() << endl;
+      }
+
+      checkResponse( script, frame_r, ret );
+      return true;
+    }
+
+    void checkResponse( PluginScript & script_r, const PluginFrame & frame_r, const PluginFrame & ret_r )
+    {
       // Allow using "/bin/cat" as reflector-script for testing
-      if ( ! ( ret.isAckCommand() || ret.isEnomethodCommand() || ( script_r.script() == "/bin/cat" && frame_r.command() != "ERROR" ) ) )
+      if ( ! ( ret_r.isAckCommand() || ret_r.isEnomethodCommand() || ( script_r.script() == "/bin/cat" && frame_r.command() != "ERROR" ) ) )
       {
-        WAR << "Bad plugin response from " << script_r << ": " << ret << endl;
+        WAR << "Bad plugin response from " << script_r << ": " << ret_r << endl;
         WAR << "(Expected " << PluginFrame::ackCommand() << " or " << PluginFrame::enomethodCommand() << ")" << endl;
         script_r.close();
       }
-
-      return ret;
     }
+
   private:
-    std::list<PluginScript> _scripts;
+    std::list<Plugin> _scripts;
+    std::list<Latency> _latencies;
   };
 
   ///////////////////////////////////////////////////////////////////
@@ -177,6 +319,9 @@ namespace zypp
   void PluginExecutor::send( const PluginFrame & frame_r )
   { _pimpl->send( frame_r ); }
 
+  std::vector<PluginExecutor::Latency> PluginExecutor::latencies() const
+  { return _pimpl->latencies(); }
+
   std::ostream & operator<<( std::ostream & str, const PluginExecutor & obj )
   { return str << obj._pimpl->scripts(); }
 
@@ -12,6 +12,8 @@
 #define ZYPP_PLUGINEXECUTOR_H
 
 #include <iosfwd>
+#include <chrono>
+#include <vector>
 
 #include <zypp/base/PtrTypes.h>
 #include <zypp/PluginScript.h>
@@ -25,7 +27,9 @@ namespace zypp
   ///
   /// Sent PluginFrames are distributed to all open PluginScripts and
   /// need to be receipted by sending back either \c ACK or \c _ENOMETHOD
-  /// command.
+  /// command. The frame is sent to all plugins before waiting for the
+  /// responses, so the plugins process it concurrently and a \ref send
+  /// takes about as long as the slowest plugin needs.
   ///
   /// All PluginScripts receive an initial \c PLUGINBEGIN frame, containing
   /// a \c userdata header if \ref ZConfig::userData are defined.
@@ -43,6 +47,16 @@ namespace zypp
     friend std::ostream & operator<<( std::ostream & str, const PluginExecutor & obj );
     friend bool operator==( const PluginExecutor & lhs, const PluginExecutor & rhs );
 
+    public:
+      /** Response times of a plugin. */
+      struct Latency
+      {
+        Pathname script;			///< the plugin
+        unsigned frames = 0;			///< number of frames answered
+        std::chrono::microseconds total {0};	///< sum of the response times
+        std::chrono::microseconds max {0};	///< longest response time
+      };
+
     public:
       /** Default ctor: Empty plugin list */
       PluginExecutor();
@@ -75,6 +89,11 @@ namespace zypp
        */
       void send( const PluginFrame & frame_r );
 
+      /** Response times of all plugins loaded so far (also the closed ones).
+       * They are also logged when the executor is destroyed.
+       */
+      std::vector<Latency> latencies() const;
+
     public:
       class Impl;		///< Implementation class.
     private:
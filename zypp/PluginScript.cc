@@ -162,6 +162,9 @@ namespace zypp
       bool isOpen() const
       { return _cmd != nullptr; }
 
+      int receiveFd() const
+      { return _cmd && _cmd->inputFile() ? ::fileno( _cmd->inputFile() ) : -1; }
+
       int lastReturn() const
       { return _lastReturn; }
 
@@ -177,12 +180,15 @@ namespace zypp
 
       PluginFrame receive() const;
 
+      bool tryReceive( PluginFrame & frame_r ) const;
+
     private:
       Pathname _script;
       Arguments _args;
       scoped_ptr<ExternalProgramWithStderr> _cmd;
       DefaultIntegral<int,0> _lastReturn;
       std::string _lastExecError;
+      mutable std::string _receiveBuffer;	///< a partially received frame
   };
   ///////////////////////////////////////////////////////////////////
 
@@ -247,6 +253,7 @@ namespace zypp
     if ( _cmd )
     {
       DBG << "Close:" << *this << endl;
+      _receiveBuffer.clear();	// drop an incomplete answer
       bool doKill = true;
       try {
         // do not kill script if _DISCONNECT is ACKed.
@@ -366,6 +373,32 @@ namespace zypp
   }
 
   PluginFrame PluginScript::Impl::receive() const
+  {
+    PluginFrame ret;
+    while ( ! tryReceive( ret ) )
+    {
+      // wait a while for fd to become ready for reading...
+      GPollFD rfd;
+      rfd.fd = receiveFd();
+      rfd.events =  G_IO_IN | G_IO_HUP | G_IO_ERR;
+      rfd.revents = 0;
+
+      int retval = g_poll( &rfd, 1, _receiveTimeout * 1000 );
+      if ( retval == 0 )
+      {
+        WAR << "Not ready to read within timeout." << endl;
+        ZYPP_THROW( PluginScriptReceiveTimeout( "Not ready to read within timeout." ) );
+      }
+      else if ( retval == -1 && errno != EINTR )
+      {
+        ERR << "select(): " << Errno() << endl;
+        ZYPP_THROW( PluginScriptException( "Error waiting on file descriptor", str::Str() << Errno() ) );
+      }
+    }
+    return ret;
+  }
+
+  bool PluginScript::Impl::tryReceive( PluginFrame & frame_r ) const
   {
     if ( !_cmd )
       ZYPP_THROW( PluginScriptNotConnected( "Not connected", str::Str() << *this ) );
@@ -375,20 +408,14 @@ namespace zypp
     if ( ! filep )
       ZYPP_THROW( PluginScriptException( "Bad file pointer." ) );
 
-    int fd = ::fileno( filep );
-    if ( fd == -1 )
-      ZYPP_THROW( PluginScriptException( "Bad file descriptor" ) );
-
     ::clearerr( filep );
-    std::string data;
     {
-      PluginDebugBuffer _debug( data ); // dump receive buffer if PLUGIN_DEBUG
       PluginDumpStderr _dump( *_cmd ); // dump scripts stderr before leaving
       do {
         int ch = fgetc( filep );
         if ( ch != EOF )
         {
-          data.push_back( ch );
+          _receiveBuffer.push_back( ch );
           if ( ch == '\0' )
             break;
         }
@@ -397,48 +424,29 @@ namespace zypp
           WAR << "Unexpected EOF" << endl;
           ZYPP_THROW( PluginScriptDiedUnexpectedly( "Receive: script died unexpectedly", str::Str() << Errno() ) );
         }
+        else if ( errno == EWOULDBLOCK )
+        {
+          // the frame is not yet complete, keep what we have
+          return false;
+        }
         else if ( errno != EINTR )
         {
-          if ( errno == EWOULDBLOCK )
-          {
-            // wait a while for fd to become ready for reading...
-            GPollFD rfd;
-            rfd.fd = fd;
-            rfd.events =  G_IO_IN | G_IO_HUP | G_IO_ERR;
-            rfd.revents = 0;
-
-            int retval = g_poll( &rfd, 1, _receiveTimeout * 1000 );
-            if ( retval > 0 )	// rfd.revents was filled
-            {
-              ::clearerr( filep );
-            }
-            else if ( retval == 0 )
-            {
-              WAR << "Not ready to read within timeout." << endl;
-              ZYPP_THROW( PluginScriptReceiveTimeout( "Not ready to read within timeout." ) );
-            }
-            else // ( retval == -1 )
-            {
-              if ( errno != EINTR )
-              {
-                ERR << "select(): " << Errno() << endl;
-                ZYPP_THROW( PluginScriptException( "Error waiting on file descriptor", str::Str() << Errno() ) );
-              }
-            }
-          }
-          else
-          {
-            ERR << "read(): " << Errno() << endl;
-            ZYPP_THROW( PluginScriptException( "Receive: receive error", str::Str() << Errno() ) );
-          }
+          ERR << "read(): " << Errno() << endl;
+          ZYPP_THROW( PluginScriptException( "Receive: receive error", str::Str() << Errno() ) );
         }
       } while ( true );
     }
+
+    std::string data;
+    data.swap( _receiveBuffer );
+    {
+      PluginDebugBuffer _debug( data ); // dump receive buffer if PLUGIN_DEBUG
+    }
     // DBG << " <-read " << data.size() << endl;
     std::istringstream datas( data );
-    PluginFrame ret( datas );
-    DBG << *this << " <-" << ret << endl;
-    return ret;
+    frame_r = PluginFrame( datas );
+    DBG << *this << " <-" << frame_r << endl;
+    return true;
   }
 
   ///////////////////////////////////////////////////////////////////
@@ -497,6 +505,9 @@ namespace zypp
   pid_t PluginScript::getPid() const
   { return _pimpl->getPid(); }
 
+  int PluginScript::receiveFd() const
+  { return _pimpl->receiveFd(); }
+
   int PluginScript::lastReturn() const
   { return _pimpl->lastReturn(); }
 
@@ -521,6 +532,9 @@ namespace zypp
   PluginFrame PluginScript::receive() const
   { return _pimpl->receive(); }
 
+  bool PluginScript::tryReceive( PluginFrame & frame_r ) const
+  { return _pimpl->tryReceive( frame_r ); }
+
   ///////////////////////////////////////////////////////////////////
 
   std::ostream & operator<<( std::ostream & str, const PluginScript & obj )
@@ -117,6 +117,11 @@ namespace zypp
       /** Return a connected scripts pid or \ref NotConnected. */
       pid_t getPid() const;
 
+      /** The file descriptor a response is received from, \c -1 if not connected.
+       * Allows waiting for multiple scripts at once (\see \ref PluginExecutor).
+       */
+      int receiveFd() const;
+
       /** Remembers a scripts return value after \ref close until next \ref open. */
       int lastReturn() const;
 
@@ -180,6 +185,15 @@ namespace zypp
        */
       PluginFrame receive() const;
 
+      /** Receive a \ref PluginFrame if the script sent it completely, without waiting.
+       * Returns \c true and the frame in \a frame_r once its last byte was read.
+       * Otherwise the data read so far are kept for the next call (\see \ref PluginExecutor).
+       * \throw PluginScriptNotConnected
+       * \throw PluginScriptDiedUnexpectedly (does not \ref close)
+       * \throw PluginScriptException on error
+       */
+      bool tryReceive( PluginFrame & frame_r ) const;
+
     public:
       /** Implementation. */
       struct Impl;
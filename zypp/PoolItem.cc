@@ -16,6 +16,7 @@
 
 #include <zypp/PoolItem.h>
 #include <zypp/ResPool.h>
+#include <zypp/pool/PoolImpl.h>
 #include <zypp/Package.h>
 #include <zypp/VendorAttr.h>
 
@@ -221,9 +222,32 @@ namespace zypp
   bool PoolItem::isNeeded() const			{ return _pimpl->isNeeded(); }
   bool PoolItem::isUnwanted() const			{ return _pimpl->isUnwanted(); }
 
-  void PoolItem::saveState() const			{ _pimpl->saveState(); }
-  void PoolItem::restoreState() const			{ _pimpl->restoreState(); }
-  bool PoolItem::sameState() const			{ return _pimpl->sameState(); }
+  // Items in the pool use the pools snapshot, like ResPoolProxy does.
+  // Only detached items keep their own saved state.
+  void PoolItem::saveState() const
+  {
+    const pool::PoolImpl & poolImpl { *ResPool::instance()._pimpl };
+    if ( poolImpl.contains( *this ) )
+      poolImpl.SaveState( *this );
+    else
+      _pimpl->saveState();
+  }
+
+  void PoolItem::restoreState() const
+  {
+    const pool::PoolImpl & poolImpl { *ResPool::instance()._pimpl };
+    if ( poolImpl.contains( *this ) )
+      poolImpl.RestoreState( *this );
+    else
+      _pimpl->restoreState();
+  }
+
+  bool PoolItem::sameState() const
+  {
+    const pool::PoolImpl & poolImpl { *ResPool::instance()._pimpl };
+    return poolImpl.contains( *this ) ? poolImpl.SameState( *this ) : _pimpl->sameState();
+  }
+
   ResObject::constPtr PoolItem::resolvable() const	{ return _pimpl->resolvable(); }
 
 
@@ -23,6 +23,7 @@
 #include <zypp/PublicKey.h>
 #include <zypp/MediaSetAccess.h>
 #include <zypp/RepoInfo.h>
+#include <zypp/IdString.h>
 #include <zypp/Glob.h>
 #include <zypp/TriBool.h>
 #include <zypp/Pathname.h>
@@ -329,8 +330,8 @@ namespace zypp
     RepoVariablesReplacedUrl _mirrorListUrl;
     bool                     _mirrorListForceMetalink;
     Pathname path;
-    std::string service;
-    std::string targetDistro;
+    IdString service;		///< interned, shared by all repos of a service
+    IdString targetDistro;
 
     void metadataPath( Pathname new_r )
     { _metadataPath = std::move( new_r ); }
@@ -582,10 +583,10 @@ namespace zypp
   { _pimpl->keeppackages = keep; }
 
   void RepoInfo::setService( const std::string& name )
-  { _pimpl->service = name; }
+  { _pimpl->service = name.empty() ? IdString() : IdString( name ); }
 
   void RepoInfo::setTargetDistribution( const std::string & targetDistribution )
-  { _pimpl->targetDistro = targetDistribution; }
+  { _pimpl->targetDistro = targetDistribution.empty() ? IdString() : IdString( targetDistribution ); }
 
   bool RepoInfo::keepPackages() const
   { return indeterminate(_pimpl->keeppackages) ? false : (bool)_pimpl->keeppackages; }
@@ -636,10 +637,10 @@ namespace zypp
   { return _pimpl->path; }
 
   std::string RepoInfo::service() const
-  { return _pimpl->service; }
+  { return _pimpl->service.asString(); }
 
   std::string RepoInfo::targetDistribution() const
-  { return _pimpl->targetDistro; }
+  { return _pimpl->targetDistro.asString(); }
 
   Url RepoInfo::rawUrl() const
   { return( _pimpl->baseUrls().empty() ? Url() : *_pimpl->baseUrls().rawBegin() ); }
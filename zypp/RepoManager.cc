@@ -42,6 +42,7 @@
 #include <zypp/ManagedFile.h>
 
 #include <zypp/parser/xml/Reader.h>
+#include <zypp/parser/IniFileCache.h>
 #include <zypp/repo/ServiceRepos.h>
 #include <zypp/repo/PluginServices.h>
 #include <zypp/repo/PluginRepoverification.h>
@@ -51,6 +52,8 @@
 #include <zypp/HistoryLog.h> // to write history :O)
 
 #include <zypp/ZYppCallbacks.h>
+#include <zypp/KeyRing.h>
+#include <zypp/KeyContext.h>
 
 #include "sat/Pool.h"
 #include "zypp-media/ng/providespec.h"
@@ -62,6 +65,12 @@
 #include <zypp/ng/workflows/contextfacade.h>
 #include <zypp/ng/repo/refresh.h>
 #include <zypp/ng/repo/workflows/repomanagerwf.h>
+#include <zypp/ng/Context>
+#include <zypp/ng/userrequest.h>
+#include <zypp-core/zyppng/pipelines/Wait>
+#include <zypp-core/zyppng/pipelines/Algorithm>
+#include <zypp-core/zyppng/ui/ProgressObserver>
+#include <zypp-media/ng/Provide>
 
 
 using std::endl;
@@ -73,6 +82,10 @@ using namespace zypp::repo;
 ///////////////////////////////////////////////////////////////////
 namespace zypp
 {
+  namespace zypp_readonly_hack {
+    bool IGotIt(); // in readonly-mode
+  }
+
   ///////////////////////////////////////////////////////////////////
   namespace env
   {
@@ -189,8 +202,14 @@ namespace zypp
       : RepoManagerBaseImpl(std::move(opt)),
         _pluginRepoverification(_options.pluginsPath / "repoverification",
                                 _options.rootDir) {
-      init_knownServices();
-      init_knownRepositories();
+      // The parsed .repo and .service files are cached, so they are
+      // parsed again only if changed. Read-only mode must not write it.
+      parser::IniFileCache cache( _options.repoCachePath / "repofiles.cache" );
+      init_knownServices( &cache );
+      init_knownRepositories( &cache );
+      if ( ! zypp_readonly_hack::IGotIt() )
+        cache.save();
+      MIL << cache << endl;
     }
 
     Impl(const Impl &) = default;
@@ -247,6 +266,15 @@ namespace zypp
 
     void refreshMetadata( const RepoInfo & info, RawMetadataRefreshPolicy policy, OPT_PROGRESS );
 
+    RefreshMetadataErrors refreshMetadata( const RepoInfoList & infos, RawMetadataRefreshPolicy policy, OPT_PROGRESS );
+
+  private:
+    /** Refresh \a info trying its baseurls one by one (the body shared by both \ref refreshMetadata). */
+    template <typename ZyppContextRefType>
+    auto refreshMetadataFromUrls( ZyppContextRefType ctx, const RepoInfo & info, RawMetadataRefreshPolicy policy, zyppng::ProgressObserverRef observer );
+
+  public:
+
     void buildCache( const RepoInfo & info, CacheBuildPolicy policy, OPT_PROGRESS );
 
     repo::RepoType probe( const Url & url, const Pathname & path = Pathname() ) const;
@@ -312,32 +340,31 @@ namespace zypp
   }
 
 
-  void RepoManager::Impl::refreshMetadata( const RepoInfo & info, RawMetadataRefreshPolicy policy, const ProgressData::ReceiverFnc & progress )
+  template <typename ZyppContextRefType>
+  auto RepoManager::Impl::refreshMetadataFromUrls( ZyppContextRefType ctx, const RepoInfo & info, RawMetadataRefreshPolicy policy, zyppng::ProgressObserverRef observer )
   {
     using namespace zyppng;
     using namespace zyppng::operators;
     using zyppng::operators::operator|;
 
-    // make sure geoIP data is up 2 date
-    refreshGeoIPData( info.baseUrls() );
-
-    // Suppress (interactive) media::MediaChangeReport if we in have multiple basurls (>1)
-    media::ScopedDisableMediaChangeReport guard( info.baseUrlsSize() > 1 );
+    using RefreshContextType = zyppng::repo::RefreshContext<ZyppContextRefType>;
+    using RefreshContextRefType = zyppng::repo::RefreshContextRef<ZyppContextRefType>;
+    using ResultType = zyppng::expected<RefreshContextRefType>;
+    constexpr bool isAsync = std::is_same_v<ZyppContextRefType, ContextRef>;
+    using MaybeAsyncResult = std::conditional_t<isAsync, AsyncOpRef<ResultType>, ResultType>;
 
     // we will throw this later if no URL checks out fine
-    RepoException rexception( info, PL_("Valid metadata not found at specified URL",
-                                        "Valid metadata not found at specified URLs",
-                                        info.baseUrlsSize() ) );
-
-
-    auto ctx = SyncContext::create();
+    auto rexception = std::make_shared<RepoException>( info, PL_("Valid metadata not found at specified URL",
+                                                                 "Valid metadata not found at specified URLs",
+                                                                 info.baseUrlsSize() ) );
+    auto tried = std::make_shared<unsigned>( 0 );
 
     // helper callback in case the repo type changes on the remote
-    const auto &updateProbedType = [&]( repo::RepoType repokind ) {
+    const auto &updateProbedType = [this, alias = info.alias()]( zypp::repo::RepoType repokind ) {
       // update probed type only for repos in system
       for_( it, repoBegin(), repoEnd() )
       {
-        if ( info.alias() == (*it).alias() )
+        if ( alias == (*it).alias() )
         {
           RepoInfo modifiedrepo = *it;
           modifiedrepo.setType( repokind );
@@ -349,48 +376,207 @@ namespace zypp
     };
 
     // try urls one by one
-    for ( RepoInfo::urls_const_iterator it = info.baseUrlsBegin(); it != info.baseUrlsEnd(); ++it )
+    std::vector<Url> urls( info.baseUrlsBegin(), info.baseUrlsEnd() );
+    return std::move(urls)
+    | firstOf( [this, ctx, info, policy, observer, updateProbedType, rexception, tried]( Url && url ) -> MaybeAsyncResult {
+      return RefreshContextType::create( ctx, info, _options )
+      | and_then( [&]( RefreshContextRefType && refCtx ) -> MaybeAsyncResult {
+        // Hotfix for bsc#1223094: No media access for CD/DVD unless rawchache is missing
+        if ( url.schemeIsVolatile() && not metadataStatus( info ).empty() ) {
+          // we are done.
+          return makeReadyResult<ResultType, isAsync>( make_expected_success( std::move(refCtx) ) );
+        }
+        refCtx->setPolicy( static_cast<zyppng::repo::RawMetadataRefreshPolicy>( policy ) );
+        // in case probe detects a different repokind, update our internal repos
+        refCtx->connectFunc( &RefreshContextType::sigProbedTypeChanged, updateProbedType );
+        return ctx->provider()->attachMedia( url, zyppng::ProvideMediaSpec( info.name() ) )
+        | and_then( [ refCtx, observer ]( auto && mediaHandle ) mutable {
+          return zyppng::RepoManagerWorkflow::refreshMetadata( std::move(refCtx), std::move(mediaHandle), observer );
+        } );
+      } )
+      | [ rexception, tried ]( ResultType && res ) {
+        if ( ! res ) {
+          ERR << "Trying another url..." << endl;
+          try {
+            std::rethrow_exception( res.error() );
+          }
+          catch ( const zypp::Exception & e ) {
+            // remember the exception caught for the *first URL*
+            // if all other URLs fail, the rexception will be thrown with the
+            // cause of the problem of the first URL remembered
+            if ( (*tried)++ == 0 )
+              rexception->remember( e );
+            else
+              rexception->addHistory( e.asUserString() );
+          }
+          catch ( ... ) {
+            ++(*tried);
+          }
+        }
+        return std::move(res);
+      };
+    }, ResultType::error( std::exception_ptr() ), zyppng::detail::ContinueUntilValidPredicate() )
+    | [ this, info, rexception ]( ResultType && res ) {
+      if ( ! res ) {
+        ERR << "No more urls..." << endl;
+        return zyppng::expected<void>::error( ZYPP_EXCPT_PTR( *rexception ) );
+      }
+      if ( ! isTmpRepo( info ) )
+        reposManip();	// remember to trigger appdata refresh
+      return zyppng::expected<void>::success();
+    };
+  }
+
+  void RepoManager::Impl::refreshMetadata( const RepoInfo & info, RawMetadataRefreshPolicy policy, const ProgressData::ReceiverFnc & progress )
+  {
+    // make sure geoIP data is up 2 date
+    refreshGeoIPData( info.baseUrls() );
+
+    // Suppress (interactive) media::MediaChangeReport if we in have multiple basurls (>1)
+    media::ScopedDisableMediaChangeReport guard( info.baseUrlsSize() > 1 );
+
+    zyppng::expected<void> res { refreshMetadataFromUrls( zyppng::SyncContext::create(), info, policy, nullptr ) };
+    if ( ! res ) {
+      ZYPP_RETHROW( res.error() );
+    }
+  }
+
+  ///////////////////////////////////////////////////////////////////
+  namespace
+  {
+    /** Forward the keyring requests of an async zyppng::Context to the legacy \ref KeyRingReport.
+     * This way the concurrent refresh asks the user the same way the serial one does.
+     */
+    void sendKeyRingRequestToReport( const zyppng::UserRequestRef & req_r )
     {
-      // Hotfix for bsc#1223094: No media access for CD/DVD unless rawchache is missing
-      if ( it->schemeIsVolatile() && not metadataStatus( info ).empty() ) {
-        // we are done.
-        return;
+      using namespace zyppng;
+      const callback::UserData & data { req_r->userData() };
+      const ContentType & type { data.type() };
+      callback::SendReport<KeyRingReport> report;
+
+      if ( type == ContentType( AcceptKeyRequest::CTYPE.data() ) )
+      {
+        auto & req { static_cast<TrustKeyRequest &>( *req_r ) };
+        req.setChoice( static_cast<TrustKeyRequest::KeyTrust>( report->askUserToAcceptKey( data.get<PublicKey>( AcceptKeyRequest::KEY.data() ),
+                                                                                           data.get<KeyContext>( AcceptKeyRequest::KEY_CONTEXT.data() ) ) ) );
+      }
+      else if ( type == ContentType( AcceptUnsignedFileRequest::CTYPE.data() ) )
+      {
+        auto & req { static_cast<BooleanChoiceRequest &>( *req_r ) };
+        req.setChoice( report->askUserToAcceptUnsignedFile( data.get<std::string>( AcceptUnsignedFileRequest::FILE.data() ),
+                                                            data.get<KeyContext>( AcceptUnsignedFileRequest::KEY_CONTEXT.data() ) ) );
+      }
+      else if ( type == ContentType( AcceptUnknownKeyRequest::CTYPE.data() ) )
+      {
+        auto & req { static_cast<BooleanChoiceRequest &>( *req_r ) };
+        req.setChoice( report->askUserToAcceptUnknownKey( data.get<std::string>( AcceptUnknownKeyRequest::FILE.data() ),
+                                                          data.get<std::string>( AcceptUnknownKeyRequest::KEYID.data() ),
+                                                          data.get<KeyContext>( AcceptUnknownKeyRequest::KEY_CONTEXT.data() ) ) );
+      }
+      else if ( type == ContentType( AcceptFailedVerificationRequest::CTYPE.data() ) )
+      {
+        auto & req { static_cast<BooleanChoiceRequest &>( *req_r ) };
+        req.setChoice( report->askUserToAcceptVerificationFailed( data.get<std::string>( AcceptFailedVerificationRequest::FILE.data() ),
+                                                                  data.get<PublicKey>( AcceptFailedVerificationRequest::KEY.data() ),
+                                                                  data.get<KeyContext>( AcceptFailedVerificationRequest::KEY_CONTEXT.data() ) ) );
+      }
+      else if ( type == ContentType( VerifyInfoEvent::CTYPE.data() ) )
+      {
+        report->infoVerify( data.get<std::string>( VerifyInfoEvent::FILE.data() ),
+                            data.get<PublicKeyData>( VerifyInfoEvent::KEY_DATA.data() ),
+                            data.get<KeyContext>( VerifyInfoEvent::KEY_CONTEXT.data() ) );
+      }
+      else if ( type == ContentType( KeyAutoImportInfoEvent::CTYPE.data() ) )
+      {
+        report->reportAutoImportKey( *data.get<const std::list<PublicKeyData> *>( KeyAutoImportInfoEvent::KEY_DATA_LIST.data() ),
+                                     data.get<PublicKeyData>( KeyAutoImportInfoEvent::KEY_DATA.data() ),
+                                     data.get<KeyContext>( KeyAutoImportInfoEvent::KEY_CONTEXT.data() ) );
       }
+      else
+      {
+        DBG << "Unhandled user request " << type << endl;
+      }
+    }
+  } // namespace
+  ///////////////////////////////////////////////////////////////////
 
-      try {
-        auto res = zyppng::repo::SyncRefreshContext::create( ctx, info, _options )
-            | and_then( [&]( zyppng::repo::SyncRefreshContextRef refCtx ) {
-              refCtx->setPolicy( static_cast<zyppng::repo::RawMetadataRefreshPolicy>( policy ) );
-              // in case probe detects a different repokind, update our internal repos
-              refCtx->connectFunc( &zyppng::repo::SyncRefreshContext::sigProbedTypeChanged, updateProbedType );
-              return ctx->provider()->attachMedia( *it, zyppng::ProvideMediaSpec() )
-                     | and_then( [ refCtx ]( auto mediaHandle ) mutable { return zyppng::RepoManagerWorkflow::refreshMetadata ( std::move(refCtx), std::move(mediaHandle), nullptr); } );
-        });
+  RepoManager::RefreshMetadataErrors RepoManager::Impl::refreshMetadata( const RepoInfoList & infos, RawMetadataRefreshPolicy policy, const ProgressData::ReceiverFnc & progressrcv )
+  {
+    using namespace zyppng;
+    using namespace zyppng::operators;
+    using zyppng::operators::operator|;
 
-        if ( !res ) {
-          ZYPP_RETHROW( res.error() );
-        }
-        if ( ! isTmpRepo( info ) )
-          reposManip();	// remember to trigger appdata refresh
+    RefreshMetadataErrors ret;
+    std::list<RepoInfo> volatileRepos;	// media access; refreshed one by one
+    std::vector<zyppng::AsyncOpRef<bool>> ops;
 
-        // we are done.
-        return;
+    // make sure geoIP data is up 2 date
+    {
+      RepoInfo::url_set urls;
+      for ( const RepoInfo & info : infos )
+        urls.insert( urls.end(), info.baseUrlsBegin(), info.baseUrlsEnd() );
+      refreshGeoIPData( urls );
+    }
 
-      } catch ( const zypp::Exception &e ) {
-        ERR << "Trying another url..." << endl;
+    auto ctx = zyppng::Context::create();
+    ctx->sigEvent().connect( []( zyppng::UserRequestRef req ) { sendKeyRingRequestToReport( req ); } );
 
-        // remember the exception caught for the *first URL*
-        // if all other URLs fail, the rexception will be thrown with the
-        // cause of the problem of the first URL remembered
-        if (it == info.baseUrlsBegin())
-          rexception.remember( e );
+    bool multipleUrls = false;
+    for ( const RepoInfo & info : infos )
+    {
+      if ( info.url().schemeIsVolatile() )
+      {
+        volatileRepos.push_back( info );
+        continue;
+      }
+      if ( info.baseUrlsSize() > 1 )
+        multipleUrls = true;
+
+      // per repo progress, named after the alias
+      auto tics { std::make_shared<ProgressData>( 100 ) };
+      tics->name( info.alias() );
+      tics->sendTo( progressrcv );
+      tics->toMin();
+      auto observer { zyppng::ProgressObserver::create( info.alias() ) };
+      observer->sigProgressChanged().connect( [tics]( zyppng::ProgressObserver &, double progress ) {
+        tics->set( static_cast<ProgressData::value_type>( progress ) );
+      } );
+
+      auto op = refreshMetadataFromUrls( ctx, info, policy, observer )
+      | [ &ret, tics, alias = info.alias() ]( zyppng::expected<void> && res ) {
+        if ( ! res )
+          ret[alias] = res.error();
         else
-          rexception.addHistory( e.asUserString() );
+          tics->toMax();
+        return res.is_valid();
+      };
+      ops.push_back( std::move(op) );
+    }
+
+    if ( ! ops.empty() )
+    {
+      // Suppress (interactive) media::MediaChangeReport if we in have multiple basurls (>1)
+      media::ScopedDisableMediaChangeReport guard( multipleUrls );
+      MIL << "Refreshing " << ops.size() << " repos concurrently..." << endl;
+      auto all = zyppng::waitFor()( std::move(ops) );
+      ctx->execute( all );
+    }
+
+    for ( const RepoInfo & info : volatileRepos )
+    {
+      try {
+        refreshMetadata( info, policy, progressrcv );
+      }
+      catch ( const Exception & excpt ) {
+        ZYPP_CAUGHT( excpt );
+        ret[info.alias()] = std::current_exception();
       }
-    } // for every url
-    ERR << "No more urls..." << endl;
-    ZYPP_THROW(rexception);
+    }
 
+    for ( const auto & [alias, error] : ret )
+      ERR << "Refresh failed: " << alias << endl;
+    MIL << "Refreshed " << infos.size() - ret.size() << " of " << infos.size() << " repos" << endl;
+    return ret;
   }
 
   void RepoManager::Impl::buildCache( const RepoInfo & info, CacheBuildPolicy policy, const ProgressData::ReceiverFnc & progressrcv )
@@ -1310,6 +1496,9 @@ namespace zypp
   void RepoManager::refreshMetadata( const RepoInfo &info, RawMetadataRefreshPolicy policy, const ProgressData::ReceiverFnc & progressrcv )
   { return _pimpl->refreshMetadata( info, policy, progressrcv ); }
 
+  RepoManager::RefreshMetadataErrors RepoManager::refreshMetadata( const RepoInfoList &infos, RawMetadataRefreshPolicy policy, const ProgressData::ReceiverFnc & progressrcv )
+  { return _pimpl->refreshMetadata( infos, policy, progressrcv ); }
+
   void RepoManager::cleanMetadata( const RepoInfo &info, const ProgressData::ReceiverFnc & progressrcv )
   { return _pimpl->cleanMetadata( info, progressrcv ); }
 
@@ -14,6 +14,8 @@
 
 #include <iosfwd>
 #include <list>
+#include <map>
+#include <exception>
 
 #include <zypp/base/PtrTypes.h>
 #include <zypp/base/Iterator.h>
@@ -253,6 +255,28 @@ namespace zypp
                          RawMetadataRefreshPolicy policy = RefreshIfNeeded,
                          const ProgressData::ReceiverFnc & progressrcv = ProgressData::ReceiverFnc() );
 
+   /** Per repo errors of \ref refreshMetadata(const RepoInfoList&,RawMetadataRefreshPolicy,const ProgressData::ReceiverFnc&), indexed by alias. */
+   using RefreshMetadataErrors = std::map<std::string,std::exception_ptr>;
+
+   /**
+    * \short Refresh local raw cache of many repositories concurrently
+    *
+    * The repomd.xml/content checks and downloads of all repos are run
+    * at once on a single event loop. The number of connections to the
+    * same host is limited by the downloader. Repos on volatile media
+    * (CD/DVD) are refreshed one by one after the others.
+    *
+    * The \a progressrcv is called for each repo with a \ref ProgressData
+    * named after the repos alias.
+    *
+    * A failing repo does not stop the others. Its exception is returned
+    * indexed by the repos alias. An empty result means all repos were
+    * refreshed successfully.
+    */
+   RefreshMetadataErrors refreshMetadata( const RepoInfoList &infos,
+                                          RawMetadataRefreshPolicy policy = RefreshIfNeeded,
+                                          const ProgressData::ReceiverFnc & progressrcv = ProgressData::ReceiverFnc() );
+
    /**
     * \short Clean local metadata
     *
@@ -460,6 +460,7 @@ namespace zypp
       //@}
 
     private:
+      friend class PoolItem;	// save/restore state in the pools snapshot
       const pool::PoolTraits::ItemContainerT & store() const;
       const pool::PoolTraits::Id2ItemT & id2item() const;
 
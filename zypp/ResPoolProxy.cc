@@ -16,6 +16,8 @@
 #include <zypp/base/Iterator.h>
 #include <zypp/base/Algorithm.h>
 #include <zypp/base/Functional.h>
+#include <zypp/base/SerialNumber.h>
+#include <zypp-core/base/DefaultIntegral>
 
 #include <zypp/ResPoolProxy.h>
 #include <zypp/pool/PoolImpl.h>
@@ -80,6 +82,26 @@ namespace zypp
 
       return new ui::Selectable( ui::Selectable::Impl_Ptr( new ui::Selectable::Impl( solv.kind(), solv.name(), begin, end ) ) );
     }
+
+    /** Invoke \a fnc_r on each range of equal idents in \a id2item_r.
+     * Equivalent keys are adjacent in the unordered_multimap.
+     */
+    template <class TFnc>
+    void forEachIdentRange( const pool::PoolImpl::Id2ItemT & id2item_r, TFnc && fnc_r )
+    {
+      if ( id2item_r.empty() )
+        return;
+      pool::PoolImpl::Id2ItemT::const_iterator cbegin = id2item_r.begin();
+      for_( it, id2item_r.begin(), id2item_r.end() )
+      {
+        if ( it->first != cbegin->first )
+        {
+          fnc_r( cbegin, it );
+          cbegin = it;
+        }
+      }
+      fnc_r( cbegin, id2item_r.end() );
+    }
   } // namespace
 
   ///////////////////////////////////////////////////////////////////
@@ -87,7 +109,16 @@ namespace zypp
   //	CLASS NAME : ResPoolProxy::Impl
   //
   /** ResPoolProxy implementation.
-   * \todo Seedup as it is still using old index
+   *
+   * Selectables are created on demand: \ref lookup creates just the
+   * requested one, iterating a kind creates all Selectables of this kind
+   * on the first call, iterating all creates the remaining ones. The
+   * items are taken from the pools id2item index, which holds the items
+   * grouped by ident.
+   *
+   * If the pools content changes, the proxy drops all Selectables and
+   * creates them anew from the changed pool on the next access. Iterators
+   * obtained before the change are invalidated.
   */
   struct ResPoolProxy::Impl
   {
@@ -100,70 +131,139 @@ namespace zypp
   public:
     Impl()
     :_pool( ResPool::instance() )
+    , _poolImpl( nullptr )
     {}
 
     Impl( ResPool &&pool_r, const pool::PoolImpl & poolImpl_r )
     : _pool( std::move(pool_r) )
-    {
-      const pool::PoolImpl::Id2ItemT & id2item( poolImpl_r.id2item() );
-      if ( ! id2item.empty() )
-      {
-        // set startpoint
-        pool::PoolImpl::Id2ItemT::const_iterator cbegin = id2item.begin();
-
-        for_( it, id2item.begin(), id2item.end() )
-        {
-          if ( it->first != cbegin->first )
-          {
-            // starting a new Selectable, create the previous one
-            ui::Selectable::Ptr p( makeSelectablePtr( cbegin, it ) );
-            _selPool.insert( SelectablePool::value_type( p->kind(), p ) );
-            _selIndex[cbegin->first] = p;
-            // remember new startpoint
-            cbegin = it;
-          }
-        }
-        // create the final one
-        ui::Selectable::Ptr p( makeSelectablePtr( cbegin, id2item.end() ) );
-        _selPool.insert( SelectablePool::value_type( p->kind(), p ) );
-        _selIndex[cbegin->first] = p;
-      }
-    }
+    , _poolImpl( &poolImpl_r )
+    , _watcher( _pool.serial() )
+    {}
 
   public:
     ui::Selectable::Ptr lookup( const pool::ByIdent & ident_r ) const
     {
+      checkSerial();
       SelectableIndex::const_iterator it( _selIndex.find( ident_r.get() ) );
       if ( it != _selIndex.end() )
         return it->second;
+
+      if ( ! _allDone )
+      {
+        const pool::PoolImpl::Id2ItemT * id2item( validId2item() );
+        if ( id2item )
+        {
+          auto range( id2item->equal_range( ident_r.get() ) );
+          if ( range.first != range.second )
+            return addSelectable( range.first, range.second );
+        }
+      }
       return ui::Selectable::Ptr();
     }
 
   public:
     bool empty() const
-    { return _selPool.empty(); }
+    { materializeAll(); return _selPool.empty(); }
 
     size_type size() const
-    { return _selPool.size(); }
+    { materializeAll(); return _selPool.size(); }
 
     const_iterator begin() const
-    { return make_map_value_begin( _selPool ); }
+    { materializeAll(); return make_map_value_begin( _selPool ); }
 
     const_iterator end() const
-    { return make_map_value_end( _selPool ); }
+    { materializeAll(); return make_map_value_end( _selPool ); }
 
   public:
     bool empty( const ResKind & kind_r ) const
-    { return( _selPool.count( kind_r ) == 0 );  }
+    { materialize( kind_r ); return( _selPool.count( kind_r ) == 0 );  }
 
     size_type size( const ResKind & kind_r ) const
-    { return _selPool.count( kind_r ); }
+    { materialize( kind_r ); return _selPool.count( kind_r ); }
 
     const_iterator byKindBegin( const ResKind & kind_r ) const
-    { return make_map_value_lower_bound( _selPool, kind_r ); }
+    { materialize( kind_r ); return make_map_value_lower_bound( _selPool, kind_r ); }
 
     const_iterator byKindEnd( const ResKind & kind_r ) const
-    { return make_map_value_upper_bound( _selPool, kind_r ); }
+    { materialize( kind_r ); return make_map_value_upper_bound( _selPool, kind_r ); }
+
+  private:
+    /** Drop all Selectables if the pool content changed meanwhile. */
+    void checkSerial() const
+    {
+      if ( _poolImpl && _watcher.remember( _pool.serial() ) )
+      {
+        MIL << "Pool content changed. Rebuilding ResPoolProxy." << endl;
+        _selPool.clear();
+        _selIndex.clear();
+        _kindsDone.clear();
+        _allDone = false;
+      }
+    }
+
+    /** The pools id2item index or \c nullptr for the default Impl. */
+    const pool::PoolImpl::Id2ItemT * validId2item() const
+    { return _poolImpl ? &_poolImpl->id2item() : nullptr; }
+
+    /** Create and remember the Selectable for the items in [begin_r,end_r). */
+    ui::Selectable::Ptr addSelectable( pool::PoolImpl::Id2ItemT::const_iterator begin_r,
+                                       pool::PoolImpl::Id2ItemT::const_iterator end_r ) const
+    {
+      ui::Selectable::Ptr p( makeSelectablePtr( begin_r, end_r ) );
+      _selPool.insert( SelectablePool::value_type( p->kind(), p ) );
+      _selIndex[begin_r->first] = p;
+      return p;
+    }
+
+    /** Create all missing Selectables of kind \a kind_r.
+     *
+     * The 1st call also creates one Selectable for each kind in the pool.
+     * So later insertions into \ref _selPool always append to an existing
+     * kinds range and never extend the range of a kind someone iterates.
+     */
+    void materialize( const ResKind & kind_r ) const
+    {
+      checkSerial();
+      if ( _allDone || _kindsDone.count( kind_r ) )
+        return;
+      const pool::PoolImpl::Id2ItemT * id2item( validId2item() );
+      if ( ! id2item )
+        return;
+
+      if ( _kindsDone.empty() )
+      {
+        forEachIdentRange( *id2item, [&]( pool::PoolImpl::Id2ItemT::const_iterator begin_r,
+                                          pool::PoolImpl::Id2ItemT::const_iterator end_r ) {
+          if ( _selPool.find( begin_r->second.kind() ) == _selPool.end() && ! _selIndex.count( begin_r->first ) )
+            addSelectable( begin_r, end_r );
+        } );
+      }
+
+      forEachIdentRange( *id2item, [&]( pool::PoolImpl::Id2ItemT::const_iterator begin_r,
+                                        pool::PoolImpl::Id2ItemT::const_iterator end_r ) {
+        if ( begin_r->second.kind() == kind_r && ! _selIndex.count( begin_r->first ) )
+          addSelectable( begin_r, end_r );
+      } );
+      _kindsDone.insert( kind_r );
+    }
+
+    /** Create all missing Selectables. */
+    void materializeAll() const
+    {
+      checkSerial();
+      if ( _allDone )
+        return;
+      const pool::PoolImpl::Id2ItemT * id2item( validId2item() );
+      if ( ! id2item )
+        return;
+
+      forEachIdentRange( *id2item, [&]( pool::PoolImpl::Id2ItemT::const_iterator begin_r,
+                                        pool::PoolImpl::Id2ItemT::const_iterator end_r ) {
+        if ( ! _selIndex.count( begin_r->first ) )
+          addSelectable( begin_r, end_r );
+      } );
+      _allDone = true;
+    }
 
   public:
     size_type knownRepositoriesSize() const
@@ -177,28 +277,40 @@ namespace zypp
 
   public:
 
+    // The pools contiguous state snapshot is used if available, otherwise
+    // the PoolItems one by one (they use the same snapshot).
     void saveState() const
-    { PoolItemSaver().saveState( _pool ); }
+    { if ( _poolImpl ) _poolImpl->SaveState(); else PoolItemSaver().saveState( _pool ); }
 
     void saveState( const ResKind & kind_r ) const
-    { PoolItemSaver().saveState( _pool, kind_r ); }
+    { if ( _poolImpl ) _poolImpl->SaveState( kind_r ); else PoolItemSaver().saveState( _pool, kind_r ); }
 
     void restoreState() const
-    { PoolItemSaver().restoreState( _pool ); }
+    { if ( _poolImpl ) _poolImpl->RestoreState(); else PoolItemSaver().restoreState( _pool ); }
 
     void restoreState( const ResKind & kind_r ) const
-    { PoolItemSaver().restoreState( _pool, kind_r ); }
+    { if ( _poolImpl ) _poolImpl->RestoreState( kind_r ); else PoolItemSaver().restoreState( _pool, kind_r ); }
 
     bool diffState() const
-    { return PoolItemSaver().diffState( _pool ); }
+    { return _poolImpl ? ! _poolImpl->DiffState().empty() : PoolItemSaver().diffState( _pool ); }
 
     bool diffState( const ResKind & kind_r ) const
-    { return PoolItemSaver().diffState( _pool, kind_r ); }
+    { return _poolImpl ? ! _poolImpl->DiffState( kind_r ).empty() : PoolItemSaver().diffState( _pool, kind_r ); }
+
+    sat::SolvableQueue diffStateIds() const
+    { return _poolImpl ? _poolImpl->DiffState() : sat::SolvableQueue(); }
+
+    sat::SolvableQueue diffStateIds( const ResKind & kind_r ) const
+    { return _poolImpl ? _poolImpl->DiffState( kind_r ) : sat::SolvableQueue(); }
 
   private:
     ResPool _pool;
+    const pool::PoolImpl * _poolImpl;	///< the pool's id2item provider (kept alive by _pool)
+    SerialNumberWatcher _watcher;	///< the pool content the proxy was created for
     mutable SelectablePool _selPool;
     mutable SelectableIndex _selIndex;
+    mutable std::set<ResKind> _kindsDone;	///< kinds with all Selectables created
+    mutable DefaultIntegral<bool,false> _allDone;	///< all Selectables created
 
   public:
     /** Offer default Impl. */
@@ -214,7 +326,7 @@ namespace zypp
   inline std::ostream & operator<<( std::ostream & str, const ResPoolProxy::Impl & obj )
   {
     return str << "ResPoolProxy (" << obj._pool.serial() << ") [" << obj._pool.size()
-               << "solv/" << obj.size()<< "sel]";
+               << "solv/" << obj._selPool.size()<< "sel]";
   }
 
   namespace detail
@@ -327,6 +439,12 @@ namespace zypp
   bool ResPoolProxy::diffState( const ResKind & kind_r ) const
   { return _pimpl->diffState( kind_r ); }
 
+  sat::SolvableQueue ResPoolProxy::diffStateIds() const
+  { return _pimpl->diffStateIds(); }
+
+  sat::SolvableQueue ResPoolProxy::diffStateIds( const ResKind & kind_r ) const
+  { return _pimpl->diffStateIds( kind_r ); }
+
   std::ostream & operator<<( std::ostream & str, const ResPoolProxy & obj )
   { return str << *obj._pimpl; }
 
@@ -18,6 +18,7 @@
 #include <zypp/base/PtrTypes.h>
 
 #include <zypp/ResPool.h>
+#include <zypp/sat/Queue.h>
 #include <zypp/ui/Selectable.h>
 #include <zypp/ui/SelFilters.h>
 
@@ -164,7 +165,8 @@ namespace zypp
      * if you didn't save before.
      *
      * Diff returns true, if current stat differs from the saved
-     * state.
+     * state. \ref diffStateIds returns the ids of the changed
+     * items instead (empty if unchanged).
      *
      * Use \ref scopedSaveState for exception safe scoped save/restore
      */
@@ -193,6 +195,14 @@ namespace zypp
       bool diffState() const
       { return diffState( ResTraits<TRes>::kind ); }
 
+    sat::SolvableQueue diffStateIds() const;
+
+    sat::SolvableQueue diffStateIds( const ResKind & kind_r ) const;
+
+    template<class TRes>
+      sat::SolvableQueue diffStateIds() const
+      { return diffStateIds( ResTraits<TRes>::kind ); }
+
     /**
      * \class ScopedSaveState
      * \brief Exception safe scoped save/restore state.
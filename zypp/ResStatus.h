@@ -25,6 +25,7 @@ namespace zypp
   {
     struct UserLockQueryManip;
     class StatusBackup;
+    struct StatusSnapshotManip;
   }
 
   ///////////////////////////////////////////////////////////////////
@@ -702,6 +703,7 @@ namespace zypp
 
   private:
     friend class resstatus::StatusBackup;
+    friend struct resstatus::StatusSnapshotManip;
     BitFieldType _bitfield;
   };
   ///////////////////////////////////////////////////////////////////
@@ -746,6 +748,19 @@ namespace zypp
         ResStatus *             _status;
         ResStatus::BitFieldType _bitfield;
     };
+
+    /** Raw bitfield access for the pools save/restore state snapshot.
+     * The snapshot keeps the saved bitfields in a plain contiguous array.
+     * \see \ref pool::PoolImpl::SaveState
+     */
+    struct StatusSnapshotManip
+    {
+      static ResStatus::FieldType get( const ResStatus & status_r )
+      { return status_r._bitfield.value(); }
+
+      static void set( ResStatus & status_r, ResStatus::FieldType val_r )
+      { status_r._bitfield = ResStatus::BitFieldType( val_r ); }
+    };
   }
 
  /////////////////////////////////////////////////////////////////
@@ -158,12 +158,22 @@ namespace zypp
   std::list<PoolItem> Resolver::problematicUpdateItems() const
   { return _pimpl->problematicUpdateItems(); }
 
+  const ResolverStats & Resolver::stats() const
+  { return _pimpl->stats(); }
+
   bool Resolver::createSolverTestcase( const std::string & dumpPath, bool runSolver )
   {
     solver::detail::Testcase testcase (dumpPath);
     return testcase.createTestcase(*_pimpl, true, runSolver);
   }
 
+  bool Resolver::createSolverTestcase( const std::string & dumpPath, bool runSolver, bool binaryPool )
+  {
+    solver::detail::Testcase testcase (dumpPath);
+    testcase.setBinaryPool( binaryPool );
+    return testcase.createTestcase(*_pimpl, true, runSolver);
+  }
+
   solver::detail::ItemCapKindList Resolver::isInstalledBy( const PoolItem & item )
   { return _pimpl->isInstalledBy (item); }
 
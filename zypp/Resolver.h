@@ -417,6 +417,15 @@ namespace zypp
      */
     bool createSolverTestcase( const std::string & dumpPath = "/var/log/YaST2/solverTestcase", bool runSolver = true );
 
+    /**
+     * Generates a solver Testcase of the current state, optionally dumping
+     * the repos as binary solv files.
+     *
+     * Writing (and loading) a binary testcase is much faster for big pools,
+     * but the result can only be loaded by libzypp, not by libsolvs \c testsolv.
+     */
+    bool createSolverTestcase( const std::string & dumpPath, bool runSolver, bool binaryPool );
+
     /**
      * Gives information about WHO has pused an installation of an given item.
      *
@@ -482,6 +491,18 @@ namespace zypp
      */
     solver::detail::ItemCapKindList installedSatisfied( const PoolItem & item );
 
+    /**
+     * Timing and libsolv statistics of the last solver run.
+     *
+     * Wall and cpu time spent per phase (job queue setup, pool preparation,
+     * solving, result transfer and problem generation), libsolv rule, decision
+     * and learnt clause counts, and the pool sizes. Use it to tell whether a slow
+     * run is spent in preparing the pool or in the SAT search.
+     *
+     * \see \ref ResolverStats
+     */
+    const ResolverStats & stats() const;
+
   public:
     /** Expert backdoor. */
     sat::detail::CSolver * get() const;
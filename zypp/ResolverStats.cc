@@ -0,0 +1,85 @@
+/*---------------------------------------------------------------------\
+|                          ____ _   __ __ ___                          |
+|                         |__  / \ / / . \ . \                         |
+|                           / / \ V /|  _/  _/                         |
+|                          / /__ | | | | | |                           |
+|                         /_____||_| |_| |_|                           |
+|                                                                      |
+\---------------------------------------------------------------------*/
+/** \file	zypp/ResolverStats.cc
+ */
+#include <iostream>
+#include <zypp/base/Logger.h>
+#include <zypp/base/String.h>
+#include <zypp/ResolverStats.h>
+
+using std::endl;
+
+///////////////////////////////////////////////////////////////////
+namespace zypp
+{
+  double ResolverStats::totalWall() const
+  {
+    double ret = 0.0;
+    for ( const PhaseTime & p : phase )
+      ret += p.wall;
+    return ret;
+  }
+
+  double ResolverStats::totalCpu() const
+  {
+    double ret = 0.0;
+    for ( const PhaseTime & p : phase )
+      ret += p.cpu;
+    return ret;
+  }
+
+  std::string asString( ResolverStats::Phase val_r )
+  {
+    switch ( val_r )
+    {
+#define OUTS(V) case ResolverStats::V: return #V; break
+      OUTS( SolverInit );
+      OUTS( PoolPrepare );
+      OUTS( Solve );
+      OUTS( ResultTransfer );
+      OUTS( Problems );
+      OUTS( PhaseCount );
+#undef OUTS
+    }
+    // Oops!
+    std::string ret { str::Str() << "ResolverStats::Phase(" << static_cast<int>(val_r) << ")"  };
+    WAR << "asString: dubious " << ret << endl;
+    return ret;
+  }
+
+  std::ostream & operator<<( std::ostream & str, const ResolverStats & obj )
+  {
+    str << "ResolverStats {" << endl;
+    for ( unsigned i = 0; i < ResolverStats::PhaseCount; ++i )
+    {
+      const ResolverStats::PhaseTime & p { obj.phase[i] };
+      str << str::form( "  %-16s wall %8.3fs  cpu %8.3fs  (%u)",
+                        asString( ResolverStats::Phase(i) ).c_str(), p.wall, p.cpu, p.calls ) << endl;
+    }
+    str << str::form( "  %-16s wall %8.3fs  cpu %8.3fs", "Total", obj.totalWall(), obj.totalCpu() ) << endl;
+
+    const ResolverStats::RuleCounts & r { obj.rules };
+    str << "  rules        " << r.total
+        << " (pkg " << r.pkg << ", update " << r.update << ", feature " << r.feature
+        << ", job " << r.job << ", dup " << r.distupgrade << ", infarch " << r.infarch
+        << ", best " << r.best << ", choice " << r.choice << ", learnt " << r.learnt
+        << ", other " << r.other << ")" << endl;
+    str << "  decisions    " << obj.decisions << endl;
+    str << "  jobs         " << obj.jobs << endl;
+    str << "  problems     " << obj.problems << endl;
+
+    const ResolverStats::PoolSizes & s { obj.pool };
+    str << "  pool         solvables " << s.solvables << ", repos " << s.repos
+        << ", strings " << s.strings << ", rels " << s.rels
+        << ", whatprovides " << s.whatprovides << endl;
+    return str << "}";
+  }
+
+} // namespace zypp
+///////////////////////////////////////////////////////////////////
@@ -0,0 +1,110 @@
+/*---------------------------------------------------------------------\
+|                          ____ _   __ __ ___                          |
+|                         |__  / \ / / . \ . \                         |
+|                           / / \ V /|  _/  _/                         |
+|                          / /__ | | | | | |                           |
+|                         /_____||_| |_| |_|                           |
+|                                                                      |
+\---------------------------------------------------------------------*/
+/** \file	zypp/ResolverStats.h
+ */
+#ifndef ZYPP_RESOLVERSTATS_H
+#define ZYPP_RESOLVERSTATS_H
+
+#include <iosfwd>
+#include <string>
+
+#include <zypp/Globals.h>
+
+///////////////////////////////////////////////////////////////////
+namespace zypp
+{
+  ///////////////////////////////////////////////////////////////////
+  /// \class ResolverStats
+  /// \brief Per phase timing and libsolv statistics of the last solver run.
+  ///
+  /// Collected on each solver run and available via \ref Resolver::stats.
+  /// A solver testcase dumps them into \c zypp-stats.yaml.
+  ///
+  /// Times are in seconds. \c wall is measured by a steady clock, \c cpu
+  /// is the process cpu time (user + system) consumed within the phase.
+  /// The \ref PoolPrepare phase is close to \c 0 if the pools whatprovides
+  /// index was still valid from a previous run.
+  ///////////////////////////////////////////////////////////////////
+  struct ZYPP_API ResolverStats
+  {
+    /** Phases of a solver run. */
+    enum Phase
+    {
+      SolverInit = 0,	///< Create the solver and set up the job queue (SATResolver::solverInit*)
+      PoolPrepare,	///< Prepare the pool, esp. create the whatprovides index
+      Solve,		///< libsolv's solver_solve (incl. a 2nd run for dup droplists)
+      ResultTransfer,	///< Transfer the solver result back into the PoolItems ResStatus
+      Problems,		///< Create problems and solutions for the UI
+      PhaseCount	///< Number of phases (not a phase)
+    };
+
+    /** Time spent in a \ref Phase. */
+    struct PhaseTime
+    {
+      double wall = 0.0;	///< real time in seconds
+      double cpu = 0.0;		///< process cpu time in seconds
+      unsigned calls = 0;	///< number of times the phase was entered
+    };
+
+    /** Number of rules per libsolv rule class. */
+    struct RuleCounts
+    {
+      unsigned total = 0;
+      unsigned pkg = 0;		///< package dependency rules
+      unsigned update = 0;
+      unsigned feature = 0;
+      unsigned job = 0;
+      unsigned distupgrade = 0;
+      unsigned infarch = 0;
+      unsigned best = 0;
+      unsigned choice = 0;
+      unsigned learnt = 0;	///< clauses learnt during the SAT search
+      unsigned other = 0;	///< rule classes not listed above
+    };
+
+    /** Size of the sat::Pool at solver time. */
+    struct PoolSizes
+    {
+      unsigned solvables = 0;	///< allocated solvable slots (incl. free ones)
+      unsigned repos = 0;
+      unsigned strings = 0;	///< string ids
+      unsigned rels = 0;	///< relational dependencies
+      unsigned whatprovides = 0;///< size of the whatprovides data
+    };
+
+    PhaseTime  phase[PhaseCount];
+    RuleCounts rules;
+    PoolSizes  pool;
+    unsigned   decisions = 0;	///< solver decisions (installs and conflicts)
+    unsigned   jobs = 0;	///< job queue elements (job,what pairs)
+    unsigned   problems = 0;	///< number of problems found
+
+    /** Clear all values. */
+    void clear()
+    { *this = ResolverStats(); }
+
+    /** \ref PhaseTime of \a phase_r. */
+    const PhaseTime & operator[]( Phase phase_r ) const
+    { return phase[phase_r]; }
+
+    /** Total wall time spent in all phases. */
+    double totalWall() const;
+    /** Total cpu time spent in all phases. */
+    double totalCpu() const;
+  };
+
+  /** \relates ResolverStats::Phase Conversion to string (enumerator name) */
+  std::string asString( ResolverStats::Phase val_r ) ZYPP_API;
+
+  /** \relates ResolverStats Stream output */
+  std::ostream & operator<<( std::ostream & str, const ResolverStats & obj ) ZYPP_API;
+
+} // namespace zypp
+///////////////////////////////////////////////////////////////////
+#endif // ZYPP_RESOLVERSTATS_H
@@ -717,6 +717,11 @@ namespace zypp
             cfg_arch = carch;
           }
         }
+        // the mirror health data are kept in the repo cache of the system we work on
+        _mediaConf.setDefaultMirrorHealthFile( []() {
+          const ZConfig & zconfig { ZConfig::instance() };
+          return Pathname::assertprefix( zconfig.repoManagerRoot(), zconfig.repoCachePath() ) / "mirror-health";
+        } );
         MIL << "ZConfig singleton created." << endl;
       }
 
@@ -973,6 +973,11 @@ void MediaHandler::provideFile( const OnMediaLocation &file ) const
     ZYPP_THROW(MediaNotAttachedException(url()));
   }
 
+  if ( takePrecachedFile( file ) ) {
+    DBG << "provideFile(" << file << ") precached" << endl;
+    return;
+  }
+
   getFile( file ); // pass to concrete handler
   DBG << "provideFile(" << file << ")" << endl;
 }
@@ -1353,6 +1358,11 @@ void MediaHandler::precacheFiles( const std::vector<OnMediaLocation> & )
   /* do nothing */
 }
 
+bool MediaHandler::takePrecachedFile( const OnMediaLocation & ) const
+{
+  return false;
+}
+
   } // namespace media
 } // namespace zypp
 // vim: set ts=8 sts=2 sw=2 ai noet:
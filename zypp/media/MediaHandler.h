@@ -356,6 +356,18 @@ class ZYPP_TESTS MediaHandler {
          **/
         virtual void getFile( const OnMediaLocation &file ) const;
 
+        /**
+         * Called by \ref provideFile before passing the request to \ref getFile.
+         *
+         * A handler which downloaded \a file ahead of time in \ref precacheFiles
+         * returns \c true if the file is ready below the attach point, so there is
+         * no need to download it again. The precached state is consumed, a 2nd
+         * request for the same file goes to \ref getFile.
+         *
+         * The default implementation returns \c false.
+         **/
+        virtual bool takePrecachedFile( const OnMediaLocation &file ) const;
+
         /**
          * Call concrete handler to provide a file under a different place
          * in the file system (usually not under attach point) as a copy.
@@ -699,8 +711,9 @@ class ZYPP_TESTS MediaHandler {
         /**
          * Tries to fetch the given files and precaches them. Those files
          * need to be queried using provideFile and can be read from the cache directly.
-         * The implementation is not allowed to block but needs to use seperate means to
-         * download the files concurrently.
+         * The implementation should download the files concurrently and may block until
+         * the whole batch is done. Files which could not be precached are silently left
+         * to \ref provideFile, so the usual error handling and reporting applies.
          * A backend can choose to completely ignore this functionaly, the default implementation
          * does nothing.
          *
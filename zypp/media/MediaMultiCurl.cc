@@ -33,6 +33,7 @@
 #include <zypp-curl/parser/MetaLinkParser>
 #include <zypp-curl/parser/zsyncparser.h>
 #include <zypp-curl/private/curlhelper_p.h>
+#include <zypp-curl/private/mirrorhealth_p.h>
 #include <zypp-curl/auth/CurlAuthData>
 #include <zypp-curl/parser/metadatahelper.h>
 #include <zypp-curl/ng/network/curlmultiparthandler.h>
@@ -1023,6 +1024,16 @@ multifetchrequest::multifetchrequest(const MediaMultiCurl *context, Pathname fil
 
 multifetchrequest::~multifetchrequest()
 {
+  // remember how the mirrors performed for the next run
+  MirrorHealth &health = MirrorHealth::instance();
+  for ( const auto &worker : _workers ) {
+    if ( worker->_state == WORKER_BROKEN )
+      health.recordTransfer( worker->url(), false );
+    else if ( worker->_received )
+      health.recordTransfer( worker->url(), true, worker->_avgspeed );
+  }
+  health.saveIfDue();
+
   _workers.clear();
 }
 
@@ -1773,6 +1784,8 @@ void MediaMultiCurl::multifetch(const Pathname & filename, FILE *fp, std::vector
     }
   if (!myurllist.size())
     myurllist.push_back(baseurl);
+  else
+    MirrorHealth::instance().sortByHealth(myurllist);
   req.run(myurllist);
   checkFileDigest(baseurl, fp, req.blockList() );
 }
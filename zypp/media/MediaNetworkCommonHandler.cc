@@ -16,6 +16,15 @@
 #include <zypp-core/fs/PathInfo.h>
 #include <zypp/base/Logger.h>
 #include <zypp-core/base/Regex.h>
+#include <zypp-core/zyppng/base/EventLoop>
+
+#include <zypp-curl/ng/network/Downloader>
+#include <zypp-curl/ng/network/NetworkRequestDispatcher>
+#include <zypp-curl/ng/network/DownloadSpec>
+
+#include <zypp-media/MediaConfig>
+#include <zypp-media/auth/CredentialManager>
+#include <zypp-curl/auth/CurlAuthData>
 
 #include <fstream>
 
@@ -93,4 +102,101 @@ namespace zypp::media
     newurl.setPathName( ( Pathname("./"+baseUrl.getPathName()) / filename_r ).asString().substr(1) );
     return newurl;
   }
+
+  void MediaNetworkCommonHandler::precacheFiles( const std::vector<OnMediaLocation> &files )
+  {
+    if ( !isAttached() || files.empty() )
+      return;
+
+    try {
+      auto ev = zyppng::EventLoop::create();
+      auto downloader = std::make_shared<zyppng::Downloader>();
+      downloader->requestDispatcher()->setMaximumConcurrentConnections( MediaConfig::instance().download_max_concurrent_connections() );
+
+      std::vector<std::pair<zyppng::DownloadRef, Pathname>> downloads;
+      std::vector<zyppng::connection> signalConnections;
+      size_t finished = 0;
+
+      const auto &finishedSlot = [&]( zyppng::Download & ) {
+        if ( ++finished == downloads.size() )
+          ev->quit();
+      };
+
+      // never prompt here, a file failing to authenticate is requested again by getFile
+      const auto &authRequiredSlot = [&]( zyppng::Download &, zyppng::NetworkAuthData &auth, const std::string & ) {
+        CredentialManager cm( CredManagerOptions( ZConfig::instance().repoManagerRoot() ) );
+        AuthData_Ptr cmcred = cm.getCred( _url );
+        if ( cmcred && auth.lastDatabaseUpdate() < cmcred->lastDatabaseUpdate() )
+          auth = CurlAuthData( *cmcred );
+        else
+          auth = zyppng::NetworkAuthData();
+      };
+
+      for ( const auto &file : files ) {
+        // deltas are rare and need the special handling in getFile
+        if ( !file.deltafile().empty() )
+          continue;
+
+        Pathname target { localPath( file.filename() ).absolutename() };
+        if ( _precached.count( target ) || PathInfo( target ).isExist() )
+          continue;
+
+        if ( filesystem::assert_dir( target.dirname() ) != 0 ) {
+          WAR << "Unable to create directory for precaching " << target << std::endl;
+          continue;
+        }
+
+        zyppng::DownloadSpec spec = zyppng::DownloadSpec( getFileUrl( file.filename() ), target, file.downloadSize() )
+          .setHeaderSize( file.headerSize() )
+          .setHeaderChecksum( file.headerChecksum() )
+          .setTransferSettings( _settings );
+
+        downloads.push_back( std::make_pair( downloader->downloadFile( spec ), std::move(target) ) );
+      }
+
+      if ( downloads.empty() )
+        return;
+
+      for ( auto &[ dl, target ] : downloads ) {
+        signalConnections.push_back( dl->connectFunc( &zyppng::Download::sigFinished, finishedSlot ) );
+        signalConnections.push_back( dl->connectFunc( &zyppng::Download::sigAuthRequired, authRequiredSlot ) );
+        dl->start();
+      }
+
+      MIL << "Precaching " << downloads.size() << " files from " << _url << std::endl;
+      if ( finished < downloads.size() )
+        ev->run();
+
+      for ( auto &conn : signalConnections )
+        conn.disconnect();
+
+      size_t precached = 0;
+      for ( const auto &[ dl, target ] : downloads ) {
+        if ( dl->hasError() ) {
+          DBG << "Precaching " << target << " failed: " << dl->lastRequestError().toString() << std::endl;
+          filesystem::unlink( target );
+          continue;
+        }
+        _precached.insert( target );
+        ++precached;
+      }
+      MIL << "Precached " << precached << " of " << downloads.size() << " files" << std::endl;
+    }
+    catch ( const Exception &excpt ) {
+      ZYPP_CAUGHT( excpt );
+      WAR << "Precaching files failed, they will be downloaded on demand." << std::endl;
+    }
+  }
+
+  bool MediaNetworkCommonHandler::takePrecachedFile( const OnMediaLocation &file ) const
+  {
+    auto it = _precached.find( localPath( file.filename() ).absolutename() );
+    if ( it == _precached.end() )
+      return false;
+
+    // the file may have been released in the meantime
+    const bool ready = PathInfo( *it ).isFile();
+    _precached.erase( it );
+    return ready;
+  }
 }
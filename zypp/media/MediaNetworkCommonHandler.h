@@ -11,6 +11,8 @@
 #ifndef ZYPP_MEDIA_MEDIANETWORKCOMMONHANDLER_H
 #define ZYPP_MEDIA_MEDIANETWORKCOMMONHANDLER_H
 
+#include <set>
+
 #include <zypp/media/MediaHandler.h>
 #include <zypp-curl/TransferSettings>
 
@@ -43,7 +45,18 @@ namespace zypp
       TransferSettings & settings()
       { return _settings; }
 
+      /**
+       * Downloads \a files concurrently into the attach point, using at most
+       * \ref MediaConfig::download_max_concurrent_connections connections.
+       * Blocks until the whole batch is done. Only stored credentials are
+       * used, files which fail (e.g. because of a needed auth prompt) are left
+       * to \ref getFile.
+       */
+      void precacheFiles( const std::vector<OnMediaLocation> &files ) override;
+
     protected:
+      bool takePrecachedFile( const OnMediaLocation &file ) const override;
+
 
       /**
        * concatenate the attach url and the filename to a complete
@@ -61,6 +74,10 @@ namespace zypp
     protected:
       mutable TransferSettings _settings;
       Url _redirTarget;
+
+    private:
+      /** Files downloaded by \ref precacheFiles not yet taken by \ref provideFile. */
+      mutable std::set<Pathname> _precached;
     };
 
   } // namespace media
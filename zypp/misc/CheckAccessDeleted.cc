@@ -13,7 +13,19 @@
 #include <fstream>
 #include <unordered_set>
 #include <iterator>
+#include <string_view>
+#include <atomic>
+#include <thread>
+#include <errno.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <dirent.h>
+#include <limits.h>
+#include <pwd.h>
+#include <unistd.h>
+#include <sys/stat.h>
 #include <zypp/base/LogControl.h>
 #include <zypp/base/LogTools.h>
 #include <zypp/base/String.h>
@@ -196,7 +208,229 @@ namespace zypp
       } tmpUnblock;
 
       librpmDb::db_const_iterator it;
-      return( it.findPackage( "lsof" ) && it->tag_edition() < Edition("4.90") && !it->tag_provides().count( Capability("backported-option-Ki") ) );
+      if ( ! ( it.findPackage( "lsof" ) && it->tag_edition() < Edition("4.90") ) )
+        return false;
+
+      // Look for the unversioned provides without building all provided Capabilities.
+      std::vector<std::string_view> names;
+      std::vector<std::string_view> versions;
+      it->string_views( RPMTAG_PROVIDENAME, names );
+      it->string_views( RPMTAG_PROVIDEVERSION, versions );
+      for ( unsigned i = 0; i < names.size(); ++i )
+      {
+        if ( names[i] == "backported-option-Ki" && ( i >= versions.size() || versions[i].empty() ) )
+          return false;
+      }
+      return true;
+    }
+
+    /////////////////////////////////////////////////////////////////
+    //
+    // Native /proc scanner, producing the same records as lsof.
+    //
+    /////////////////////////////////////////////////////////////////
+
+    /** Whether to scan /proc rather than running lsof.
+     * Set ZYPP_CHECKACCESSDELETED_LSOF in the environment to enforce lsof.
+     */
+    bool useProcScanner()
+    {
+      if ( getenv( "ZYPP_CHECKACCESSDELETED_LSOF" ) )
+        return false;
+      return ::access( "/proc/self/maps", R_OK ) == 0;
+    }
+
+    /** What a single process in /proc reveals about deleted files. */
+    struct ProcScan
+    {
+      bool valid = false;       //!< the process was readable
+      pid_t ppid = 0;
+      uid_t uid = 0;
+      std::string comm;
+      /** (lsof filedescriptor, name) of the deleted files the process maps or executes */
+      std::vector<std::pair<const char *,std::string>> files;
+    };
+
+    /** Read the /proc entries of a process, reusing a single buffer. */
+    class ProcReader
+    {
+    public:
+      /** Scan /proc/\a pid_r into \a scan_r. */
+      void scan( pid_t pid_r, ProcScan & scan_r )
+      {
+        char path[32];
+        ::snprintf( path, sizeof(path), "/proc/%d", int(pid_r) );
+        int dirfd = ::open( path, O_RDONLY|O_DIRECTORY|O_CLOEXEC );
+        if ( dirfd < 0 )
+          return;	// process is gone
+
+        struct stat st;
+        if ( ::fstat( dirfd, &st ) == 0 && parseStat( dirfd, scan_r ) )
+        {
+          scan_r.valid = true;
+          scan_r.uid = st.st_uid;
+          parseExe( dirfd, scan_r );
+          parseMaps( dirfd, scan_r );
+        }
+        ::close( dirfd );
+      }
+
+    private:
+      /** Read the file \a name_r below \a dirfd_r into \ref _buf. */
+      bool readFile( int dirfd_r, const char * name_r )
+      {
+        _len = 0;
+        int fd = ::openat( dirfd_r, name_r, O_RDONLY|O_CLOEXEC );
+        if ( fd < 0 )
+          return false;
+
+        // procfs reports a size of 0, so we read until EOF
+        while ( true )
+        {
+          if ( _buf.size() - _len < 4096 )
+            _buf.resize( std::max<size_t>( 2 * _buf.size(), 65536 ) );
+          ssize_t got = ::read( fd, _buf.data() + _len, _buf.size() - _len );
+          if ( got < 0 )
+          {
+            if ( errno == EINTR )
+              continue;
+            ::close( fd );
+            return false;
+          }
+          if ( got == 0 )
+            break;
+          _len += got;
+        }
+        ::close( fd );
+        return true;
+      }
+
+      /** Name without a trailing " (deleted)" if the kernel tagged the link target as deleted. */
+      static std::string_view deletedName( std::string_view name_r )
+      {
+        static constexpr std::string_view deleted { " (deleted)" };
+        if ( name_r.size() > deleted.size() && name_r.substr( name_r.size() - deleted.size() ) == deleted )
+          return name_r.substr( 0, name_r.size() - deleted.size() );
+        return std::string_view();
+      }
+
+      /** "pid (comm) state ppid ..." where comm may contain blanks and parens. */
+      bool parseStat( int dirfd_r, ProcScan & scan_r )
+      {
+        if ( ! readFile( dirfd_r, "stat" ) )
+          return false;
+        std::string_view stat { _buf.data(), _len };
+        std::string_view::size_type lpar = stat.find( '(' );
+        std::string_view::size_type rpar = stat.rfind( ')' );
+        if ( lpar == std::string_view::npos || rpar == std::string_view::npos || rpar < lpar || rpar + 4 >= stat.size() )
+          return false;
+        scan_r.comm = stat.substr( lpar + 1, rpar - lpar - 1 );
+        scan_r.ppid = ::strtol( stat.data() + rpar + 4, nullptr, 10 );	// skip ") S "
+        return true;
+      }
+
+      /** A deleted executable is reported as 'txt'. */
+      void parseExe( int dirfd_r, ProcScan & scan_r )
+      {
+        char link[PATH_MAX + 16];
+        ssize_t len = ::readlinkat( dirfd_r, "exe", link, sizeof(link) );
+        if ( len <= 0 || len == sizeof(link) )
+          return;
+        std::string_view name { deletedName( std::string_view( link, len ) ) };
+        if ( ! name.empty() )
+          scan_r.files.push_back( { "txt", std::string( name ) } );
+      }
+
+      /** Deleted files mapped into memory are reported as 'DEL'.
+       * Lines look like "address perms offset dev inode [pathname]".
+       */
+      void parseMaps( int dirfd_r, ProcScan & scan_r )
+      {
+        if ( ! readFile( dirfd_r, "maps" ) )
+          return;
+
+        std::string_view prev;	// consecutive lines usually map the same file
+        std::string_view maps { _buf.data(), _len };
+        while ( ! maps.empty() )
+        {
+          std::string_view::size_type eol = maps.find( '\n' );
+          std::string_view line { maps.substr( 0, eol ) };
+          maps.remove_prefix( eol == std::string_view::npos ? maps.size() : eol + 1 );
+
+          // skip address, perms, offset and dev
+          std::string_view::size_type pos = 0;
+          for ( unsigned i = 0; i < 4 && pos != std::string_view::npos; ++i )
+          {
+            pos = line.find( ' ', pos );
+            if ( pos != std::string_view::npos )
+              ++pos;
+          }
+          if ( pos == std::string_view::npos || line.substr( pos, 2 ) == "0 " )
+            continue;	// no inode: anonymous mapping
+          pos = line.find( ' ', pos );
+          if ( pos == std::string_view::npos )
+            continue;
+          pos = line.find_first_not_of( ' ', pos );
+          if ( pos == std::string_view::npos )
+            continue;
+
+          std::string_view name { deletedName( line.substr( pos ) ) };
+          if ( name.empty() || name == prev )
+            continue;
+          prev = name;
+          scan_r.files.push_back( { "DEL", std::string( name ) } );
+        }
+      }
+
+    private:
+      std::vector<char> _buf;
+      size_t _len = 0;
+    };
+
+    /** The PIDs listed in /proc. */
+    std::vector<pid_t> procPids()
+    {
+      std::vector<pid_t> ret;
+      DIR * dir = ::opendir( "/proc" );
+      if ( ! dir )
+        return ret;
+      while ( struct dirent * entry = ::readdir( dir ) )
+      {
+        if ( entry->d_name[0] < '1' || entry->d_name[0] > '9' )
+          continue;
+        char * end = nullptr;
+        long pid = ::strtol( entry->d_name, &end, 10 );
+        if ( end && *end == '\0' )
+          ret.push_back( pid );
+      }
+      ::closedir( dir );
+      return ret;
+    }
+
+    /** Login name of \a uid_r, remembered in \a cache_r. */
+    const std::string & loginName( std::map<uid_t,std::string> & cache_r, uid_t uid_r )
+    {
+      auto it = cache_r.find( uid_r );
+      if ( it == cache_r.end() )
+      {
+        std::string name;
+        struct passwd pwd;
+        struct passwd * result = nullptr;
+        char buf[4096];
+        if ( ::getpwuid_r( uid_r, &pwd, buf, sizeof(buf), &result ) == 0 && result )
+          name = result->pw_name;
+        it = cache_r.emplace( uid_r, std::move(name) ).first;
+      }
+      return it->second;
+    }
+
+    /** Append the NUL terminated lsof field \a tag_r \a value_r. */
+    template <class TValue>
+    inline void lsofField( std::string & line_r, char tag_r, const TValue & value_r )
+    {
+      line_r += tag_r;
+      line_r += value_r;
+      line_r += '\0';
     }
 
   } //namespace
@@ -211,6 +445,7 @@ namespace zypp
     void addCacheIf( CacheEntry & cache_r, const std::string & line_r, std::vector<std::string> *debMap = nullptr );
 
     std::map<pid_t,CacheEntry> filterInput( externalprogram::ExternalDataSource &source );
+    std::map<pid_t,CacheEntry> scanProc();
     CheckAccessDeleted::size_type createProcInfo( const std::map<pid_t,CacheEntry> &in );
 
     std::vector<CheckAccessDeleted::ProcInfo> _data;
@@ -438,15 +673,105 @@ namespace zypp
     return cachemap;
   }
 
+  /** Scan /proc in parallel and build the same cache lsof output would.
+   * Workers just collect the deleted files per process. Filtering, the
+   * container check and the debug file are handled on the calling thread,
+   * exactly as for the lsof output.
+   */
+  std::map<pid_t,CacheEntry> CheckAccessDeleted::Impl::scanProc()
+  {
+    static constexpr unsigned maxThreads = 8;
+    static constexpr size_t pidsPerThread = 64;
+
+    const std::vector<pid_t> pids { procPids() };
+    std::vector<ProcScan> scans( pids.size() );
+    std::atomic<size_t> next { 0 };
+
+    auto worker = [&]() {
+      ProcReader reader;
+      for ( size_t i = next++; i < pids.size(); i = next++ )
+        reader.scan( pids[i], scans[i] );
+    };
+
+    unsigned nthreads = std::min<size_t>( std::max( std::thread::hardware_concurrency(), 1U ), std::min<size_t>( maxThreads, pids.size() / pidsPerThread + 1 ) );
+    std::vector<std::thread> threads;
+    for ( unsigned i = 1; i < nthreads; ++i )
+      threads.emplace_back( worker );
+    worker();
+    for ( auto & t : threads )
+      t.join();
+
+    // cachemap: PID => (deleted files)
+    // NOTE: omit PIDs running in a (lxc/docker) container
+    std::map<pid_t,CacheEntry> cachemap;
+    bool debugEnabled = !_debugFile.empty();
+    unsigned readable = 0;
+    std::map<uid_t,std::string> logins;
+
+    FilterRunsInContainer runsInLXC;
+    MIL << "Silently scanning /proc (" << pids.size() << " processes, " << nthreads << " threads)..." << endl;
+    {
+      zypp::base::LogControl::TmpLineWriter shutUp;	// suppress excessive readdir etc. logging in runsInLXC
+      for ( size_t i = 0; i < pids.size(); ++i )
+      {
+        ProcScan & scan { scans[i] };
+        if ( ! scan.valid )
+          continue;
+        ++readable;
+        if ( scan.files.empty() )
+          continue;
+        const pid_t pid = pids[i];
+        if ( runsInLXC( pid ) )
+          continue;
+
+        std::string line;
+        lsofField( line, 'p', str::numstring( pid ) );
+        lsofField( line, 'R', str::numstring( scan.ppid ) );
+        lsofField( line, 'c', scan.comm );
+        lsofField( line, 'u', str::numstring( scan.uid ) );
+        const std::string & login { loginName( logins, scan.uid ) };
+        if ( ! login.empty() )
+          lsofField( line, 'L', login );
+        line += '\n';
+
+        std::vector<std::string> * dbgMap = nullptr;
+        if ( debugEnabled )
+        {
+          dbgMap = &debugMap[pid];
+          dbgMap->push_back( line );
+        }
+        CacheEntry & cache { cachemap[pid] };
+        cache.first.swap( line );
+
+        for ( auto & [ fd, name ] : scan.files )
+        {
+          line.clear();
+          lsofField( line, 'f', fd );
+          lsofField( line, 't', "REG" );
+          if ( *fd == 't' )
+            lsofField( line, 'k', "0" );
+          lsofField( line, 'n', name );
+          line += '\n';
+          addCacheIf( cache, line, dbgMap );
+        }
+      }
+    }
+    MIL << "Scanned " << readable << " readable processes, " << cachemap.size() << " accessing deleted files" << endl;
+    return cachemap;
+  }
+
   CheckAccessDeleted::size_type CheckAccessDeleted::check( bool verbose_r  )
   {
+    _pimpl->_verbose = verbose_r;
+    _pimpl->_fromLsofFileMode = false;
+
+    if ( useProcScanner() )
+      return _pimpl->createProcInfo( _pimpl->scanProc() );
+
     static const char* argv[] = { "lsof", "-n", "-FpcuLRftkn0", "-K", "i", NULL };
     if ( lsofNoOptKi() )
       argv[3] = NULL;
 
-    _pimpl->_verbose = verbose_r;
-    _pimpl->_fromLsofFileMode = false;
-
     ExternalProgram prog( argv, ExternalProgram::Discard_Stderr );
     std::map<pid_t,CacheEntry> cachemap;
 
@@ -85,6 +85,10 @@ namespace zypp
        * A verbose check will omit this test and collect all processes using
        * any deleted file.
        *
+       * The data are collected by scanning \c /proc/<pid>/exe and \c /proc/<pid>/maps
+       * in parallel. If \c /proc is not available (or \c ZYPP_CHECKACCESSDELETED_LSOF
+       * is set in the environment) \c lsof is used.
+       *
        * \return the number of processes found.
        * \throws Exception On error collecting the data (e.g. no lsof installed)
        */
@@ -10,6 +10,7 @@
  *
 */
 #include <iostream>
+#include <future>
 
 #include <zypp/base/LogTools.h>
 #include <zypp/PathInfo.h>
@@ -52,13 +53,16 @@ namespace zypp
 
       sat::Pool satpool( sat::Pool::instance() );
 
-      if ( 1 )
-      {
-        MIL << "*** load target '" << Repository::systemRepoAlias() << "'\t" << endl;
-        getZYpp()->initializeTarget( sysRoot_r );
-        getZYpp()->target()->load();
-        MIL << satpool.systemRepo() << endl;
-      }
+      // Checking and rebuilding the @System solv file (rpmdb2solv) does not
+      // touch the pool, so it runs in the background while the repos are
+      // refreshed and loaded. The (still empty) system repo is created in
+      // advance to keep the pools repo order; the target is loaded into it
+      // once the solv file is ready.
+      MIL << "*** build target cache '" << Repository::systemRepoAlias() << "'\t" << endl;
+      getZYpp()->initializeTarget( sysRoot_r );
+      Target_Ptr target { getZYpp()->target() };
+      std::future<void> targetCache { std::async( std::launch::async, [target]() { target->buildCache(); } ) };
+      satpool.systemRepo();
 
       if ( not flags_r.testFlag( LS_NOREPOS ) )
       {
@@ -103,6 +107,13 @@ namespace zypp
           }
         }
       }
+      {
+        MIL << "*** load target '" << Repository::systemRepoAlias() << "'\t" << endl;
+        targetCache.get();	// rethrows if the cache could not be built
+        target->load();		// cache is up to date now
+        MIL << satpool.systemRepo() << endl;
+      }
+
       MIL << str::form( "*** Read system at '%s'", sysRoot_r.c_str() ) << endl;
     }
 
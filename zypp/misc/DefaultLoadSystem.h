@@ -43,6 +43,10 @@ namespace zypp
     /**
      * Create the ZYpp instance and load target and enabled repositories.
      *
+     * The \c @System solv file is checked and rebuilt (if needed) in a
+     * background thread, while the enabled repositories are refreshed and
+     * loaded. The target is loaded last.
+     *
      * \see LoadSystemFlag for options.
      *
      * \throws Exception on error
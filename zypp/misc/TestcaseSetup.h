@@ -37,6 +37,7 @@ namespace zypp::misc::testcase
   enum class TestcaseRepoType {
     Helix,
     Testtags,
+    Solv,   ///< binary solv file, see \ref zypp::solver::detail::Testcase::setBinaryPool
     Url
   };
 
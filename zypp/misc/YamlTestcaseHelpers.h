@@ -131,8 +131,12 @@ namespace yamltest::detail {
           if ( dataNode["priority"] )
             prio = dataNode["priority"].as<unsigned>();
 
+          auto type = zypp::misc::testcase::TestcaseRepoType::Testtags;
+          if ( dataNode["format"] && dataNode["format"].as<std::string>() == "solv" )
+            type = zypp::misc::testcase::TestcaseRepoType::Solv;
+
           target.repos.push_back( zypp::misc::testcase::RepoDataImpl{
-            zypp::misc::testcase::TestcaseRepoType::Testtags,
+            type,
             name,
             prio,
             file
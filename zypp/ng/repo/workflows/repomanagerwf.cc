@@ -9,11 +9,14 @@
 #include "repomanagerwf.h"
 
 #include <zypp-core/ManagedFile.h>
+#include <zypp-core/fs/PathInfo.h>
 #include <utility>
+#include <fstream>
 #include <zypp-core/zyppng/pipelines/MTry>
 #include <zypp-media/MediaException>
 #include <zypp-media/ng/Provide>
 #include <zypp-media/ng/ProvideSpec>
+#include <zypp-media/ng/provide-configvars.h>
 
 #include <zypp/ng/Context>
 #include <zypp/ng/workflows/logichelpers.h>
@@ -174,6 +177,64 @@ namespace zyppng {
 
   namespace {
 
+    /*!
+     * HTTP validators ( \c ETag, \c Last-Modified ) of a repos master index file,
+     * remembered next to the raw metadata cache. They are only used if the index is
+     * requested from the same URL and the cached index file still has the checksum
+     * of the file the validators were received with.
+     */
+    struct IndexValidators
+    {
+      static constexpr const char *fileName = ".index-validators";
+
+      std::string url;
+      std::string checksum; //< sha1 of the index file
+      std::string etag;
+      std::string lastModified;
+
+      bool empty() const
+      { return etag.empty() && lastModified.empty(); }
+
+      static IndexValidators read( const zypp::Pathname &dir_r )
+      {
+        IndexValidators ret;
+        std::ifstream in( ( dir_r / fileName ).c_str() );
+        std::string line;
+        while ( std::getline( in, line ) ) {
+          const auto sep = line.find( '=' );
+          if ( sep == std::string::npos )
+            continue;
+          const std::string key { line.substr( 0, sep ) };
+          std::string val { line.substr( sep + 1 ) };
+          if ( key == "url" )
+            ret.url = std::move(val);
+          else if ( key == "checksum" )
+            ret.checksum = std::move(val);
+          else if ( key == "etag" )
+            ret.etag = std::move(val);
+          else if ( key == "last-modified" )
+            ret.lastModified = std::move(val);
+        }
+        return ret;
+      }
+
+      void write( const zypp::Pathname &dir_r ) const
+      {
+        const zypp::Pathname file { dir_r / fileName };
+        if ( empty() ) {
+          zypp::filesystem::unlink( file );
+          return;
+        }
+        std::ofstream out( file.c_str() );
+        out << "url=" << url << std::endl
+            << "checksum=" << checksum << std::endl
+            << "etag=" << etag << std::endl
+            << "last-modified=" << lastModified << std::endl;
+        if ( ! out )
+          WAR << "Unable to write " << file << std::endl;
+      }
+    };
+
     template<typename Executor, class OpType>
     struct CheckIfToRefreshMetadataLogic : public LogicBase<Executor, OpType> {
 
@@ -270,30 +331,97 @@ namespace zyppng {
             // make sure to remember the repo type
             _refreshContext->repoInfo().setProbedType( repokind );
 
-            auto dlContext = std::make_shared<repo::DownloadContext<ZyppContextRefType>>( _refreshContext->zyppContext(), _refreshContext->repoInfo(), _refreshContext->targetDir() );
-            return RepoDownloaderWorkflow::repoStatus ( dlContext, _medium )
-              | and_then( [this, dlContext, oldstatus]( zypp::RepoStatus newstatus ){
-                // check status
-                if ( oldstatus == newstatus ) {
-                  MIL << "repo has not changed" << std::endl;
-                  zypp::RepoManagerBaseImpl::touchIndexFile( _refreshContext->repoInfo(), _refreshContext->repoManagerOptions() );
-                  return expected<repo::RefreshCheckStatus>::success(repo::REPO_UP_TO_DATE);
-                }
-                else { // includes newstatus.empty() if e.g. repo format changed
-                  MIL << "repo has changed, going to refresh" << std::endl;
-                  MIL << "Old status: " << oldstatus << " New Status: " << newstatus << std::endl;
-                  return expected<repo::RefreshCheckStatus>::success(repo::REFRESH_NEEDED);
-                }
-              });
+            if constexpr ( zyppng::detail::is_async_op_v<OpType> ) {
+              // The media.1/media file is part of the status in that case, a 304 for the index alone is not enough
+              if ( repokind == zypp::repo::RepoType::RPMMD && !_refreshContext->repoInfo().requireStatusWithMediaFile() )
+                return conditionalIndexCheck( std::move(oldstatus) );
+            }
+            return compareRepoStatus( std::move(oldstatus) );
           });
         });
       }
 
+    private:
+      /*!
+       * Asks the server for the master index using the validators stored along with the raw cache.
+       * A \c 304 answer means the repo is up to date, otherwise the index we just got is compared
+       * as usual and the validators are remembered for the next time.
+       */
+      MaybeAsyncRef<expected<repo::RefreshCheckStatus>> conditionalIndexCheck( zypp::RepoStatus oldstatus ) {
+        const auto &info = _refreshContext->repoInfo();
+        const zypp::Pathname masterIndex { info.path() / "/repodata/repomd.xml" };
+        const zypp::Pathname cachedIndex { zypp::rawproductdata_path_for_repoinfo( _refreshContext->repoManagerOptions(), info ) / "repodata/repomd.xml" };
+        std::string indexUrl { zypp::str::Str() << _medium.baseUrl() << masterIndex };
+
+        ProvideFileSpec spec;
+        const IndexValidators stored { IndexValidators::read( _mediarootpath ) };
+        if ( !stored.empty() && stored.url == indexUrl && stored.checksum == zypp::filesystem::sha1sum( cachedIndex ) ) {
+          DBG << "Conditional request for " << indexUrl << " (etag: " << stored.etag << ", last-modified: " << stored.lastModified << ")" << std::endl;
+          if ( stored.etag.size() )
+            spec.setCustomHeaderValue( std::string(NETWORK_IF_NONE_MATCH), stored.etag );
+          if ( stored.lastModified.size() )
+            spec.setCustomHeaderValue( std::string(NETWORK_IF_MODIFIED_SINCE), stored.lastModified );
+        }
+
+        return _refreshContext->zyppContext()->provider()->provide( _medium, masterIndex, spec )
+          | [this, oldstatus = std::move(oldstatus), indexUrl = std::move(indexUrl)]( expected<ProvideRes> res ) mutable {
+
+            if ( res ) {
+              const auto &hdrs = res->headers();
+              const auto &notModified = hdrs.value( NETWORK_NOT_MODIFIED );
+              if ( notModified.valid() && notModified.isBool() && notModified.asBool() ) {
+                MIL << "repo has not changed (not modified on server)" << std::endl;
+                zypp::RepoManagerBaseImpl::touchIndexFile( _refreshContext->repoInfo(), _refreshContext->repoManagerOptions() );
+                return makeReadyResult( expected<repo::RefreshCheckStatus>::success(repo::REPO_UP_TO_DATE) );
+              }
+
+              const auto &etag = hdrs.value( NETWORK_ETAG );
+              const auto &lastModified = hdrs.value( NETWORK_LAST_MODIFIED );
+              _fetchedValidators.url = std::move(indexUrl);
+              _fetchedValidators.checksum = zypp::filesystem::sha1sum( res->file() );
+              _fetchedValidators.etag = etag.valid() ? etag.asString() : std::string();
+              _fetchedValidators.lastModified = lastModified.valid() ? lastModified.asString() : std::string();
+
+              // keep the file until the status is calculated, the workers cache will serve it again
+              _fetchedIndex = std::move(res.get());
+            }
+            return compareRepoStatus( std::move(oldstatus) );
+          };
+      }
+
+      MaybeAsyncRef<expected<repo::RefreshCheckStatus>> compareRepoStatus( zypp::RepoStatus oldstatus ) {
+        auto dlContext = std::make_shared<repo::DownloadContext<ZyppContextRefType>>( _refreshContext->zyppContext(), _refreshContext->repoInfo(), _refreshContext->targetDir() );
+        return RepoDownloaderWorkflow::repoStatus ( dlContext, _medium )
+          | and_then( [this, dlContext, oldstatus = std::move(oldstatus)]( zypp::RepoStatus newstatus ){
+            _fetchedIndex.reset();
+
+            // check status
+            if ( oldstatus == newstatus ) {
+              MIL << "repo has not changed" << std::endl;
+              zypp::RepoManagerBaseImpl::touchIndexFile( _refreshContext->repoInfo(), _refreshContext->repoManagerOptions() );
+              // the validators describe the index we have in cache
+              if ( !_fetchedValidators.url.empty() )
+                _fetchedValidators.write( _mediarootpath );
+              return expected<repo::RefreshCheckStatus>::success(repo::REPO_UP_TO_DATE);
+            }
+            else { // includes newstatus.empty() if e.g. repo format changed
+              MIL << "repo has changed, going to refresh" << std::endl;
+              MIL << "Old status: " << oldstatus << " New Status: " << newstatus << std::endl;
+              // moved into the raw cache along with the new metadata
+              if ( !_fetchedValidators.url.empty() )
+                _fetchedValidators.write( _refreshContext->targetDir() );
+              return expected<repo::RefreshCheckStatus>::success(repo::REFRESH_NEEDED);
+            }
+          });
+      }
+
     protected:
       RefreshContextRefType _refreshContext;
       ProgressObserverRef _progress;
       MediaHandle _medium;
       zypp::Pathname _mediarootpath;
+      IndexValidators _fetchedValidators;     //< validators received with the index during the check
+      std::optional<ProvideRes> _fetchedIndex;
     };
   }
 
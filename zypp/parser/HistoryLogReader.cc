@@ -11,12 +11,21 @@
  *
  */
 #include <iostream>
+#include <fstream>
+#include <algorithm>
+#include <cctype>
+#include <locale>
+#include <set>
+#include <string_view>
+#include <vector>
 
 #include <utility>
 #include <zypp-core/base/InputStream>
 #include <zypp/base/IOStream.h>
 #include <zypp/base/Logger.h>
 #include <zypp-core/parser/ParseException>
+#include <zypp/PathInfo.h>
+#include <zypp/Date.h>
 
 #include <zypp/parser/HistoryLogReader.h>
 
@@ -28,6 +37,56 @@ namespace zypp
   ///////////////////////////////////////////////////////////////////
   namespace parser
   {
+    namespace
+    {
+      constexpr const char * indexHeader = "# zypp history index v1";
+      constexpr std::string_view::size_type headSize = 32;	//< bytes of the file remembered to detect a rotated log
+      constexpr unsigned otherActionBit = 1u << 31;		//< actions not known as HistoryActionID
+
+      inline std::string_view trimmed( std::string_view str_r )
+      {
+        const auto b = str_r.find_first_not_of( " \t" );
+        if ( b == std::string_view::npos )
+          return std::string_view();
+        return str_r.substr( b, str_r.find_last_not_of( " \t" ) - b + 1 );
+      }
+
+      /** The unescaped date field (like the date check always did). */
+      inline std::string_view dateField( std::string_view line_r )
+      { return line_r.substr( 0, line_r.find( '|' ) ); }
+
+      /** Whether \a date_r is formatted as HISTORY_LOG_DATE_FORMAT, so it can be compared as string. */
+      inline bool isDate( std::string_view date_r )
+      { return date_r.size() == 19 && date_r[4] == '-' && date_r[10] == ' ' && date_r[13] == ':' && ::isdigit( date_r[0] ); }
+
+      /** The trimmed action field, unless an escaped separator would need the real parser. */
+      inline std::string_view actionField( std::string_view line_r )
+      {
+        const auto sep = line_r.find( '|' );
+        if ( sep == std::string_view::npos )
+          return std::string_view();
+        const auto end = line_r.find( '|', sep+1 );
+        if ( line_r.substr( 0, end ).find( '\\' ) != std::string_view::npos )
+          return std::string_view();
+        return trimmed( line_r.substr( sep+1, end == std::string_view::npos ? end : end-sep-1 ) );
+      }
+
+      /** Bit representing \a action_r in the index. */
+      unsigned actionBit( std::string_view action_r )
+      {
+        static const HistoryActionID known[] = {
+          HistoryActionID::INSTALL, HistoryActionID::REMOVE, HistoryActionID::REPO_ADD, HistoryActionID::REPO_REMOVE,
+          HistoryActionID::REPO_CHANGE_ALIAS, HistoryActionID::REPO_CHANGE_URL, HistoryActionID::STAMP_COMMAND,
+          HistoryActionID::PATCH_STATE_CHANGE
+        };
+        for ( const HistoryActionID & id : known )
+        {
+          if ( action_r == id.asString() )
+            return 1u << id.toEnum();
+        }
+        return otherActionBit;
+      }
+    } // namespace
 
   /////////////////////////////////////////////////////////////////////
   //
@@ -42,34 +101,89 @@ namespace zypp
     , _callback( std::move(callback_r) )
     {}
 
-    bool parseLine( const std::string & line_r, unsigned int lineNr_r );
+    bool parseLine( std::string_view line_r, unsigned int lineNr_r );
+
+    /** Process a line if within [from_r,to_r), empty bounds are open; \c false if reading should stop. */
+    bool rangeLine( std::string_view line_r, unsigned lineNr_r, const std::string & from_r, const std::string & to_r, bool & pastFrom_r );
+
+    void readRange( const std::string & from_r, const std::string & to_r, const ProgressData::ReceiverFnc & progress_r );
+    void readIndexed( const std::string & from_r, const std::string & to_r, ProgressData & pd_r );
+    void readReverse( const ProgressData::ReceiverFnc & progress_r );
 
-    void readAll( const ProgressData::ReceiverFnc & progress_r );
-    void readFrom( const Date & date_r, const ProgressData::ReceiverFnc & progress_r );
-    void readFromTo( const Date & fromDate_r, const Date & toDate_r, const ProgressData::ReceiverFnc & progress_r );
+    void readAll( const ProgressData::ReceiverFnc & progress_r )
+    { readRange( std::string(), std::string(), progress_r ); }
+
+    void readFrom( const Date & date_r, const ProgressData::ReceiverFnc & progress_r )
+    { readRange( date_r.form( HISTORY_LOG_DATE_FORMAT ), std::string(), progress_r ); }
+
+    void readFromTo( const Date & fromDate_r, const Date & toDate_r, const ProgressData::ReceiverFnc & progress_r )
+    { readRange( fromDate_r.form( HISTORY_LOG_DATE_FORMAT ), toDate_r.form( HISTORY_LOG_DATE_FORMAT ), progress_r ); }
 
     void addActionFilter( const HistoryActionID & action_r )
     {
       if ( action_r == HistoryActionID::NONE )
+      {
         _actionfilter.clear();
+        _actionmask = 0;
+      }
       else
+      {
         _actionfilter.insert( action_r.asString() );
+        _actionmask |= actionBit( action_r.asString() );
+      }
     }
 
+    /** \name The sidecar index (\see \ref USE_INDEX). */
+    //@{
+    /** Consecutive lines of the same day. */
+    struct DayRun
+    {
+      std::string _day;		///< YYYY-MM-DD
+      std::streamoff _offset;	///< of the 1st line
+      unsigned _lineNo;		///< of the 1st line
+      unsigned _actions;	///< \ref actionBit of all actions in the run
+    };
+
+    Pathname indexFile() const
+    { return _filename.extend( ".idx" ); }
+
+    /** Bring the index up to date, \c false if it can not be used. */
+    bool updateIndex();
+    void loadIndex();
+    void saveIndex() const;
+    void resetIndex();
+    //@}
+
     Pathname _filename;
     Options  _options;
     ProcessData _callback;
-    std::set<std::string> _actionfilter;
+    std::set<std::string,std::less<>> _actionfilter;
+    unsigned _actionmask = 0;
+
+    std::vector<DayRun> _index;
+    std::streamoff _indexedSize = 0;	///< the index covers the file up to here (complete lines)
+    unsigned _indexedLines = 0;		///< number of lines covered
+    std::string _indexedHead;		///< the 1st bytes of the indexed file
+    bool _indexLoaded = false;
   };
 
-  bool HistoryLogReader::Impl::parseLine( const std::string & line_r, unsigned lineNr_r )
+  bool HistoryLogReader::Impl::parseLine( std::string_view line_r, unsigned lineNr_r )
   {
+    // Filtered actions are sorted out without splitting and copying the line.
+    if ( !_actionfilter.empty() )
+    {
+      std::string_view action { actionField( line_r ) };
+      if ( !action.empty() && !_actionfilter.count( action ) )
+        return true;
+    }
+
     // parse into fields
     HistoryLogData::FieldVector fields;
-    str::splitEscaped( line_r, std::back_inserter(fields), "|", true );
+    const std::string line { line_r };
+    str::splitEscaped( line, std::back_inserter(fields), "|", true );
 
     if ( fields.size() < 2 ) {
-      WAR << "Ignore invalid history log entry on line #" << lineNr_r << " '"<< line_r << "'" << endl;
+      WAR << "Ignore invalid history log entry on line #" << lineNr_r << " '"<< line << "'" << endl;
       return true;	// At least an action field[1] is needed!
     }
     fields[1] = str::trim( std::move(fields[1]) );	// for whatever reason writer is padding the action field
@@ -88,12 +202,12 @@ namespace zypp
       ZYPP_CAUGHT( excpt );
       if ( _options.testFlag( IGNORE_INVALID_ITEMS ) )
       {
-        WAR << "Ignore invalid history log entry on line #" << lineNr_r << " '"<< line_r << "'" << endl;
+        WAR << "Ignore invalid history log entry on line #" << lineNr_r << " '"<< line << "'" << endl;
         return true;
       }
       else
       {
-        ERR << "Invalid history log entry on line #" << lineNr_r << " '"<< line_r << "'" << endl;
+        ERR << "Invalid history log entry on line #" << lineNr_r << " '"<< line << "'" << endl;
         ParseException newexcpt( str::Str() << "Error in history log on line #" << lineNr_r );
         newexcpt.remember( excpt );
         ZYPP_THROW( newexcpt );
@@ -109,102 +223,314 @@ namespace zypp
     return true;
   }
 
-  void HistoryLogReader::Impl::readAll( const ProgressData::ReceiverFnc & progress_r )
+  bool HistoryLogReader::Impl::rangeLine( std::string_view line_r, unsigned lineNr_r, const std::string & from_r, const std::string & to_r, bool & pastFrom_r )
   {
-    InputStream is( _filename );
-    iostr::EachLine line( is );
+    // ignore comments
+    if ( !line_r.empty() && line_r[0] == '#' )
+      return true;
+
+    if ( !to_r.empty() || !pastFrom_r )
+    {
+      // HISTORY_LOG_DATE_FORMAT sorts like the date it represents
+      std::string_view date { dateField( line_r ) };
+      if ( isDate( date ) )
+      {
+        // past toDate - stop reading
+        if ( !to_r.empty() && date >= to_r )
+          return false;
+        // past fromDate - start reading
+        if ( !pastFrom_r && date > from_r )
+          pastFrom_r = true;
+      }
+    }
+
+    if ( !pastFrom_r )
+      return true;
+    return parseLine( line_r, lineNr_r );	// false if requested by consumer callback
+  }
 
+  void HistoryLogReader::Impl::readRange( const std::string & from_r, const std::string & to_r, const ProgressData::ReceiverFnc & progress_r )
+  {
     ProgressData pd;
     pd.sendTo( progress_r );
     pd.toMin();
 
-    for ( ; line; line.next(), pd.tick() )
+    if ( _options.testFlag( USE_INDEX ) && ( !from_r.empty() || _actionmask ) && updateIndex() )
     {
-      // ignore comments
-      if ( (*line)[0] == '#' )
-        continue;
+      readIndexed( from_r, to_r, pd );
+    }
+    else
+    {
+      InputStream is( _filename );
+      iostr::EachLine line( is );
 
-      if ( ! parseLine( *line, line.lineNo() ) )
-        break;	// requested by consumer callback
+      bool pastFrom = from_r.empty();
+      for ( ; line; line.next(), pd.tick() )
+      {
+        if ( ! rangeLine( *line, line.lineNo(), from_r, to_r, pastFrom ) )
+          break;
+      }
     }
 
     pd.toMax();
   }
 
-  void HistoryLogReader::Impl::readFrom( const Date & date_r, const ProgressData::ReceiverFnc & progress_r )
+  void HistoryLogReader::Impl::readIndexed( const std::string & from_r, const std::string & to_r, ProgressData & pd_r )
   {
-    InputStream is( _filename );
-    iostr::EachLine line( is );
+    std::ifstream in( _filename.c_str(), std::ios_base::binary );
+    const std::string_view toDay { std::string_view( to_r ).substr( 0, 10 ) };
 
+    // Days before fromDate's day can not contain an entry past fromDate.
+    auto it = _index.begin();
+    if ( !from_r.empty() )
+    {
+      const std::string_view fromDay { std::string_view( from_r ).substr( 0, 10 ) };
+      it = std::find_if( _index.begin(), _index.end(), [&fromDay]( const DayRun & run_r ) { return run_r._day >= fromDay; } );
+    }
+
+    bool pastFrom = from_r.empty();
+    std::string line;
+    for ( ; it != _index.end(); ++it )
+    {
+      // Skip days not containing filtered actions (but not the day we may have to stop at)
+      if ( pastFrom && _actionmask && !( it->_actions & _actionmask ) && ( to_r.empty() || it->_day < toDay ) )
+        continue;
+
+      const std::streamoff end { std::next(it) != _index.end() ? std::next(it)->_offset : _indexedSize };
+      in.clear();
+      in.seekg( it->_offset );
+      unsigned lineNo = it->_lineNo;
+      for ( std::streamoff offset = it->_offset; offset < end && std::getline( in, line ); offset += line.size() + 1, ++lineNo, pd_r.tick() )
+      {
+        if ( ! rangeLine( line, lineNo, from_r, to_r, pastFrom ) )
+          return;
+      }
+    }
+
+    // Lines not yet indexed (an incomplete last line)
+    in.clear();
+    in.seekg( _indexedSize );
+    for ( unsigned lineNo = _indexedLines + 1; std::getline( in, line ); ++lineNo, pd_r.tick() )
+    {
+      if ( ! rangeLine( line, lineNo, from_r, to_r, pastFrom ) )
+        return;
+    }
+  }
+
+  void HistoryLogReader::Impl::readReverse( const ProgressData::ReceiverFnc & progress_r )
+  {
     ProgressData pd;
     pd.sendTo( progress_r );
     pd.toMin();
 
-    bool pastDate = false;
-    for ( ; line; line.next(), pd.tick() )
+    std::ifstream in( _filename.c_str(), std::ios_base::binary );
+    if ( ! in )
     {
-      const std::string & s = *line;
+      WAR << "Unable to read " << _filename << endl;
+      pd.toMax();
+      return;
+    }
 
-      // ignore comments
-      if ( s[0] == '#' )
-        continue;
+    constexpr std::streamoff chunkSize = 64 * 1024;
+    in.seekg( 0, std::ios_base::end );
+    std::streamoff pos = in.tellg();
 
-      if ( pastDate )
-      {
-        if ( ! parseLine( s, line.lineNo() ) )
-          break;	// requested by consumer callback
-      }
-      else
+    // buf holds the unprocessed part of the file [pos,pos+buf.size()) without
+    // the newline terminating its last line.
+    std::string buf;
+    bool atEof = true;
+    unsigned lineNo = 0;
+    while ( true )
+    {
+      std::string::size_type nl = buf.rfind( '\n' );
+      if ( nl == std::string::npos && pos > 0 )
       {
-        Date logDate( s.substr( 0, s.find('|') ), HISTORY_LOG_DATE_FORMAT );
-        if ( logDate > date_r )
+        const std::streamoff n { std::min( chunkSize, pos ) };
+        pos -= n;
+        std::string chunk( n, '\0' );
+        in.seekg( pos );
+        if ( ! in.read( chunk.data(), n ) )
+        {
+          ERR << "Error reading " << _filename << endl;
+          break;
+        }
+        if ( atEof )
         {
-          pastDate = true;
-          if ( ! parseLine( s, line.lineNo() ) )
-            break;	// requested by consumer callback
+          if ( !chunk.empty() && chunk.back() == '\n' )
+            chunk.pop_back();
+          atEof = false;
         }
+        buf.insert( 0, chunk );
+        continue;
+      }
+
+      if ( nl == std::string::npos && buf.empty() )
+        break;	// file start reached
+
+      std::string_view line { std::string_view( buf ).substr( nl == std::string::npos ? 0 : nl+1 ) };
+      ++lineNo;
+      pd.tick();
+      if ( line.empty() || line[0] != '#' )
+      {
+        if ( ! parseLine( line, lineNo ) )
+          break;	// requested by consumer callback
       }
+      if ( nl == std::string::npos )
+        break;
+      buf.resize( nl );
     }
 
     pd.toMax();
   }
 
-  void HistoryLogReader::Impl::readFromTo( const Date & fromDate_r, const Date & toDate_r, const ProgressData::ReceiverFnc & progress_r )
+  void HistoryLogReader::Impl::resetIndex()
   {
-    InputStream is( _filename );
-    iostr::EachLine line( is );
+    _index.clear();
+    _indexedSize = 0;
+    _indexedLines = 0;
+    _indexedHead.clear();
+  }
 
-    ProgressData pd;
-    pd.sendTo( progress_r );
-    pd.toMin();
+  void HistoryLogReader::Impl::loadIndex()
+  {
+    _indexLoaded = true;
+    std::ifstream in( indexFile().c_str() );
+    if ( ! in )
+      return;
+    in.imbue( std::locale::classic() );
+
+    std::string line;
+    if ( ! std::getline( in, line ) || line != indexHeader )
+      return;
+
+    std::string tag;
+    if ( ! ( in >> tag >> _indexedSize >> _indexedLines ) || tag != "size" )
+    {
+      resetIndex();
+      return;
+    }
+    in.get(); // ' ' or '\n'
+    std::getline( in, _indexedHead );	// the rest of the line
+
+    DayRun run;
+    while ( in >> run._day >> run._offset >> run._lineNo >> run._actions )
+      _index.push_back( run );
 
-    bool pastFromDate = false;
-    for ( ; line; line.next(), pd.tick() )
+    if ( ! in.eof() )
     {
-      const std::string & s = *line;
+      WAR << "Ignore malformed history index " << indexFile() << endl;
+      resetIndex();
+      return;
+    }
+    DBG << "Loaded history index " << indexFile() << " (" << _index.size() << " days)" << endl;
+  }
 
-      // ignore comments
-      if ( s[0] == '#' )
-        continue;
+  void HistoryLogReader::Impl::saveIndex() const
+  {
+    const Pathname file { indexFile() };
+    const Pathname tmpfile { file.extend( ".new" ) };
+    {
+      std::ofstream out( tmpfile.c_str(), std::ios_base::out | std::ios_base::trunc );
+      if ( ! out )
+      {
+        // e.g. no permission as non root user, that's fine.
+        DBG << "Unable to write history index " << file << endl;
+        return;
+      }
+      out.imbue( std::locale::classic() );
+      out << indexHeader << '\n';
+      out << "size " << _indexedSize << ' ' << _indexedLines << ' ' << _indexedHead << '\n';
+      for ( const DayRun & run : _index )
+        out << run._day << ' ' << run._offset << ' ' << run._lineNo << ' ' << run._actions << '\n';
+      if ( ! out.flush() )
+      {
+        WAR << "Unable to write history index " << file << endl;
+        filesystem::unlink( tmpfile );
+        return;
+      }
+    }
+    if ( filesystem::rename( tmpfile, file ) != 0 )
+    {
+      WAR << "Unable to replace history index " << file << endl;
+      filesystem::unlink( tmpfile );
+    }
+  }
 
-      Date logDate( s.substr( 0, s.find('|') ), HISTORY_LOG_DATE_FORMAT );
+  bool HistoryLogReader::Impl::updateIndex()
+  {
+    PathInfo pi( _filename );
+    if ( ! pi.isFile() )
+      return false;
 
-      // past toDate - stop reading
-      if ( logDate >= toDate_r )
-        break;
+    std::ifstream in( _filename.c_str(), std::ios_base::binary );
+    if ( ! in )
+      return false;
 
-      // past fromDate - start reading
-      if ( !pastFromDate && logDate > fromDate_r )
-        pastFromDate = true;
+    if ( ! _indexLoaded )
+      loadIndex();
 
-      if ( pastFromDate )
+    // The log is appended only. If it shrunk or its start changed, it was rotated.
+    if ( _indexedSize )
+    {
+      bool valid = std::streamoff( pi.size() ) >= _indexedSize;
+      if ( valid )
       {
-        if ( ! parseLine( s, line.lineNo() ) )
-          break;	// requested by consumer callback
+        in.seekg( _indexedSize - 1 );
+        valid = ( in.get() == '\n' );
       }
+      if ( valid )
+      {
+        std::string head( _indexedHead.size(), '\0' );
+        in.seekg( 0 );
+        valid = in.read( head.data(), head.size() ) && head == _indexedHead;
+      }
+      if ( ! valid )
+      {
+        MIL << "Rebuild history index for " << _filename << endl;
+        resetIndex();
+      }
+      in.clear();
     }
 
-    pd.toMax();
+    if ( std::streamoff( pi.size() ) == _indexedSize )
+      return true;
+
+    const std::streamoff before { _indexedSize };
+    in.seekg( _indexedSize );
+    std::string line;
+    while ( std::getline( in, line ) )
+    {
+      if ( in.eof() )
+        break;	// incomplete last line, indexed next time
+
+      if ( _indexedSize == 0 )
+        _indexedHead = line.substr( 0, headSize );
+      ++_indexedLines;
+
+      if ( !line.empty() && line[0] != '#' )
+      {
+        std::string_view date { dateField( line ) };
+        if ( isDate( date ) )
+        {
+          std::string_view day { date.substr( 0, 10 ) };
+          if ( _index.empty() || _index.back()._day != day )
+            _index.push_back( DayRun{ std::string( day ), _indexedSize, _indexedLines, 0 } );
+        }
+        if ( !_index.empty() )
+        {
+          std::string_view action { actionField( line ) };
+          _index.back()._actions |= ( action.empty() ? otherActionBit : actionBit( action ) );
+        }
+      }
+      _indexedSize += line.size() + 1;
+    }
+
+    if ( _indexedSize != before )
+    {
+      DBG << "Indexed " << _filename << " up to " << _indexedSize << " (" << _index.size() << " days)" << endl;
+      saveIndex();
+    }
+    return true;
   }
 
   /////////////////////////////////////////////////////////////////////
@@ -235,6 +561,9 @@ namespace zypp
   void HistoryLogReader::readFromTo( const Date & fromDate_r, const Date & toDate_r, const ProgressData::ReceiverFnc & progress_r )
   { _pimpl->readFromTo( fromDate_r, toDate_r, progress_r ); }
 
+  void HistoryLogReader::readReverse( const ProgressData::ReceiverFnc & progress_r )
+  { _pimpl->readReverse( progress_r ); }
+
   void HistoryLogReader::addActionFilter( const HistoryActionID & action_r )
   { _pimpl->addActionFilter( action_r ); }
 
@@ -62,6 +62,12 @@ namespace zypp
   /// \endcode
   /// \see \ref HistoryLogData for how to access the individual data fields.
   ///
+  /// Lines are pre-checked against the date range and action filter without
+  /// splitting them into fields, so only the lines actually passed to the
+  /// callback are parsed. With \ref USE_INDEX a sidecar index of per day
+  /// offsets is maintained, so date range reads can seek to the 1st day of
+  /// interest and skip days without any of the filtered actions.
+  ///
   ///////////////////////////////////////////////////////////////////
   class ZYPP_API HistoryLogReader
   {
@@ -69,7 +75,8 @@ namespace zypp
 
     enum OptionBits	///< Parser option flags
     {
-      IGNORE_INVALID_ITEMS	= (1 << 0)	///< ignore invalid items and continue parsing
+      IGNORE_INVALID_ITEMS	= (1 << 0),	///< ignore invalid items and continue parsing
+      USE_INDEX			= (1 << 1)	///< maintain and use the sidecar index \c <historyfile>.idx
     };
     ZYPP_DECLARE_FLAGS( Options, OptionBits );
 
@@ -125,6 +132,17 @@ namespace zypp
      */
     void readFromTo( const Date & fromDate, const Date & toDate, const ProgressData::ReceiverFnc & progress = ProgressData::ReceiverFnc() );
 
+    /**
+     * Read the log backwards, the latest entry first.
+     *
+     * To get just the latest N entries, let the callback return \c false
+     * after the Nth one. Line numbers mentioned in messages and exceptions
+     * are counted from the end of the file.
+     *
+     * \param progress An optional progress data receiver function.
+     */
+    void readReverse( const ProgressData::ReceiverFnc & progress = ProgressData::ReceiverFnc() );
+
     /**
      * Set the reader to ignore invalid log entries and continue with the rest.
      *
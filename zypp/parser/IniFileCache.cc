@@ -0,0 +1,331 @@
+/*---------------------------------------------------------------------\
+|                          ____ _   __ __ ___                          |
+|                         |__  / \ / / . \ . \                         |
+|                           / / \ V /|  _/  _/                         |
+|                          / /__ | | | | | |                           |
+|                         /_____||_| |_| |_|                           |
+|                                                                      |
+\---------------------------------------------------------------------*/
+/** \file	zypp/parser/IniFileCache.cc
+ *
+*/
+extern "C"
+{
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+}
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <cstring>
+#include <cerrno>
+
+#include <zypp/base/LogTools.h>
+#include <zypp/PathInfo.h>
+#include <zypp-core/base/InputStream>
+
+#include <zypp/parser/IniFileCache.h>
+
+using std::endl;
+
+///////////////////////////////////////////////////////////////////
+namespace zypp
+{
+  ///////////////////////////////////////////////////////////////////
+  namespace parser
+  {
+    namespace
+    {
+      constexpr const char fileMagic[] = "zypp-inifilecache-1\n";
+
+      inline uint64_t nsec( const struct timespec & ts_r )
+      { return uint64_t(ts_r.tv_sec) * 1000000000ULL + ts_r.tv_nsec; }
+
+      /** The \ref IniFileCache::StatKey of \a file_r, \c false if it can not be stat'ed. */
+      bool statKey( const Pathname & file_r, IniFileCache::StatKey & key_r )
+      {
+        struct stat st;
+        if ( ::stat( file_r.c_str(), &st ) != 0 || ! S_ISREG( st.st_mode ) )
+          return false;
+        key_r.dev   = st.st_dev;
+        key_r.ino   = st.st_ino;
+        key_r.size  = st.st_size;
+        key_r.mtime = nsec( st.st_mtim );
+        key_r.ctime = nsec( st.st_ctim );
+        key_r.mode  = st.st_mode;
+        return true;
+      }
+
+      ///////////////////////////////////////////////////////////////////
+      /// Native byte order, length prefixed strings. The file is a local
+      /// cache, it is not meant to be shared between machines.
+      ///////////////////////////////////////////////////////////////////
+      struct Writer
+      {
+        template <class Tp>
+        void put( Tp val_r )
+        { _buf.append( reinterpret_cast<const char *>(&val_r), sizeof(Tp) ); }
+
+        void put( const std::string & val_r )
+        { put<uint32_t>( val_r.size() ); _buf.append( val_r ); }
+
+        std::string _buf;
+      };
+
+      struct Reader
+      {
+        Reader( const std::string & buf_r )
+        : _buf( buf_r )
+        {}
+
+        template <class Tp>
+        Tp get()
+        {
+          need( sizeof(Tp) );
+          Tp ret;
+          ::memcpy( &ret, _buf.data() + _pos, sizeof(Tp) );
+          _pos += sizeof(Tp);
+          return ret;
+        }
+
+        std::string getString()
+        {
+          uint32_t len = get<uint32_t>();
+          need( len );
+          std::string ret( _buf, _pos, len );
+          _pos += len;
+          return ret;
+        }
+
+        bool atEnd() const
+        { return _pos == _buf.size(); }
+
+      private:
+        void need( size_t n_r )
+        {
+          if ( _buf.size() - _pos < n_r )
+            throw std::out_of_range( "truncated" );
+        }
+
+        const std::string & _buf;
+        size_t _pos = 0;
+      };
+    } // namespace
+
+    IniFileCache::IniFileCache( Pathname file_r )
+    : _file( std::move(file_r) )
+    { load(); }
+
+    const IniParser::Recording * IniFileCache::recording( const Pathname & file_r )
+    {
+      StatKey key;
+      if ( ! statKey( file_r, key ) )
+        return nullptr;
+
+      Entry & entry { _entries[file_r.asString()] };
+      if ( ! ( entry.key == key ) )
+      {
+        InputStream is( file_r );
+        if ( is.stream().fail() )
+        {
+          _entries.erase( file_r.asString() );
+          _dirty = true;
+          return nullptr;
+        }
+        entry.recording = IniParser::record( is );
+        entry.key = key;
+        ++_misses;
+        _dirty = true;
+      }
+      entry.used = true;
+      return &entry.recording;
+    }
+
+    void IniFileCache::load()
+    {
+      if ( _file.empty() )
+        return;
+
+      PathInfo pi( _file );
+      if ( ! pi.isFile() )
+        return;
+      if ( ! pi.userMayR() )
+      {
+        // e.g. non root user, the cache is written by root.
+        DBG << "Unable to read ini file cache " << _file << endl;
+        return;
+      }
+
+      std::ifstream in( _file.c_str(), std::ios_base::in | std::ios_base::binary );
+      std::ostringstream buf;
+      if ( ! ( in && buf << in.rdbuf() ) )
+      {
+        WAR << "Unable to read ini file cache " << _file << endl;
+        return;
+      }
+
+      const std::string & data { buf.str() };
+      if ( data.compare( 0, sizeof(fileMagic)-1, fileMagic ) != 0 )
+      {
+        WAR << "Discard ini file cache " << _file << ": unknown format" << endl;
+        _dirty = true;
+        return;
+      }
+
+      try
+      {
+        Reader reader( data );
+        for ( unsigned i = 0; i < sizeof(fileMagic)-1; ++i )
+          reader.get<char>();
+
+        for ( uint32_t files = reader.get<uint32_t>(); files; --files )
+        {
+          std::string path { reader.getString() };
+          Entry entry;
+          entry.key.dev   = reader.get<uint64_t>();
+          entry.key.ino   = reader.get<uint64_t>();
+          entry.key.size  = reader.get<uint64_t>();
+          entry.key.mtime = reader.get<uint64_t>();
+          entry.key.ctime = reader.get<uint64_t>();
+          entry.key.mode  = reader.get<uint32_t>();
+
+          uint32_t events = reader.get<uint32_t>();
+          entry.recording.reserve( std::min<uint32_t>( events, data.size() ) );
+          for ( ; events; --events )
+          {
+            IniParser::Event event;
+            char type = reader.get<char>();
+            if ( type != IniParser::Event::Section && type != IniParser::Event::Entry && type != IniParser::Event::Garbage )
+              throw std::out_of_range( "bad event type" );
+            event.type    = IniParser::Event::Type(type);
+            event.lineNo  = reader.get<int32_t>();
+            event.section = reader.getString();
+            event.key     = reader.getString();
+            event.value   = reader.getString();
+            entry.recording.push_back( std::move(event) );
+          }
+          _entries[path] = std::move(entry);
+        }
+        if ( ! reader.atEnd() )
+          throw std::out_of_range( "trailing data" );
+      }
+      catch ( const std::exception & excpt )
+      {
+        WAR << "Discard corrupt ini file cache " << _file << ": " << excpt.what() << endl;
+        _entries.clear();
+        _dirty = true;
+        return;
+      }
+      DBG << "Loaded " << _entries.size() << " files from ini file cache " << _file << endl;
+    }
+
+    void IniFileCache::save()
+    {
+      // Drop files no longer asked for (e.g. removed .repo files).
+      for ( auto it = _entries.begin(); it != _entries.end(); )
+      {
+        if ( it->second.used )
+          ++it;
+        else
+        {
+          it = _entries.erase( it );
+          _dirty = true;
+        }
+      }
+
+      if ( ! _dirty || _file.empty() )
+        return;
+
+      if ( filesystem::assert_dir( _file.dirname() ) != 0 )
+      {
+        DBG << "Unable to create directory for " << _file << endl;
+        return;
+      }
+
+      // The cache may contain data (e.g. credentials in urls) from files
+      // not readable by everyone. Don't expose them.
+      bool worldReadable = true;
+      Writer writer;
+      writer._buf.append( fileMagic, sizeof(fileMagic)-1 );
+      writer.put<uint32_t>( _entries.size() );
+      for ( const auto & [ path, entry ] : _entries )
+      {
+        if ( ! ( entry.key.mode & S_IROTH ) )
+          worldReadable = false;
+        writer.put( path );
+        writer.put<uint64_t>( entry.key.dev );
+        writer.put<uint64_t>( entry.key.ino );
+        writer.put<uint64_t>( entry.key.size );
+        writer.put<uint64_t>( entry.key.mtime );
+        writer.put<uint64_t>( entry.key.ctime );
+        writer.put<uint32_t>( entry.key.mode );
+        writer.put<uint32_t>( entry.recording.size() );
+        for ( const IniParser::Event & event : entry.recording )
+        {
+          writer.put<char>( event.type );
+          writer.put<int32_t>( event.lineNo );
+          writer.put( event.section );
+          writer.put( event.key );
+          writer.put( event.value );
+        }
+      }
+
+      const Pathname tmpfile { _file.extend( ".new" ) };
+      {
+        // Create the file with its final mode, so nobody can open it before
+        // the data are written.
+        const mode_t mode = worldReadable ? 0644 : 0600;
+        filesystem::unlink( tmpfile );
+        int fd = ::open( tmpfile.c_str(), O_CREAT|O_EXCL|O_WRONLY|O_CLOEXEC, mode );
+        if ( fd < 0 )
+        {
+          // e.g. no permission as non root user, that's fine.
+          DBG << "Unable to write ini file cache " << _file << endl;
+          return;
+        }
+        ::fchmod( fd, mode );	// not restricted by the umask
+
+        bool ok = true;
+        for ( const char * data = writer._buf.data(), * end = data + writer._buf.size(); data != end; )
+        {
+          ssize_t written = ::write( fd, data, end - data );
+          if ( written < 0 )
+          {
+            if ( errno == EINTR )
+              continue;
+            ok = false;
+            break;
+          }
+          data += written;
+        }
+        if ( ::close( fd ) != 0 )
+          ok = false;
+        if ( ! ok )
+        {
+          WAR << "Unable to write ini file cache " << _file << endl;
+          filesystem::unlink( tmpfile );
+          return;
+        }
+      }
+
+      if ( filesystem::rename( tmpfile, _file ) != 0 )
+      {
+        WAR << "Unable to replace ini file cache " << _file << endl;
+        filesystem::unlink( tmpfile );
+        return;
+      }
+      DBG << "Saved " << _entries.size() << " files to ini file cache " << _file << endl;
+      _dirty = false;
+    }
+
+    std::ostream & operator<<( std::ostream & str, const IniFileCache & obj )
+    {
+      return str << "IniFileCache(" << obj._file << "){files " << obj._entries.size() << ", parsed " << obj._misses << "}";
+    }
+
+  } // namespace parser
+  ///////////////////////////////////////////////////////////////////
+} // namespace zypp
+///////////////////////////////////////////////////////////////////
@@ -0,0 +1,116 @@
+/*---------------------------------------------------------------------\
+|                          ____ _   __ __ ___                          |
+|                         |__  / \ / / . \ . \                         |
+|                           / / \ V /|  _/  _/                         |
+|                          / /__ | | | | | |                           |
+|                         /_____||_| |_| |_|                           |
+|                                                                      |
+\---------------------------------------------------------------------*/
+/** \file	zypp/parser/IniFileCache.h
+ *
+*/
+#ifndef ZYPP_PARSER_INIFILECACHE_H
+#define ZYPP_PARSER_INIFILECACHE_H
+
+#include <iosfwd>
+#include <cstdint>
+#include <unordered_map>
+
+#include <zypp/Globals.h>
+#include <zypp/Pathname.h>
+#include <zypp-core/parser/IniParser>
+
+///////////////////////////////////////////////////////////////////
+namespace zypp
+{
+  ///////////////////////////////////////////////////////////////////
+  namespace parser
+  {
+    ///////////////////////////////////////////////////////////////////
+    /// \class IniFileCache
+    /// \brief Persistent cache of parsed ini files (\c .repo and \c .service files).
+    ///
+    /// Remembers the \ref IniParser::Recording of each file. A file is parsed
+    /// again only if its device, inode, size, mtime or ctime changed. The readers
+    /// replay the recording, so they build exactly the same \ref RepoInfo and
+    /// \ref ServiceInfo objects as when parsing the file.
+    ///
+    /// The cache is loaded from \a file_r on construction and written back
+    /// by \ref save, dropping all entries not asked for since. A cache file
+    /// which can not be read is discarded.
+    ///
+    /// \code
+    ///   IniFileCache cache( "/var/cache/zypp/repofiles.cache" );
+    ///   RepoFileReader( "/etc/zypp/repos.d/foo.repo", cache, callback );
+    ///   cache.save();
+    /// \endcode
+    ///////////////////////////////////////////////////////////////////
+    class ZYPP_TESTS IniFileCache
+    {
+      friend std::ostream & operator<<( std::ostream & str, const IniFileCache & obj );
+
+    public:
+      /** Ctor loading the cache from \a file_r, an empty path keeps the data in memory only. */
+      explicit IniFileCache( Pathname file_r );
+
+      IniFileCache( const IniFileCache & ) = delete;
+      IniFileCache & operator=( const IniFileCache & ) = delete;
+
+      /** The recording of \a file_r, parsing the file if it is not cached or changed.
+       * \c nullptr if the file can not be accessed. The pointer is valid until
+       * \ref save is called.
+       */
+      const IniParser::Recording * recording( const Pathname & file_r );
+
+      /** Write the cache back to the file if it was changed. */
+      void save();
+
+    public:
+      /** Number of files parsed since construction. */
+      unsigned misses() const
+      { return _misses; }
+
+      /** Number of cached files. */
+      unsigned size() const
+      { return _entries.size(); }
+
+    public:
+      /** What a cached file must match to be valid. */
+      struct StatKey
+      {
+        uint64_t dev = 0;
+        uint64_t ino = 0;
+        uint64_t size = 0;
+        uint64_t mtime = 0;	///< in ns
+        uint64_t ctime = 0;	///< in ns
+        uint32_t mode = 0;
+
+        bool operator==( const StatKey & rhs ) const
+        { return dev == rhs.dev && ino == rhs.ino && size == rhs.size && mtime == rhs.mtime && ctime == rhs.ctime && mode == rhs.mode; }
+      };
+
+    private:
+      struct Entry
+      {
+        StatKey key;
+        IniParser::Recording recording;
+        bool used = false;
+      };
+
+      void load();
+
+    private:
+      Pathname _file;
+      std::unordered_map<std::string, Entry> _entries;
+      unsigned _misses = 0;
+      bool _dirty = false;
+    };
+
+    /** \relates IniFileCache Stream output */
+    std::ostream & operator<<( std::ostream & str, const IniFileCache & obj ) ZYPP_TESTS;
+
+  } // namespace parser
+  ///////////////////////////////////////////////////////////////////
+} // namespace zypp
+///////////////////////////////////////////////////////////////////
+#endif // ZYPP_PARSER_INIFILECACHE_H
@@ -19,6 +19,7 @@
 
 #include <zypp-core/parser/IniDict>
 #include <zypp/parser/RepoFileReader.h>
+#include <zypp/parser/IniFileCache.h>
 
 using std::endl;
 
@@ -41,6 +42,9 @@ namespace zypp
         RepoFileParser( const InputStream & is_r )
         { read( is_r ); }
 
+        RepoFileParser( const IniParser::Recording & recording_r, const std::string & inputname_r )
+        { replay( recording_r, inputname_r ); }
+
         using IniDict::consume;	// don't hide overloads we don't redefine here
 
         void consume( const std::string & section_r, const std::string & key_r, const std::string & value_r ) override
@@ -136,11 +140,10 @@ namespace zypp
    * \short List of RepoInfo's from a file.
    * \param file pathname of the file to read.
    */
-    static void repositories_in_stream( const InputStream &is,
-                                        const RepoFileReader::ProcessRepo &callback,
-                                        const ProgressData::ReceiverFnc &progress )
-    try {
-      RepoFileParser dict(is);
+    static void repositories_in_dict( RepoFileParser & dict,
+                                      const Pathname & path,
+                                      const RepoFileReader::ProcessRepo &callback )
+    {
       for_( its, dict.sectionsBegin(), dict.sectionsEnd() )
       {
         RepoInfo info;
@@ -214,7 +217,7 @@ namespace zypp
           info.setMetalinkUrls( std::move(dict.metalink( *its )) );
 
 
-        info.setFilepath(is.path());
+        info.setFilepath(path);
         MIL << info << endl;
         // add it to the list.
         callback(info);
@@ -222,11 +225,41 @@ namespace zypp
         //  ZYPP_THROW(AbortRequestException());
       }
     }
+
+    static void repositories_in_stream( const InputStream &is,
+                                        const RepoFileReader::ProcessRepo &callback,
+                                        const ProgressData::ReceiverFnc &progress )
+    try {
+      RepoFileParser dict(is);
+      repositories_in_dict( dict, is.path(), callback );
+    }
     catch ( Exception & ex ) {
       ex.addHistory( "Parsing .repo file "+is.name() );
       ZYPP_RETHROW( ex );
     }
 
+    static void repositories_in_cache( const Pathname & repo_file,
+                                       IniFileCache & cache,
+                                       const RepoFileReader::ProcessRepo &callback )
+    {
+      const IniParser::Recording * recording { cache.recording( repo_file ) };
+      if ( ! recording )
+      {
+        // Not accessible: let the stream parser report it.
+        repositories_in_stream( InputStream(repo_file), callback, ProgressData::ReceiverFnc() );
+        return;
+      }
+
+      try {
+        RepoFileParser dict( *recording, repo_file.asString() );
+        repositories_in_dict( dict, repo_file, callback );
+      }
+      catch ( Exception & ex ) {
+        ex.addHistory( "Parsing .repo file "+repo_file.asString() );
+        ZYPP_RETHROW( ex );
+      }
+    }
+
     ///////////////////////////////////////////////////////////////////
     //
     //	CLASS NAME : RepoFileReader
@@ -241,6 +274,14 @@ namespace zypp
       repositories_in_stream(InputStream(repo_file), _callback, progress);
     }
 
+    RepoFileReader::RepoFileReader( const Pathname & repo_file,
+                                    IniFileCache & cache,
+                                    ProcessRepo  callback )
+      : _callback(std::move(callback))
+    {
+      repositories_in_cache(repo_file, cache, _callback);
+    }
+
     RepoFileReader::RepoFileReader( const InputStream &is,
                                     ProcessRepo  callback,
                                     const ProgressData::ReceiverFnc &progress )
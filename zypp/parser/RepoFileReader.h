@@ -25,6 +25,7 @@ namespace zypp
   ///////////////////////////////////////////////////////////////////
   namespace parser
   { /////////////////////////////////////////////////////////////////
+    class IniFileCache;
 
     /**
      * \short Read repository data from a .repo file
@@ -82,6 +83,24 @@ namespace zypp
                       ProcessRepo  callback,
                       const ProgressData::ReceiverFnc &progress = ProgressData::ReceiverFnc() );
 
+     /**
+      * \short Constructor. Creates the reader and start reading.
+      *
+      * Like the \ref Pathname ctor, but the file is parsed only if
+      * \a cache does not remember it.
+      *
+      * \param repo_file A valid .repo file
+      * \param cache The cache of parsed files.
+      * \param callback Callback that will be called for each repository.
+      *
+      * \throws AbortRequestException If the callback returns false
+      * \throws Exception If a error occurs at reading / parsing
+      *
+      */
+      RepoFileReader( const Pathname & repo_file,
+                      IniFileCache & cache,
+                      ProcessRepo  callback );
+
      /**
       * \short Constructor. Creates the reader and start reading.
       *
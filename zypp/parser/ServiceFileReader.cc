@@ -18,6 +18,7 @@
 
 #include <zypp-core/parser/IniDict>
 #include <zypp/parser/ServiceFileReader.h>
+#include <zypp/parser/IniFileCache.h>
 #include <zypp/ServiceInfo.h>
 
 using std::endl;
@@ -34,20 +35,31 @@ namespace zypp
     {
     public:
       static void parseServices( const Pathname & file,
-          const ServiceFileReader::ProcessService & callback );
+          const ServiceFileReader::ProcessService & callback,
+          IniFileCache * cache = nullptr );
     };
 
     void ServiceFileReader::Impl::parseServices( const Pathname & file,
-                                  const ServiceFileReader::ProcessService & callback/*,
+                                  const ServiceFileReader::ProcessService & callback,
+                                  IniFileCache * cache/*,
                                   const ProgressData::ReceiverFnc &progress*/ )
     try {
-      InputStream is(file);
-      if( is.stream().fail() )
+      parser::IniDict dict;
+      const IniParser::Recording * recording { cache ? cache->recording( file ) : nullptr };
+      if ( recording )
       {
-        ZYPP_THROW(Exception("Failed to open service file"));
+        dict.replay( *recording, file.asString() );
+      }
+      else
+      {
+        InputStream is(file);
+        if( is.stream().fail() )
+        {
+          ZYPP_THROW(Exception("Failed to open service file"));
+        }
+        dict.read( is );
       }
 
-      parser::IniDict dict(is);
       for ( parser::IniDict::section_const_iterator its = dict.sectionsBegin();
             its != dict.sectionsEnd();
             ++its )
@@ -167,6 +179,13 @@ namespace zypp
       //MIL << "Done" << endl;
     }
 
+    ServiceFileReader::ServiceFileReader( const Pathname & repo_file,
+                                          IniFileCache & cache,
+                                          const ProcessService & callback )
+    {
+      Impl::parseServices(repo_file, callback, &cache);
+    }
+
     ServiceFileReader::~ServiceFileReader()
     {}
 
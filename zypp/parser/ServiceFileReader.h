@@ -26,6 +26,7 @@ namespace zypp
   ///////////////////////////////////////////////////////////////////
   namespace parser
   { /////////////////////////////////////////////////////////////////
+    class IniFileCache;
 
     /**
      * \short Read service data from a .service file
@@ -71,6 +72,16 @@ namespace zypp
       ServiceFileReader( const Pathname & serviceFile,
                       const ProcessService & callback);
 
+     /**
+      * \short Constructor. Creates the reader and start reading.
+      *
+      * Like the \ref Pathname ctor, but the file is parsed only if
+      * \a cache does not remember it.
+      */
+      ServiceFileReader( const Pathname & serviceFile,
+                      IniFileCache & cache,
+                      const ProcessService & callback);
+
       /**
        * Dtor
        */
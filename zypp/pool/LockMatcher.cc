@@ -0,0 +1,187 @@
+/*---------------------------------------------------------------------\
+|                          ____ _   __ __ ___                          |
+|                         |__  / \ / / . \ . \                         |
+|                           / / \ V /|  _/  _/                         |
+|                          / /__ | | | | | |                           |
+|                         /_____||_| |_| |_|                           |
+|                                                                      |
+\---------------------------------------------------------------------*/
+/** \file	zypp/pool/LockMatcher.cc
+ *
+*/
+#include <iostream>
+#include <algorithm>
+#include <set>
+#include <unordered_set>
+
+#include <zypp/base/LogTools.h>
+#include <zypp/sat/Pool.h>
+#include <zypp/sat/SolvAttr.h>
+#include <zypp/Repository.h>
+
+#include <zypp/pool/LockMatcher.h>
+
+using std::endl;
+
+///////////////////////////////////////////////////////////////////
+namespace zypp
+{
+  ///////////////////////////////////////////////////////////////////
+  namespace pool
+  {
+    namespace
+    {
+      /** The kinds a lock without kind restriction must be indexed for. */
+      const std::vector<ResKind> & knownKinds()
+      {
+        static const std::vector<ResKind> _kinds {
+          ResKind::package, ResKind::patch, ResKind::pattern, ResKind::product, ResKind::application
+        };
+        return _kinds;
+      }
+
+      /** Whether \a query_r is a plain name lock which can be indexed by ident.
+       * We rebuild the query from the names and kinds and let \ref PoolQuery::operator==
+       * decide (like \c makeTrivialQuery in PoolImpl.h, which unifies glob and exact
+       * name matches). Queries with other attributes, edition, repo or status
+       * restrictions are not equal.
+       */
+      bool isPlainNameQuery( const PoolQuery & query_r )
+      {
+        if ( ! query_r.caseSensitive() || ! ( query_r.matchExact() || query_r.matchGlob() ) )
+          return false;
+
+        const PoolQuery::AttrRawStrMap & attrs { query_r.attributes() };
+        if ( attrs.size() != 1 || attrs.begin()->first != sat::SolvAttr::name || attrs.begin()->second.empty() )
+          return false;
+
+        PoolQuery trivial;
+        for ( const std::string & name : attrs.begin()->second )
+        {
+          // A glob with wildcards is not a plain name; a kind prefix is not part of the ident we index.
+          if ( name.empty() || name.find_first_of( "*?[\\:" ) != std::string::npos )
+            return false;
+          trivial.addAttribute( sat::SolvAttr::name, name );
+        }
+        for ( const ResKind & kind : query_r.kinds() )
+          trivial.addKind( kind );
+        trivial.setMatchExact();
+        trivial.setCaseSensitive( true );
+        return query_r == trivial;
+      }
+    } // namespace
+
+    LockMatcher::LockMatcher()
+    {}
+
+    void LockMatcher::add( const PoolQuery & query_r )
+    {
+      if ( ! isPlainNameQuery( query_r ) )
+      {
+        _queries.push_back( query_r );
+        return;
+      }
+
+      for ( const std::string & name : query_r.attributes().begin()->second )
+      {
+        if ( query_r.kinds().empty() )
+        {
+          // package and srcpackage share the plain name as ident
+          for ( const ResKind & kind : knownKinds() )
+            _idents[IdString( ResKind::satIdent( kind, name ) )].push_back( ResKind::nokind );
+        }
+        else
+        {
+          for ( const ResKind & kind : query_r.kinds() )
+            _idents[IdString( ResKind::satIdent( kind, name ) )].push_back( kind );
+        }
+      }
+      ++_indexed;
+    }
+
+    bool LockMatcher::matchesIndexed( sat::Solvable solv_r ) const
+    {
+      if ( _idents.empty() )
+        return false;
+
+      const auto it { _idents.find( solv_r.ident() ) };
+      if ( it == _idents.end() )
+        return false;
+
+      for ( const ResKind & kind : it->second )
+      {
+        if ( ! kind || solv_r.isKind( kind ) )
+          return true;
+      }
+      return false;
+    }
+
+    PoolQueryResult LockMatcher::match() const
+    {
+      PoolQueryResult ret;
+      if ( ! _idents.empty() )
+      {
+        for ( const sat::Solvable & solv : sat::Pool::instance().solvables() )
+        {
+          if ( matchesIndexed( solv ) )
+            ret += solv;
+        }
+      }
+      for ( const PoolQuery & query : _queries )
+        ret += query;
+      return ret;
+    }
+
+    PoolQueryResult LockMatcher::match( const std::vector<sat::Solvable> & candidates_r ) const
+    {
+      PoolQueryResult ret;
+      if ( candidates_r.empty() )
+        return ret;
+
+      std::set<std::string> repos;
+      for ( const sat::Solvable & solv : candidates_r )
+      {
+        if ( matchesIndexed( solv ) )
+          ret += solv;
+        if ( ! _queries.empty() )
+          repos.insert( solv.repository().alias() );
+      }
+
+      if ( ! _queries.empty() )
+      {
+        const std::unordered_set<sat::Solvable> candidates( candidates_r.begin(), candidates_r.end() );
+        for ( const PoolQuery & query : _queries )
+        {
+          // Restrict the query to the candidates repos (or skip it, if it
+          // is restricted to different repos).
+          PoolQuery restricted { query };
+          if ( query.repos().empty() )
+          {
+            for ( const std::string & alias : repos )
+              restricted.addRepo( alias );
+          }
+          else if ( std::none_of( query.repos().begin(), query.repos().end(),
+                                  [&repos]( const std::string & alias ) { return repos.count( alias ); } ) )
+          {
+            continue;
+          }
+
+          for ( const sat::Solvable & solv : restricted )
+          {
+            if ( candidates.count( solv ) )
+              ret += solv;
+          }
+        }
+      }
+      return ret;
+    }
+
+    std::ostream & operator<<( std::ostream & str, const LockMatcher & obj )
+    {
+      return str << "LockMatcher{indexed " << obj._indexed << " (" << obj._idents.size() << " idents), queries " << obj._queries.size() << "}";
+    }
+
+  } // namespace pool
+  ///////////////////////////////////////////////////////////////////
+} // namespace zypp
+///////////////////////////////////////////////////////////////////
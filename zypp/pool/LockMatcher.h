@@ -0,0 +1,102 @@
+/*---------------------------------------------------------------------\
+|                          ____ _   __ __ ___                          |
+|                         |__  / \ / / . \ . \                         |
+|                           / / \ V /|  _/  _/                         |
+|                          / /__ | | | | | |                           |
+|                         /_____||_| |_| |_|                           |
+|                                                                      |
+\---------------------------------------------------------------------*/
+/** \file	zypp/pool/LockMatcher.h
+ *
+*/
+#ifndef ZYPP_POOL_LOCKMATCHER_H
+#define ZYPP_POOL_LOCKMATCHER_H
+
+#include <iosfwd>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+#include <zypp/Globals.h>
+#include <zypp/IdString.h>
+#include <zypp/ResKind.h>
+#include <zypp/PoolQuery.h>
+#include <zypp/PoolQueryResult.h>
+#include <zypp/sat/Solvable.h>
+
+///////////////////////////////////////////////////////////////////
+namespace zypp
+{
+  ///////////////////////////////////////////////////////////////////
+  namespace pool
+  {
+    ///////////////////////////////////////////////////////////////////
+    /// \class LockMatcher
+    /// \brief A set of lock queries compiled into a single matcher.
+    ///
+    /// Most locks are plain name locks (exact or wildcard free glob match on
+    /// the name, case sensitive, optionally restricted to some kinds). They
+    /// are compiled into a hash of solvable idents, so testing a solvable
+    /// costs one lookup no matter how many of those locks exist.
+    ///
+    /// All other queries are kept as they are. When matching just a set of
+    /// candidates (e.g. the solvables of a newly added repo), those queries
+    /// are restricted to the candidates repos, so the cost scales with the
+    /// added repos rather than the whole pool.
+    ///////////////////////////////////////////////////////////////////
+    class ZYPP_TESTS LockMatcher
+    {
+      friend std::ostream & operator<<( std::ostream & str, const LockMatcher & obj );
+
+    public:
+      /** Default ctor: matches nothing. */
+      LockMatcher();
+
+      /** Ctor compiling a range of \ref PoolQuery. */
+      template <class TIterator>
+      LockMatcher( TIterator begin_r, TIterator end_r )
+      { for ( ; begin_r != end_r; ++begin_r ) add( *begin_r ); }
+
+      /** Add a lock query. */
+      void add( const PoolQuery & query_r );
+
+      /** Whether no lock was added. */
+      bool empty() const
+      { return _idents.empty() && _queries.empty(); }
+
+      /** Number of locks compiled into the ident hash. */
+      unsigned indexedSize() const
+      { return _indexed; }
+
+      /** Number of locks which need to be evaluated as \ref PoolQuery. */
+      unsigned queriesSize() const
+      { return _queries.size(); }
+
+    public:
+      /** Whether \a solv_r is matched by one of the indexed (plain name) locks.
+       * Locks evaluated as \ref PoolQuery are not considered.
+       */
+      bool matchesIndexed( sat::Solvable solv_r ) const;
+
+      /** All solvables in the pool matched by any lock. */
+      PoolQueryResult match() const;
+
+      /** The solvables in \a candidates_r matched by any lock. */
+      PoolQueryResult match( const std::vector<sat::Solvable> & candidates_r ) const;
+
+    private:
+      /** Ident to the kinds it is locked for (\ref ResKind::nokind for any kind). */
+      std::unordered_map<IdString, std::vector<ResKind>> _idents;
+      /** Locks evaluated as \ref PoolQuery. */
+      std::list<PoolQuery> _queries;
+      unsigned _indexed = 0;
+    };
+
+    /** \relates LockMatcher Stream output */
+    std::ostream & operator<<( std::ostream & str, const LockMatcher & obj ) ZYPP_TESTS;
+
+  } // namespace pool
+  ///////////////////////////////////////////////////////////////////
+} // namespace zypp
+///////////////////////////////////////////////////////////////////
+#endif // ZYPP_POOL_LOCKMATCHER_H
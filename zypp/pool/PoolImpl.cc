@@ -10,6 +10,7 @@
  *
 */
 #include <iostream>
+#include <cstring>
 #include <zypp/base/LogTools.h>
 
 #include <zypp/pool/PoolImpl.h>
@@ -52,6 +53,132 @@ namespace zypp
     PoolImpl::~PoolImpl()
     {}
 
+    ///////////////////////////////////////////////////////////////////
+    namespace
+    {
+      using resstatus::StatusSnapshotManip;
+
+      /** \ref PoolItem::sameState for a current and a saved bitfield. */
+      bool sameSavedState( ResStatus::FieldType curr_r, ResStatus::FieldType saved_r )
+      {
+        if ( curr_r == saved_r )
+          return true;
+        ResStatus curr;
+        StatusSnapshotManip::set( curr, curr_r );
+        ResStatus saved;
+        StatusSnapshotManip::set( saved, saved_r );
+        // some bits changed...
+        if ( curr.getTransactValue() != saved.getTransactValue()
+             && ( ! curr.isBySolver() // ignore solver state changes
+                  // removing a user lock also goes to bySolver
+                  || saved.getTransactValue() == ResStatus::LOCKED ) )
+          return false;
+        if ( curr.isLicenceConfirmed() != saved.isLicenceConfirmed() )
+          return false;
+        return true;
+      }
+    } // namespace
+    ///////////////////////////////////////////////////////////////////
+
+    void PoolImpl::SaveState() const
+    {
+      const ContainerT & mystore( store() );
+      for ( size_type i = 0; i < mystore.size(); ++i )
+      {
+        if ( mystore[i] )
+          _savedStates[i] = StatusSnapshotManip::get( mystore[i].status() );
+      }
+    }
+
+    void PoolImpl::SaveState( const ResKind & kind_r ) const
+    {
+      const ContainerT & mystore( store() );
+      for ( size_type i = 0; i < mystore.size(); ++i )
+      {
+        if ( mystore[i] && mystore[i].isKind( kind_r ) )
+          _savedStates[i] = StatusSnapshotManip::get( mystore[i].status() );
+      }
+    }
+
+    void PoolImpl::RestoreState() const
+    {
+      const ContainerT & mystore( store() );
+      // Collect the current state; empty slots are taken as unchanged.
+      _currStates.resize( mystore.size() );
+      for ( size_type i = 0; i < mystore.size(); ++i )
+        _currStates[i] = mystore[i] ? StatusSnapshotManip::get( mystore[i].status() ) : _savedStates[i];
+
+      if ( std::memcmp( _currStates.data(), _savedStates.data(), _currStates.size() * sizeof(ResStatus::FieldType) ) == 0 )
+        return;	// nothing changed
+
+      for ( size_type i = 0; i < mystore.size(); ++i )
+      {
+        if ( _currStates[i] != _savedStates[i] )
+          StatusSnapshotManip::set( mystore[i].status(), _savedStates[i] );
+      }
+    }
+
+    void PoolImpl::RestoreState( const ResKind & kind_r ) const
+    {
+      const ContainerT & mystore( store() );
+      for ( size_type i = 0; i < mystore.size(); ++i )
+      {
+        if ( mystore[i] && mystore[i].isKind( kind_r ) )
+          StatusSnapshotManip::set( mystore[i].status(), _savedStates[i] );
+      }
+    }
+
+    void PoolImpl::SaveState( const PoolItem & pi_r ) const
+    {
+      store();
+      _savedStates[pi_r.id()] = StatusSnapshotManip::get( pi_r.status() );
+    }
+
+    void PoolImpl::RestoreState( const PoolItem & pi_r ) const
+    {
+      store();
+      StatusSnapshotManip::set( pi_r.status(), _savedStates[pi_r.id()] );
+    }
+
+    bool PoolImpl::SameState( const PoolItem & pi_r ) const
+    {
+      store();
+      return sameSavedState( StatusSnapshotManip::get( pi_r.status() ), _savedStates[pi_r.id()] );
+    }
+
+    sat::SolvableQueue PoolImpl::DiffState() const
+    {
+      sat::SolvableQueue ret;
+      const ContainerT & mystore( store() );
+      // Collect the current state; empty slots are taken as unchanged.
+      _currStates.resize( mystore.size() );
+      for ( size_type i = 0; i < mystore.size(); ++i )
+        _currStates[i] = mystore[i] ? StatusSnapshotManip::get( mystore[i].status() ) : _savedStates[i];
+
+      if ( std::memcmp( _currStates.data(), _savedStates.data(), _currStates.size() * sizeof(ResStatus::FieldType) ) == 0 )
+        return ret;	// nothing changed
+
+      for ( size_type i = 0; i < mystore.size(); ++i )
+      {
+        if ( ! sameSavedState( _currStates[i], _savedStates[i] ) )
+          ret.push( i );
+      }
+      return ret;
+    }
+
+    sat::SolvableQueue PoolImpl::DiffState( const ResKind & kind_r ) const
+    {
+      sat::SolvableQueue ret;
+      const ContainerT & mystore( store() );
+      for ( size_type i = 0; i < mystore.size(); ++i )
+      {
+        if ( mystore[i] && mystore[i].isKind( kind_r )
+             && ! sameSavedState( StatusSnapshotManip::get( mystore[i].status() ), _savedStates[i] ) )
+          ret.push( i );
+      }
+      return ret;
+    }
+
     /////////////////////////////////////////////////////////////////
   } // namespace pool
   ///////////////////////////////////////////////////////////////////
@@ -21,10 +21,12 @@
 #include <zypp/APIConfig.h>
 
 #include <zypp/pool/PoolTraits.h>
+#include <zypp/pool/LockMatcher.h>
 #include <zypp/ResPoolProxy.h>
 #include <zypp/PoolQueryResult.h>
 
 #include <zypp/sat/Pool.h>
+#include <zypp/sat/Queue.h>
 #include <zypp/Product.h>
 
 using std::endl;
@@ -231,11 +233,37 @@ namespace zypp
         //
         ///////////////////////////////////////////////////////////////////
       public:
-        /** \name Save and restore state. */
+        /** \name Save and restore state.
+         * The saved ResStatus bitfields are kept in a contiguous array indexed
+         * by solvable id (like the \ref store). Restore and diff first collect
+         * the current bitfields into a 2nd array, so that unchanged items are
+         * skipped by a plain array compare.
+         *
+         * A newly created PoolItem starts with a default ResStatus as saved state.
+         *
+         * \ref DiffState returns the ids of all items whose status differs from
+         * the saved one. Like \ref PoolItem::sameState changes made by the solver
+         * are ignored, unless a user lock was removed. An empty queue means the
+         * state is unchanged.
+         */
         //@{
-        void SaveState( const ResKind & kind_r );
+        void SaveState() const;
+        void SaveState( const ResKind & kind_r ) const;
+
+        void RestoreState() const;
+        void RestoreState( const ResKind & kind_r ) const;
+
+        sat::SolvableQueue DiffState() const;
+        sat::SolvableQueue DiffState( const ResKind & kind_r ) const;
+
+        /** Whether \a pi_r is the item stored for its solvable (i.e. not a detached one). */
+        bool contains( const PoolItem & pi_r ) const
+        { return pi_r && find( pi_r.satSolvable() ) == pi_r; }
 
-        void RestoreState( const ResKind & kind_r );
+        /** Save, restore or compare the state of a single item in the \ref store. */
+        void SaveState( const PoolItem & pi_r ) const;
+        void RestoreState( const PoolItem & pi_r ) const;
+        bool SameState( const PoolItem & pi_r ) const;
         //@}
 
         ///////////////////////////////////////////////////////////////////
@@ -284,22 +312,24 @@ namespace zypp
         const HardLockQueries & hardLockQueries() const
         { return _hardLockQueries; }
 
-        void reapplyHardLocks() const
+        /** Apply the HardLockQueries to the items added to the pool.
+         * It is assumed that reapplyHardLocks is called after new
+         * items were added to the pool, but the _hardLockQueries
+         * did not change since. Action is to be performed only on
+         * those items that gained the bit in the UserLockQueryField.
+         * The precompiled \ref LockMatcher evaluates just the \a added_r
+         * items (resp. the repos they belong to), not the whole pool.
+         */
+        void reapplyHardLocks( const std::vector<sat::Solvable> & added_r ) const
         {
-          // It is assumed that reapplyHardLocks is called after new
-          // items were added to the pool, but the _hardLockQueries
-          // did not change since. Action is to be performed only on
-          // those items that gained the bit in the UserLockQueryField.
-          MIL << "Re-apply " << _hardLockQueries.size() << " HardLockQueries" << endl;
-          PoolQueryResult locked;
-          for_( it, _hardLockQueries.begin(), _hardLockQueries.end() )
-          {
-            locked += *it;
-          }
+          if ( _hardLockMatcher.empty() )
+            return;
+          MIL << "Re-apply " << _hardLockQueries.size() << " HardLockQueries to " << added_r.size() << " new Solvables " << _hardLockMatcher << endl;
+          PoolQueryResult locked { _hardLockMatcher.match( added_r ) };
           MIL << "HardLockQueries match " << locked.size() << " Solvables." << endl;
-          for_( it, begin(), end() )
+          for ( sat::Solvable solv : locked )
           {
-            resstatus::UserLockQueryManip::reapplyLock( it->status(), locked.contains( *it ) );
+            resstatus::UserLockQueryManip::reapplyLock( _store[solv.id()].status(), true );
           }
         }
 
@@ -307,13 +337,10 @@ namespace zypp
         {
           MIL << "Apply " << newLocks_r.size() << " HardLockQueries" << endl;
           _hardLockQueries = newLocks_r;
+          _hardLockMatcher = LockMatcher( _hardLockQueries.begin(), _hardLockQueries.end() );
           // now adjust the pool status
-          PoolQueryResult locked;
-          for_( it, _hardLockQueries.begin(), _hardLockQueries.end() )
-          {
-            locked += *it;
-          }
-          MIL << "HardLockQueries match " << locked.size() << " Solvables." << endl;
+          PoolQueryResult locked { _hardLockMatcher.match() };
+          MIL << "HardLockQueries match " << locked.size() << " Solvables " << _hardLockMatcher << endl;
           for_( it, begin(), end() )
           {
             resstatus::UserLockQueryManip::setLock( it->status(), locked.contains( *it ) );
@@ -367,11 +394,12 @@ namespace zypp
           if ( _storeDirty )
           {
             sat::Pool pool( satpool() );
-            bool addedItems = false;
+            std::vector<sat::Solvable> addedItems;
             bool reusedIDs = _watcherIDs.remember( pool.serialIDs() );
             std::list<PoolItem> addedProducts;
 
             _store.resize( pool.capacity() );
+            _savedStates.resize( pool.capacity(), defaultSavedState() );
 
             if ( pool.capacity() )
             {
@@ -383,16 +411,18 @@ namespace zypp
                 {
                   // the PoolItem got invalidated (e.g unloaded repo)
                   pi = PoolItem();
+                  _savedStates[i] = defaultSavedState();
                 }
                 else if ( reusedIDs || (s && ! pi) )
                 {
                   // new PoolItem to add
                   pi = PoolItem::makePoolItem( s ); // the only way to create a new one!
+                  _savedStates[i] = defaultSavedState();
                   // remember products for buddy processing (requires clean store)
                   if ( s.isKind( ResKind::product ) )
                     addedProducts.push_back( pi );
-                  if ( !addedItems )
-                    addedItems = true;
+                  if ( s )
+                    addedItems.push_back( s );
                 }
               }
             }
@@ -410,9 +440,9 @@ namespace zypp
             }
 
             // .... we must reapply those query based hard locks.
-            if ( addedItems )
+            if ( ! addedItems.empty() )
             {
-              reapplyHardLocks();
+              reapplyHardLocks( addedItems );
             }
 
             // Compute the initial status of Patches etc.
@@ -473,6 +503,16 @@ namespace zypp
         mutable Id2ItemT		      _id2item;
         mutable DefaultIntegral<bool,true>    _id2itemDirty;
 
+      private:
+        /** The saved state assumed for a newly created PoolItem. */
+        static ResStatus::FieldType defaultSavedState()
+        { return resstatus::StatusSnapshotManip::get( ResStatus() ); }
+
+        /** Saved ResStatus bitfields indexed by solvable id (\see \ref SaveState). */
+        mutable std::vector<ResStatus::FieldType> _savedStates;
+        /** Scratch array for the current bitfields collected by restore and diff. */
+        mutable std::vector<ResStatus::FieldType> _currStates;
+
       private:
         mutable shared_ptr<ResPoolProxy>      _poolProxy;
         mutable shared_ptr<EstablishedStatesImpl> _establishedStates;
@@ -480,6 +520,8 @@ namespace zypp
       private:
         /** Set of queries that define hardlocks. */
         HardLockQueries                       _hardLockQueries;
+        /** The _hardLockQueries compiled for \ref reapplyHardLocks. */
+        LockMatcher                           _hardLockMatcher;
     };
     ///////////////////////////////////////////////////////////////////
 
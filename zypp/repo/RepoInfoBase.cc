@@ -12,6 +12,8 @@
 #include <iostream>
 
 #include <zypp/ZConfig.h>
+#include <zypp/IdString.h>
+#include <zypp/base/String.h>
 #include <zypp/repo/RepoVariables.h>
 
 #include <zypp/repo/RepoInfoBase.h>
@@ -46,8 +48,8 @@ namespace zypp
   public:
     TriBool	_enabled;
     TriBool	_autorefresh;
-    std::string	_alias;
-    std::string	_escaped_alias;
+    IdString	_alias;		///< interned, repo collections compare aliases a lot
+    IdString	_escaped_alias;
     RepoVariablesReplacedString _name;
     Pathname	_filepath;
 
@@ -55,9 +57,18 @@ namespace zypp
 
     void setAlias( const std::string & alias_r )
     {
-      _alias = _escaped_alias = alias_r;
+      if ( alias_r.empty() )
+      {
+        _alias = _escaped_alias = IdString();
+        return;
+      }
+      _alias = _escaped_alias = IdString( alias_r );
       // replace slashes with underscores
-      str::replaceAll( _escaped_alias, "/", "_" );
+      if ( alias_r.find( '/' ) != std::string::npos )
+      {
+        std::string escaped { alias_r };
+        _escaped_alias = IdString( str::replaceAll( escaped, "/", "_" ) );
+      }
     }
 
   private:
@@ -109,10 +120,13 @@ namespace zypp
   { return indeterminate(_pimpl->_autorefresh) ? false : (bool) _pimpl->_autorefresh; }
 
   std::string RepoInfoBase::alias() const
+  { return _pimpl->_alias.asString(); }
+
+  IdString RepoInfoBase::aliasId() const
   { return _pimpl->_alias; }
 
   std::string RepoInfoBase::escaped_alias() const
-  { return _pimpl->_escaped_alias; }
+  { return _pimpl->_escaped_alias.asString(); }
 
   std::string RepoInfoBase::name() const
   {
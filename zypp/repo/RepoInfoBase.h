@@ -17,6 +17,7 @@
 #include <zypp/base/PtrTypes.h>
 #include <zypp/APIConfig.h>
 #include <zypp/Pathname.h>
+#include <zypp/IdString.h>
 
 ///////////////////////////////////////////////////////////////////
 namespace zypp
@@ -59,6 +60,12 @@ namespace zypp
        */
       std::string alias() const;
 
+      /**
+       * The interned \ref alias.
+       * Comparing two of them for equality is cheap.
+       */
+      IdString aliasId() const;
+
       /**
        * Same as alias(), just escaped in a way to be a valid file name.
        */
@@ -171,14 +178,14 @@ namespace zypp
 
     /** \relates RepoInfoBase */
     inline bool operator==( const RepoInfoBase & lhs, const RepoInfoBase & rhs )
-    { return lhs.alias() == rhs.alias(); }
+    { return lhs.aliasId() == rhs.aliasId(); }
 
     /** \relates RepoInfoBase */
     inline bool operator!=( const RepoInfoBase & lhs, const RepoInfoBase & rhs )
-    { return lhs.alias() != rhs.alias(); }
+    { return lhs.aliasId() != rhs.aliasId(); }
 
     inline bool operator<( const RepoInfoBase & lhs, const RepoInfoBase & rhs )
-    { return lhs.alias() < rhs.alias(); }
+    { return lhs.aliasId() < rhs.aliasId(); }
 
     /** \relates RepoInfoBase Stream output */
     std::ostream & operator<<( std::ostream & str, const RepoInfoBase & obj );
@@ -16,6 +16,7 @@
 #include <time.h>
 #include <zypp/repo/RepoMirrorList.h>
 #include <zypp-curl/parser/MetaLinkParser>
+#include <zypp-curl/private/mirrorhealth_p.h>
 #include <zypp/MediaSetAccess.h>
 #include <zypp/base/LogTools.h>
 #include <zypp/ZConfig.h>
@@ -165,6 +166,9 @@ namespace zypp
           zypp::filesystem::unlink( cachefile );
         }
       }
+
+      // rank the mirrors by how they performed in past runs
+      media::MirrorHealth::instance().sortByHealth( _urls );
     }
 
     /////////////////////////////////////////////////////////////////
@@ -8,6 +8,7 @@
 \---------------------------------------------------------------------*/
 #include <iostream>
 #include <fstream>
+#include <unordered_map>
 
 #include <zypp/base/LogTools.h>
 #include <zypp/base/String.h>
@@ -397,7 +398,86 @@ namespace zypp
         static const std::string * lookup( const std::string & name_r )
         { return instance()._lookup( name_r ); }
 
+        /** \ref RepoVarExpand \a value_r, remembering the result unless it depends on the releasever. */
+        static std::string expand( const std::string & value_r )
+        { return instance()._expand( value_r ); }
+
+        /** The \ref RepoVariablesUrlReplacer result for \a value_r, remembered like \ref expand. */
+        static Url expandUrl( const Url & value_r )
+        { return instance()._expandUrl( value_r ); }
+
+        /** Forget the variables and all remembered expansions (on re-acquiring the lock). */
+        void reset()
+        {
+          clear();
+          _expanded.clear();
+          _expandedUrls.clear();
+        }
+
       private:
+        /** Remembered expansions are dropped if there are too many. */
+        static constexpr size_t maxExpanded = 4096;
+
+        std::string _expand( const std::string & value_r )
+        {
+          auto it = _expanded.find( value_r );
+          if ( it != _expanded.end() )
+            return it->second;
+
+          _volatile = false;
+          std::string ret { RepoVarExpand()( value_r, RepoVarsMap::lookup ) };
+          if ( ! _volatile )
+          {
+            if ( _expanded.size() >= maxExpanded )
+              _expanded.clear();
+            _expanded.emplace( value_r, ret );
+          }
+          return ret;
+        }
+
+        Url _expandUrl( const Url & value_r )
+        {
+          Url::ViewOptions toReplace = value_r.getViewOptions() - url::ViewOption::WITH_USERNAME - url::ViewOption::WITH_PASSWORD;
+          // Legacy: Not 100% correct because it substitutes inside the 'proxypass=' value,
+          // but this was done before as well. The final fix will have to keep the proxypasswd
+          // out side the url in a cedential file.
+          Url tmpurl { value_r };
+          tmpurl.setViewOptions( toReplace );
+          std::string raw { hotfix1050625::asString( tmpurl ) };
+
+          // The credentials are not expanded but restored, so they are part of the key.
+          std::string key { raw };
+          key += '\0';
+          key += value_r.getUsername( url::E_ENCODED );
+          key += '\0';
+          key += value_r.getPassword( url::E_ENCODED );
+
+          Url newurl;
+          auto it = _expandedUrls.find( key );
+          if ( it != _expandedUrls.end() )
+            newurl = it->second;
+          else
+          {
+            _volatile = false;
+            const std::string & replaced( RepoVarExpand()( std::move(raw), RepoVarsMap::lookup ) );
+            if ( !replaced.empty() )
+            {
+              newurl = replaced;
+              newurl.setUsername( value_r.getUsername( url::E_ENCODED ), url::E_ENCODED );
+              newurl.setPassword( value_r.getPassword( url::E_ENCODED ), url::E_ENCODED );
+            }
+            if ( ! _volatile )
+            {
+              if ( _expandedUrls.size() >= maxExpanded )
+                _expandedUrls.clear();
+              _expandedUrls.emplace( std::move(key), newurl );
+            }
+          }
+          if ( newurl.isValid() )
+            newurl.setViewOptions( value_r.getViewOptions() );
+          return newurl;
+        }
+
         const std::string * _lookup( const std::string & name_r )
         {
           // Safe guard in case the caller does not own a zypp instance. In this case
@@ -429,6 +509,10 @@ namespace zypp
             }
           }
 
+          // releasever may change without a reset (see checkOverride)
+          if ( str::startsWith( name_r, "releasever" ) )
+            _volatile = true;
+
           const std::string * ret = checkOverride( name_r );
           if ( !ret )
           {
@@ -538,38 +622,31 @@ namespace zypp
 
           return nullptr;	// get user value from map
         }
+
+      private:
+        std::unordered_map<std::string,std::string> _expanded;	///< remembered string expansions
+        std::unordered_map<std::string,Url> _expandedUrls;	///< remembered url expansions
+        bool _volatile = false;	///< whether the current expansion depends on releasever
       };
     } // namespace
     ///////////////////////////////////////////////////////////////////
 
     std::string RepoVariablesStringReplacer::operator()( const std::string & value ) const
     {
-      return RepoVarExpand()( value, RepoVarsMap::lookup );
+      if ( value.find( '$' ) == std::string::npos )
+        return value;	// nothing to expand
+      return RepoVarsMap::expand( value );
     }
     std::string RepoVariablesStringReplacer::operator()( std::string && value ) const
     {
-      return RepoVarExpand()( std::move(value), RepoVarsMap::lookup );
+      if ( value.find( '$' ) == std::string::npos )
+        return std::move(value);	// nothing to expand
+      return RepoVarsMap::expand( value );
     }
 
     Url RepoVariablesUrlReplacer::operator()( const Url & value ) const
     {
-      Url::ViewOptions toReplace = value.getViewOptions() - url::ViewOption::WITH_USERNAME - url::ViewOption::WITH_PASSWORD;
-      // Legacy: Not 100% correct because it substitutes inside the 'proxypass=' value,
-      // but this was done before as well. The final fix will have to keep the proxypasswd
-      // out side the url in a cedential file.
-      Url tmpurl { value };
-      tmpurl.setViewOptions( toReplace );
-      const std::string & replaced( RepoVarExpand()( hotfix1050625::asString( tmpurl ), RepoVarsMap::lookup ) );
-
-      Url newurl;
-      if ( !replaced.empty() )
-      {
-        newurl = replaced;
-        newurl.setUsername( value.getUsername( url::E_ENCODED ), url::E_ENCODED );
-        newurl.setPassword( value.getPassword( url::E_ENCODED ), url::E_ENCODED );
-        newurl.setViewOptions( value.getViewOptions() );
-      }
-      return newurl;
+      return RepoVarsMap::expandUrl( value );
     }
   } // namespace repo
   ///////////////////////////////////////////////////////////////////
@@ -581,7 +658,7 @@ namespace zyppintern
   using namespace zypp;
   // internal helper called when re-acquiring the lock
   void repoVariablesReset()
-  { repo::RepoVarsMap::instance().clear(); }
+  { repo::RepoVarsMap::instance().reset(); }
 
 } // namespace zyppintern
 ///////////////////////////////////////////////////////////////////
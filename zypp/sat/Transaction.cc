@@ -14,6 +14,7 @@ extern "C"
 #include <solv/solver.h>
 }
 #include <iostream>
+#include <algorithm>
 #include <zypp/base/LogTools.h>
 #include <zypp/base/SerialNumber.h>
 #include <zypp-core/base/DefaultIntegral>
@@ -161,12 +162,62 @@ namespace zypp
 #endif
           if ( !_ordered )
           {
-            ::transaction_order( _trans, 0 );
+            ::transaction_order( _trans, SOLVER_TRANSACTION_KEEP_ORDEREDGES );
+            collectOrderEdges();
+            ::transaction_free_orderdata( _trans );
             _ordered = true;
           }
           return true;
         }
 
+        bool ordered() const
+        { return _ordered; }
+
+        SolvableQueue orderPredecessors( const Solvable & solv_r ) const
+        {
+          SolvableQueue ret;
+          detail::IdType * it( _find( solv_r ) );
+          if ( it && _ordered && ! _predecessors.empty() )
+          {
+            for ( unsigned idx : _predecessors[it - _trans->steps.elements] )
+              ret.push( _trans->steps.elements[idx] );
+          }
+          return ret;
+        }
+
+        std::vector<SolvableQueue> orderComponents() const
+        {
+          std::vector<SolvableQueue> ret;
+          if ( ! _ordered || _predecessors.empty() )
+            return ret;
+
+          // union-find on the ordered step indices
+          std::vector<unsigned> parent( size() );
+          for ( unsigned i = 0; i < parent.size(); ++i )
+            parent[i] = i;
+          auto root = [&parent]( unsigned i ) {
+            while ( parent[i] != i )
+              i = parent[i] = parent[parent[i]];
+            return i;
+          };
+          for ( unsigned i = 0; i < parent.size(); ++i )
+            for ( unsigned idx : _predecessors[i] )
+              parent[root(i)] = root(idx);
+
+          std::unordered_map<unsigned,unsigned> componentOf;	// root -> index in ret
+          for ( unsigned i = 0; i < parent.size(); ++i )
+          {
+            detail::IdType id { _trans->steps.elements[i] };
+            if ( stepType( Solvable(id) ) == TRANSACTION_IGNORE )
+              continue;
+            auto res { componentOf.insert( { root(i), ret.size() } ) };
+            if ( res.second )
+              ret.push_back( SolvableQueue() );
+            ret[res.first->second].push( id );
+          }
+          return ret;
+        }
+
         bool empty() const
         { return( _trans->steps.count == 0 ); }
 
@@ -266,6 +317,38 @@ namespace zypp
         }
 
       private:
+        /** Remember libsolvs ordering dependencies as step indices. */
+        void collectOrderEdges()
+        {
+          _predecessors.clear();
+          _predecessors.resize( size() );
+
+          std::unordered_map<detail::IdType,unsigned> indexOf;
+          for ( unsigned i = 0; i < size(); ++i )
+            indexOf[_trans->steps.elements[i]] = i;
+
+          Queue edges;
+          for ( unsigned i = 0; i < size(); ++i )
+          {
+            ::transaction_order_get_edges( _trans, _trans->steps.elements[i], edges, 1 );	// without the edges broken to resolve cycles
+            // edges are (solvable,type) pairs
+            for ( Queue::size_type e = 0; e < edges.size(); e += 2 )
+            {
+              auto res { indexOf.find( edges[e] ) };
+              if ( res == indexOf.end() || res->second == i )
+                continue;
+              // The step ordered first is the one to be committed before.
+              unsigned before = std::min( i, res->second );
+              unsigned after  = std::max( i, res->second );
+              std::vector<unsigned> & pred { _predecessors[after] };
+              if ( std::find( pred.begin(), pred.end(), before ) == pred.end() )
+                pred.push_back( before );
+            }
+          }
+          for ( auto & pred : _predecessors )
+            std::sort( pred.begin(), pred.end() );
+        }
+
         detail::IdType * _find( const sat::Solvable & solv_r ) const
         {
           if ( solv_r && _trans->steps.elements )
@@ -283,6 +366,7 @@ namespace zypp
         SerialNumberWatcher _watcher;
         mutable ::Transaction * _trans;
         DefaultIntegral<bool,false> _ordered;
+        std::vector<std::vector<unsigned>> _predecessors;	// per ordered step: indices of the steps to commit before
         //
         set_type	_doneSet;
         set_type	_errSet;
@@ -330,6 +414,15 @@ namespace zypp
     bool Transaction::order()
     { return _pimpl->order(); }
 
+    bool Transaction::ordered() const
+    { return _pimpl->ordered(); }
+
+    SolvableQueue Transaction::orderPredecessors( const Solvable & solv_r ) const
+    { return _pimpl->orderPredecessors( solv_r ); }
+
+    std::vector<SolvableQueue> Transaction::orderComponents() const
+    { return _pimpl->orderComponents(); }
+
     bool Transaction::empty() const
     { return _pimpl->empty(); }
 
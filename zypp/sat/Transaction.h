@@ -12,6 +12,7 @@
 #define ZYPP_SAT_TRANSACTION_H
 
 #include <iosfwd>
+#include <vector>
 
 #include <zypp/base/PtrTypes.h>
 #include <zypp/base/Flags.h>
@@ -103,9 +104,33 @@ namespace zypp
          * It's cheap to call it for an aleready ordered \ref Transaction.
          * This invalidates outstanding iterators. Returns whether
          * \ref Transaction is \ref valid.
+         *
+         * Along with the linear commit order the dependencies between
+         * the steps are remembered (\see \ref orderPredecessors and
+         * \ref orderComponents).
          */
         bool order();
 
+        /** Whether \ref order was called and the ordering data are available. */
+        bool ordered() const;
+
+        /** The action steps which must be committed before \a solv_r.
+         * Only the direct dependencies computed by \ref order are returned
+         * (edges broken to resolve ordering cycles are omitted). Empty if the
+         * transaction is not ordered or \a solv_r is not an action step.
+         */
+        SolvableQueue orderPredecessors( const Solvable & solv_r ) const;
+
+        /** Partition the action steps into mutually independent components.
+         * Two action steps are in the same component if they are (directly
+         * or indirectly) connected by an ordering dependency. Steps in different
+         * components do not depend on each other, so e.g. downloading, verifying
+         * or preparing them may be scheduled concurrently per component. Within
+         * a component the steps are in commit order; the components are sorted
+         * by the position of their first step. Empty if not ordered.
+         */
+        std::vector<SolvableQueue> orderComponents() const;
+
         /** Whether the transaction contains any steps. */
         bool empty() const;
 
@@ -20,5 +20,6 @@
 #include <zypp/ResolverNamespace.h>
 
 #include <zypp/ResolverProblem.h>
+#include <zypp/ResolverStats.h>
 
 #endif // ZYPP_SOLVER_TYPES_H
@@ -109,6 +109,9 @@ Resolver::~Resolver()
 sat::detail::CSolver * Resolver::get() const
 { return _satResolver->get(); }
 
+const ResolverStats & Resolver::stats() const
+{ return _satResolver->stats(); }
+
 
 void Resolver::setDefaultSolverFlags( bool all_r )
 {
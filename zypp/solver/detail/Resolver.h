@@ -245,6 +245,9 @@ class ZYPP_API_DEPTESTOMATIC Resolver : private base::NonCopyable
     ItemCapKindList satifiedByInstalled (const PoolItem & item );
     ItemCapKindList installedSatisfied( const PoolItem & item );
 
+    // Timing and libsolv statistics of the last solver run
+    const ResolverStats & stats() const;
+
 public:
     /** Expert backdoor. */
     sat::detail::CSolver * get() const;
@@ -53,6 +53,9 @@ extern "C"
 #include <zypp/solver/detail/SolutionAction.h>
 #include <zypp/solver/detail/SolverQueueItem.h>
 
+#include <chrono>
+#include <ctime>
+#include <optional>
 #include <utility>
 using std::endl;
 
@@ -162,6 +165,75 @@ namespace zypp
           }
         }
 
+        /** Scoped timer adding the elapsed wall and cpu time to a \ref ResolverStats::PhaseTime. */
+        struct PhaseTimer
+        {
+          PhaseTimer( ResolverStats & stats_r, ResolverStats::Phase phase_r )
+          : _phase { stats_r.phase[phase_r] }
+          , _wall { std::chrono::steady_clock::now() }
+          , _cpu { std::clock() }
+          {}
+
+          PhaseTimer( const PhaseTimer & ) = delete;
+          PhaseTimer & operator=( const PhaseTimer & ) = delete;
+
+          ~PhaseTimer()
+          {
+            _phase.wall += std::chrono::duration<double>( std::chrono::steady_clock::now() - _wall ).count();
+            _phase.cpu  += double( std::clock() - _cpu ) / CLOCKS_PER_SEC;
+            ++_phase.calls;
+          }
+
+        private:
+          ResolverStats::PhaseTime & _phase;
+          std::chrono::steady_clock::time_point _wall;
+          std::clock_t _cpu;
+        };
+
+        /** Remember libsolv's rule, decision and pool statistics after solving. */
+        inline void solverCollectStats( sat::detail::CSolver & satSolver_r, const sat::detail::CQueue & jobQueue_r, ResolverStats & stats_r )
+        {
+          // Rules are numbered consecutively; the rule classes are stored as
+          // adjacent ranges with the learnt rules at the end. Rule 0 is unused,
+          // the first id past the last rule is SOLVER_RULE_UNKNOWN.
+          ResolverStats::RuleCounts & rules { stats_r.rules };
+          rules = ResolverStats::RuleCounts();
+          for ( Id rid = 1; ; ++rid )
+          {
+            SolverRuleinfo ruleclass = ::solver_ruleclass( &satSolver_r, rid );
+            if ( ruleclass == SOLVER_RULE_UNKNOWN )
+              break;
+            ++rules.total;
+            switch ( ruleclass )
+            {
+              case SOLVER_RULE_PKG:		++rules.pkg;		break;
+              case SOLVER_RULE_UPDATE:		++rules.update;		break;
+              case SOLVER_RULE_FEATURE:		++rules.feature;	break;
+              case SOLVER_RULE_JOB:		++rules.job;		break;
+              case SOLVER_RULE_DISTUPGRADE:	++rules.distupgrade;	break;
+              case SOLVER_RULE_INFARCH:		++rules.infarch;	break;
+              case SOLVER_RULE_BEST:		++rules.best;		break;
+              case SOLVER_RULE_CHOICE:		++rules.choice;		break;
+              case SOLVER_RULE_LEARNT:		++rules.learnt;		break;
+              default:				++rules.other;		break;
+            }
+          }
+
+          sat::Queue decisionq;
+          ::solver_get_decisionqueue( &satSolver_r, decisionq );
+          stats_r.decisions = decisionq.size();
+          stats_r.jobs      = jobQueue_r.count / 2;
+          stats_r.problems  = ::solver_problem_count( &satSolver_r );
+
+          const sat::detail::CPool & cPool { *satSolver_r.pool };
+          ResolverStats::PoolSizes & pool { stats_r.pool };
+          pool.solvables    = cPool.nsolvables;
+          pool.repos        = cPool.nrepos;
+          pool.strings      = cPool.ss.nstrings;
+          pool.rels         = cPool.nrels;
+          pool.whatprovides = cPool.whatprovidesdataoff;
+        }
+
       } //namespace
       ///////////////////////////////////////////////////////////////////////
 
@@ -711,11 +783,16 @@ bool
 SATResolver::solving(const CapabilitySet & requires_caps,
                      const CapabilitySet & conflict_caps)
 {
-    sat::Pool::instance().prepare();
+    {
+      PhaseTimer timer( _stats, ResolverStats::PoolPrepare );
+      sat::Pool::instance().prepare();
+    }
 
     // Solve !
     MIL << "Starting solving...." << endl;
     MIL << *this;
+    std::optional<PhaseTimer> timer;
+    timer.emplace( _stats, ResolverStats::Solve );
     if ( solver_solve( _satSolver, &(_jobQueue) ) == 0 )
     {
       // bsc#1155819: Weakremovers of future product not evaluated.
@@ -764,10 +841,13 @@ SATResolver::solving(const CapabilitySet & requires_caps,
         }
       }
     }
+    timer.reset();
+    solverCollectStats( *_satSolver, _jobQueue, _stats );
     MIL << "....Solver end" << endl;
 
     // copying solution back to zypp pool
     //-----------------------------------------
+    timer.emplace( _stats, ResolverStats::ResultTransfer );
     _result_items_to_install.clear();
     _result_items_to_remove.clear();
 
@@ -859,6 +939,8 @@ SATResolver::solving(const CapabilitySet & requires_caps,
             }
         }
     }
+    timer.reset();
+    MIL << _stats << endl;
 
     if (solver_problem_count(_satSolver) > 0 )
     {
@@ -916,19 +998,23 @@ SATResolver::resolvePool(const CapabilitySet & requires_caps,
                          const std::set<Repository> & upgradeRepos)
 {
     MIL << "SATResolver::resolvePool()" << endl;
+    _stats.clear();
+    {
+      PhaseTimer timer( _stats, ResolverStats::SolverInit );
 
-    // Initialize
-    solverInit(weakItems);
+      // Initialize
+      solverInit(weakItems);
 
-    // Add pool and extra jobs.
-    solverAddJobsFromPool();
-    solverAddJobsFromExtraQueues( requires_caps, conflict_caps );
-    // 'dup --from' jobs
-    for_( iter, upgradeRepos.begin(), upgradeRepos.end() )
-    {
-        queue_push( &(_jobQueue), SOLVER_DISTUPGRADE | SOLVER_SOLVABLE_REPO );
-        queue_push( &(_jobQueue), iter->get()->repoid );
-        MIL << "Upgrade repo " << *iter << endl;
+      // Add pool and extra jobs.
+      solverAddJobsFromPool();
+      solverAddJobsFromExtraQueues( requires_caps, conflict_caps );
+      // 'dup --from' jobs
+      for_( iter, upgradeRepos.begin(), upgradeRepos.end() )
+      {
+          queue_push( &(_jobQueue), SOLVER_DISTUPGRADE | SOLVER_SOLVABLE_REPO );
+          queue_push( &(_jobQueue), iter->get()->repoid );
+          MIL << "Upgrade repo " << *iter << endl;
+      }
     }
 
     // Solve!
@@ -944,17 +1030,21 @@ SATResolver::resolveQueue(const SolverQueueItemList &requestQueue,
                           const PoolItemList & weakItems)
 {
     MIL << "SATResolver::resolvQueue()" << endl;
+    _stats.clear();
+    {
+      PhaseTimer timer( _stats, ResolverStats::SolverInit );
 
-    // Initialize
-    solverInit(weakItems);
+      // Initialize
+      solverInit(weakItems);
 
-    // Add request queue's jobs.
-    for (SolverQueueItemList::const_iterator iter = requestQueue.begin(); iter != requestQueue.end(); iter++) {
-        (*iter)->addRule(_jobQueue);
-    }
+      // Add request queue's jobs.
+      for (SolverQueueItemList::const_iterator iter = requestQueue.begin(); iter != requestQueue.end(); iter++) {
+          (*iter)->addRule(_jobQueue);
+      }
 
-    // Add pool jobs; they do contain any problem resolutions.
-    solverAddJobsFromPool();
+      // Add pool jobs; they do contain any problem resolutions.
+      solverAddJobsFromPool();
+    }
 
     // Solve!
     bool ret = solving();
@@ -967,25 +1057,37 @@ SATResolver::resolveQueue(const SolverQueueItemList &requestQueue,
 void SATResolver::doUpdate()
 {
     MIL << "SATResolver::doUpdate()" << endl;
+    _stats.clear();
 
     // Initialize
-    solverInit(PoolItemList());
+    {
+      PhaseTimer timer( _stats, ResolverStats::SolverInit );
+      solverInit(PoolItemList());
+    }
 
     // By now, doUpdate has no additional jobs.
     // It does not include any pool jobs, and so it does not create an conflicts.
     // Combinations like patch_with_update are driven by resolvePool + _updatesystem.
 
     // TODO: Try to join the following with solving()
-    sat::Pool::instance().prepare();
+    {
+      PhaseTimer timer( _stats, ResolverStats::PoolPrepare );
+      sat::Pool::instance().prepare();
+    }
 
     // Solve!
     MIL << "Starting solving for update...." << endl;
     MIL << *this;
-    solver_solve( _satSolver, &(_jobQueue) );
+    {
+      PhaseTimer timer( _stats, ResolverStats::Solve );
+      solver_solve( _satSolver, &(_jobQueue) );
+    }
+    solverCollectStats( *_satSolver, _jobQueue, _stats );
     MIL << "....Solver end" << endl;
 
     // copying solution back to zypp pool
     //-----------------------------------------
+    PhaseTimer timer( _stats, ResolverStats::ResultTransfer );
 
     /*  solvables to be installed */
     Queue decisionq;
@@ -1355,6 +1457,7 @@ namespace {
 ResolverProblemList
 SATResolver::problems ()
 {
+    PhaseTimer timer( _stats, ResolverStats::Problems );
     ResolverProblemList resolverProblems;
     if (_satSolver && solver_problem_count(_satSolver)) {
         sat::detail::CPool *pool = _satSolver->pool;
@@ -84,6 +84,9 @@ class SATResolver : public base::ReferenceCounted, private base::NonCopyable, pr
     PoolItemList _result_items_to_install;
     PoolItemList _result_items_to_remove;
 
+    // statistics of the last solver run
+    ResolverStats _stats;
+
   public:
     ResolverFocus _focus;		// The resolver's general attitude
 
@@ -222,6 +225,8 @@ class SATResolver : public base::ReferenceCounted, private base::NonCopyable, pr
     sat::StringQueue autoInstalled() const;
     sat::StringQueue userInstalled() const;
 
+    const ResolverStats & stats() const { return _stats; }
+
 public:
   /** Expert backdoor. */
   sat::detail::CSolver * get() const { return _satSolver; }
@@ -43,6 +43,7 @@
 
 extern "C" {
 #include <solv/testcase.h>
+#include <solv/repo_write.h>
 }
 
 using std::endl;
@@ -122,7 +123,15 @@ namespace zypp
             solv_free((void *)x);
         });
 
-        if ( ::testcase_write( resolver.get(), dumpPath.c_str(), TESTCASE_RESULT_TRANSACTION | TESTCASE_RESULT_PROBLEMS, slvTestcaseName.c_str(), slvResult.c_str() ) == 0 ) {
+        if ( _binaryPool ) {
+          // Just the result in libsolv format, the repos are dumped as solv files below.
+          zypp::AutoDispose<char *> result( ::testcase_solverresult( resolver.get(), TESTCASE_RESULT_TRANSACTION | TESTCASE_RESULT_PROBLEMS ),
+                                            []( char * x ){ solv_free( x ); } );
+          std::ofstream rout( dumpPath+"/"+slvResult );
+          if ( result.value() )
+            rout << result.value();
+        }
+        else if ( ::testcase_write( resolver.get(), dumpPath.c_str(), TESTCASE_RESULT_TRANSACTION | TESTCASE_RESULT_PROBLEMS, slvTestcaseName.c_str(), slvResult.c_str() ) == 0 ) {
           ERR << "Failed to write solv data, aborting." << endl;
           return false;
         }
@@ -178,7 +187,12 @@ namespace zypp
             yOut << YAML::Key << "generated" << YAML::Value << myRepo.generatedTimestamp().form( "%Y-%m-%d %H:%M:%S" );
             yOut << YAML::Key << "outdated" << YAML::Value << myRepo.suggestedExpirationTimestamp().form( "%Y-%m-%d %H:%M:%S" );
             yOut << YAML::Key << "priority" << YAML::Value << myRepoInfo.priority();
-            yOut << YAML::Key << "file" << YAML::Value << str::Format("%1%.repo.gz") % repoFileNames[myRepo.id()->repoid];
+            if ( _binaryPool ) {
+              yOut << YAML::Key << "file" << YAML::Value << str::Format("%1%.solv") % repoFileNames[myRepo.id()->repoid];
+              yOut << YAML::Key << "format" << YAML::Value << "solv";
+            }
+            else
+              yOut << YAML::Key << "file" << YAML::Value << str::Format("%1%.repo.gz") % repoFileNames[myRepo.id()->repoid];
 
             yOut << YAML::EndMap;
           }
@@ -187,8 +201,28 @@ namespace zypp
 
         yOut << YAML::EndSeq;
 
+        if ( _binaryPool ) {
+          for ( Repository::IdType id : repos ) {
+            const std::string solvFile { str::Format("%1%/%2%.solv") % dumpPath % repoFileNames[id->repoid] };
+            AutoFILE file { ::fopen( solvFile.c_str(), "we" ) };
+            if ( ! file ) {
+              ERR << "Can't open " << solvFile << " for writing, aborting." << endl;
+              return false;
+            }
+
+            ::repo_internalize( id );
+            int res = ::repo_write( id, file );
+            file.resetDispose();	// we're going to close it manually here
+            if ( ::fclose( file ) != 0 || res != 0 ) {
+              ERR << "Failed to write solv data to " << solvFile << ", aborting." << endl;
+              return false;
+            }
+          }
+        }
+
         yOut << YAML::Key << "arch" << YAML::Value << ZConfig::instance().systemArchitecture().asString() ;
-        yOut << YAML::Key << "solverTestcase" << YAML::Value << slvTestcaseName ;
+        if ( ! _binaryPool )
+          yOut << YAML::Key << "solverTestcase" << YAML::Value << slvTestcaseName ;
         yOut << YAML::Key << "solverResult" << YAML::Value << slvResult ;
 
         // RequestedLocales
@@ -386,6 +420,55 @@ namespace zypp
         std::ofstream fout( dumpPath+"/zypp-control.yaml" );
         fout << yOut.c_str();
 
+        // Statistics of the last solver run (informal, not read by LoadTestcase)
+        {
+          const ResolverStats & stats { resolver.stats() };
+          YAML::Emitter yStats;
+          yStats << YAML::BeginMap;
+          yStats << YAML::Key << "phases" << YAML::Value << YAML::BeginMap;
+          for ( unsigned i = 0; i < ResolverStats::PhaseCount; ++i ) {
+            const ResolverStats::PhaseTime & p { stats.phase[i] };
+            yStats << YAML::Key << asString( ResolverStats::Phase(i) ) << YAML::Value << YAML::BeginMap
+                   << YAML::Key << "wall"  << YAML::Value << p.wall
+                   << YAML::Key << "cpu"   << YAML::Value << p.cpu
+                   << YAML::Key << "calls" << YAML::Value << p.calls
+                   << YAML::EndMap;
+          }
+          yStats << YAML::EndMap; // phases
+
+          const ResolverStats::RuleCounts & r { stats.rules };
+          yStats << YAML::Key << "rules" << YAML::Value << YAML::BeginMap
+                 << YAML::Key << "total"       << YAML::Value << r.total
+                 << YAML::Key << "pkg"         << YAML::Value << r.pkg
+                 << YAML::Key << "update"      << YAML::Value << r.update
+                 << YAML::Key << "feature"     << YAML::Value << r.feature
+                 << YAML::Key << "job"         << YAML::Value << r.job
+                 << YAML::Key << "distupgrade" << YAML::Value << r.distupgrade
+                 << YAML::Key << "infarch"     << YAML::Value << r.infarch
+                 << YAML::Key << "best"        << YAML::Value << r.best
+                 << YAML::Key << "choice"      << YAML::Value << r.choice
+                 << YAML::Key << "learnt"      << YAML::Value << r.learnt
+                 << YAML::Key << "other"       << YAML::Value << r.other
+                 << YAML::EndMap;
+
+          yStats << YAML::Key << "decisions" << YAML::Value << stats.decisions;
+          yStats << YAML::Key << "jobs"      << YAML::Value << stats.jobs;
+          yStats << YAML::Key << "problems"  << YAML::Value << stats.problems;
+
+          const ResolverStats::PoolSizes & ps { stats.pool };
+          yStats << YAML::Key << "pool" << YAML::Value << YAML::BeginMap
+                 << YAML::Key << "solvables"    << YAML::Value << ps.solvables
+                 << YAML::Key << "repos"        << YAML::Value << ps.repos
+                 << YAML::Key << "strings"      << YAML::Value << ps.strings
+                 << YAML::Key << "rels"         << YAML::Value << ps.rels
+                 << YAML::Key << "whatprovides" << YAML::Value << ps.whatprovides
+                 << YAML::EndMap;
+          yStats << YAML::EndMap;
+
+          std::ofstream sout( dumpPath+"/zypp-stats.yaml" );
+          sout << yStats.c_str();
+        }
+
         MIL << "createTestcase done at " << dumpPath << endl;
         return true;
       }
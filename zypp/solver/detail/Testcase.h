@@ -42,6 +42,7 @@ namespace zypp
       {
         private:
           std::string dumpPath; // Path of the generated testcase
+          bool _binaryPool = false;
 
         public:
           Testcase();
@@ -49,6 +50,18 @@ namespace zypp
           ~Testcase();
 
           bool createTestcase( Resolver & resolver, bool dumpPool = true, bool runSolver = true );
+
+          /** Whether the repos are dumped as binary solv files rather than as
+           * libsolv testcase (testtags). Writing and loading a binary testcase
+           * is almost as fast as loading the pool, but it can not be used with
+           * libsolvs \c testsolv.
+           */
+          bool binaryPool() const
+          { return _binaryPool; }
+
+          /** Set whether to dump the repos as binary solv files. */
+          void setBinaryPool( bool yesno_r )
+          { _binaryPool = yesno_r; }
       };
 
       ///////////////////////////////////////////////////////////////////
@@ -45,7 +45,7 @@ namespace zypp
           rpm::librpmDb::db_const_iterator it;
           for ( it.findByName( name_r ); *it; ++it )
           {
-            if ( arch_r == it->tag_arch()
+            if ( it->string_view( RPMTAG_ARCH ) == arch_r.asString()
               && ( ed_r == Edition::noedition || ed_r == it->tag_edition() ) )
             {
               return true;
@@ -18,6 +18,7 @@
 
 #include <sys/types.h>
 #include <dirent.h>
+#include <fcntl.h>
 
 #include <zypp/base/LogTools.h>
 #include <zypp/base/Exception.h>
@@ -2382,6 +2383,12 @@ namespace zypp
         auto messagePipe = zyppng::Pipe::create();
         if ( !messagePipe )
           ZYPP_THROW( target::rpm::RpmSubprocessException( "Failed to create message pipe" ) );
+#ifdef F_SETPIPE_SZ
+        // zypp-rpm batches its messages; a larger pipe buffer lets it continue
+        // with the transaction while we are busy processing the reports.
+        if ( ::fcntl( messagePipe->writeFd, F_SETPIPE_SZ, 1024 * 1024 ) == -1 )
+          DBG << "Unable to enlarge the zypp-rpm message pipe: " << str::strerror( errno ) << std::endl;
+#endif
 
         // open a pipe that we are going to use to receive script output, this is a librpm feature, there is no other
         // way than a FD to redirect that output
@@ -2462,9 +2469,9 @@ namespace zypp
           while ( msgSource->bytesAvailable() ) {
 
             if ( pendingMessageSize == 0 ) {
-              if ( std::size_t(msgSource->bytesAvailable()) >= sizeof( zyppng::rpc::HeaderSizeType ) ) {
-                msgSource->read( reinterpret_cast<char *>( &pendingMessageSize ),  sizeof( zyppng::rpc::HeaderSizeType ) );
-              }
+              if ( std::size_t(msgSource->bytesAvailable()) < sizeof( zyppng::rpc::HeaderSizeType ) )
+                return; // wait for the rest of the frame header
+              msgSource->read( reinterpret_cast<char *>( &pendingMessageSize ),  sizeof( zyppng::rpc::HeaderSizeType ) );
             }
 
             if ( msgSource->bytesAvailable() < pendingMessageSize ) {
@@ -33,6 +33,7 @@ extern "C"
 
 #include <zypp/target/TargetImpl.h>
 #include <zypp/target/CommitPackageCache.h>
+#include <zypp/target/rpm/RpmHeaderPrefetch.h>
 
 #include <zypp/ZYppCallbacks.h>
 
@@ -50,8 +51,9 @@ namespace zypp
       /** libsolv::pool_findfileconflicts callback providing package header. */
       struct FileConflictsCB
       {
-        FileConflictsCB( sat::detail::CPool * pool_r, ProgressData & progress_r )
+        FileConflictsCB( sat::detail::CPool * pool_r, ProgressData & progress_r, rpm::RpmHeaderPrefetch & prefetch_r )
         : _progress( progress_r )
+        , _prefetch( prefetch_r )
         , _state( ::rpm_state_create( pool_r, ::pool_get_rootdir(pool_r) ), ::rpm_state_free )
         {}
 
@@ -98,6 +100,11 @@ namespace zypp
           }
           else
           {
+            if ( _prefetch.contains( id_r ) )
+            {
+              AutoDispose<FILE*> fp( _prefetch.open( id_r ) );
+              return fp ? ::rpm_byfp( _state, fp, solv.asString().c_str() ) : nullptr;
+            }
             Package::Ptr pkg( make<Package>( solv ) );
             if ( ! pkg )
               return nullptr;
@@ -111,6 +118,7 @@ namespace zypp
 
       private:
         ProgressData & _progress;
+        rpm::RpmHeaderPrefetch & _prefetch;
         AutoDispose<void*> _state;
         std::unordered_set<sat::detail::IdType> _visited;
         sat::Queue _noFilelist;
@@ -134,7 +142,22 @@ namespace zypp
         if ( ! report->start( progress ) )
           ZYPP_THROW( AbortRequestException() );
 
-        FileConflictsCB cb( sat::Pool::instance().get(), progress );
+        // The headers are read on demand, while pool_findfileconflicts
+        // reports progress (and may be aborted).
+        rpm::RpmHeaderPrefetch prefetch;
+        for ( int i = 0; i < newpkgs; ++i )
+        {
+          sat::Solvable solv( todo[i] );
+          if ( solv.isSystem() )
+            continue;
+          Package::Ptr pkg( make<Package>( solv ) );
+          if ( ! pkg )
+            continue;
+          Pathname localfile( pkg->cachedLocation() );
+          if ( ! localfile.empty() )
+            prefetch.add( todo[i], std::move(localfile) );
+        }
+        FileConflictsCB cb( sat::Pool::instance().get(), progress, prefetch );
         // lambda receives progress trigger and translates into report
         auto sendProgress = [&]( const ProgressData & progress_r )->bool {
           if ( ! report->progress( progress_r, cb.noFilelist() ) )
@@ -158,6 +181,7 @@ namespace zypp
         progress.noSend();
 
         (count?WAR:MIL) << "Found " << count << " file conflicts." << endl;
+        MIL << prefetch << endl;
         if ( ! report->result( progress, cb.noFilelist(), conflicts ) )
           ZYPP_THROW( AbortRequestException() );
       }
@@ -49,6 +49,8 @@ namespace rpm
   {
     public:
       HeaderEntryGetter(const Header &h_r, rpmTag &tag_r);
+      /** Ctor passing \c ::headerGet flags, e.g. \c HEADERGET_MINMEM to get data pointing into the header. */
+      HeaderEntryGetter(const Header &h_r, rpmTag &tag_r, int flags_r);
 
       HeaderEntryGetter(const HeaderEntryGetter &) = delete;
       HeaderEntryGetter(HeaderEntryGetter &&) = delete;
@@ -73,6 +75,9 @@ namespace rpm
   inline HeaderEntryGetter::HeaderEntryGetter( const Header & h_r, rpmTag & tag_r )
     : _rpmtd( ::rpmtdNew() )
   { ::headerGet( h_r, tag_r, _rpmtd, HEADERGET_DEFAULT ); }
+  inline HeaderEntryGetter::HeaderEntryGetter( const Header & h_r, rpmTag & tag_r, int flags_r )
+    : _rpmtd( ::rpmtdNew() )
+  { ::headerGet( h_r, tag_r, _rpmtd, headerGetFlags(flags_r) ); }
   inline HeaderEntryGetter::~HeaderEntryGetter()
   { ::rpmtdFreeData( _rpmtd ); ::rpmtdFree( _rpmtd ); }
   inline rpmTagType	HeaderEntryGetter::type()	{ return rpmtdType( _rpmtd ); }
@@ -84,6 +89,9 @@ namespace rpm
     , _cnt( 0 )
     , _val( 0 )
   { ::headerGetEntry( h_r, tag_r, hTYP_t(&_type), &_val, &_cnt ); }
+  inline HeaderEntryGetter::HeaderEntryGetter( const Header & h_r, rpmTag & tag_r, int )
+    : HeaderEntryGetter( h_r, tag_r )
+  {} // strings returned by ::headerGetEntry always point into the header
   inline HeaderEntryGetter::~HeaderEntryGetter()
   { if ( _val && _type == RPM_STRING_ARRAY_TYPE ) free( _val ); }
   inline rpmTagType	HeaderEntryGetter::type()	{ return _type; }
@@ -401,6 +409,74 @@ std::string BinHeader::string_val( tag tag_r ) const
   return "";
 }
 
+///////////////////////////////////////////////////////////////////
+//
+//
+//        METHOD NAME : BinHeader::string_view
+//        METHOD TYPE : std::string_view
+//
+//        DESCRIPTION :
+//
+std::string_view BinHeader::string_view( tag tag_r ) const
+{
+  if ( !empty() )
+  {
+    HeaderEntryGetter headerget( _h, tag_r, HEADERGET_MINMEM );
+
+    if ( headerget.val() )
+    {
+      switch ( headerget.type() )
+      {
+      case RPM_NULL_TYPE:
+        return std::string_view();
+      case RPM_STRING_TYPE:
+        return (const char*)headerget.val();
+
+     default:
+        INT << "RPM_TAG MISMATCH: RPM_STRING_TYPE " << tag_r << " got type " << headerget.type() << endl;
+      }
+    }
+  }
+  return std::string_view();
+}
+
+///////////////////////////////////////////////////////////////////
+//
+//
+//        METHOD NAME : BinHeader::string_views
+//        METHOD TYPE : unsigned
+//
+//        DESCRIPTION :
+//
+unsigned BinHeader::string_views( tag tag_r, std::vector<std::string_view> & lst_r ) const
+{
+  lst_r.clear();
+  if ( !empty() )
+  {
+    HeaderEntryGetter headerget( _h, tag_r, HEADERGET_MINMEM );
+
+    if ( headerget.val() )
+    {
+      switch ( headerget.type() )
+      {
+      case RPM_NULL_TYPE:
+        break;
+      case RPM_STRING_ARRAY_TYPE:
+      {
+        const char ** val = (const char **)headerget.val();
+        lst_r.reserve( headerget.cnt() );
+        for ( rpm_count_t i = 0; i < headerget.cnt(); ++i )
+          lst_r.push_back( val[i] );
+        break;
+      }
+      default:
+        INT << "RPM_TAG MISMATCH: RPM_STRING_ARRAY_TYPE " << tag_r << " got type " << headerget.type() << endl;
+      }
+    }
+  }
+  return lst_r.size();
+}
+
 std::string BinHeader::format(const char *fmt) const
 {
   zypp::AutoDispose<char *> form(headerFormat(_h, fmt, NULL), free);
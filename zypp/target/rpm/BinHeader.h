@@ -19,9 +19,11 @@ extern "C"
 
 #include <iosfwd>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <list>
 
+#include <zypp/Globals.h>
 #include <zypp/base/ReferenceCounted.h>
 #include <zypp/base/NonCopyable.h>
 #include <zypp/base/PtrTypes.h>
@@ -91,6 +93,19 @@ public:
   ByteArray blob_val ( tag tag_r ) const;
 
   std::string string_val( tag tag_r ) const;
+
+  /** Zero copy version of \ref string_val.
+   * The view points into the header data and is valid as long as
+   * this header is alive. An empty view if the tag is not present.
+   */
+  std::string_view string_view( tag tag_r ) const ZYPP_TESTS;
+
+  /** Zero copy version of \ref string_list, storing the values in \a lst_r.
+   * The views point into the header data and are valid as long as
+   * this header is alive. Returns the number of values.
+   */
+  unsigned string_views( tag tag_r, std::vector<std::string_view> & lst_r ) const ZYPP_TESTS;
+
   std::string format ( const char * fmt) const;
 
   Header get() const;
@@ -50,6 +50,7 @@ extern "C"
 #include <zypp/HistoryLog.h>
 #include <zypp/target/rpm/librpmDb.h>
 #include <zypp/target/rpm/RpmException.h>
+#include <zypp/target/rpm/RpmFileVerifier.h>
 #include <zypp/TmpPath.h>
 #include <zypp/KeyRing.h>
 #include <zypp/KeyManager.h>
@@ -981,7 +982,7 @@ bool RpmDb::hasFile( const std::string & file_r, const std::string & name_r ) co
     if (!res) break;
     if (!name_r.empty())
     {
-      res = (it->tag_name() == name_r);
+      res = (it->string_view( RPMTAG_NAME ) == name_r);
     }
     ++it;
   }
@@ -1373,57 +1374,42 @@ RpmDb::CheckPackageResult RpmDb::checkPackageSignature( const Pathname & path_r,
 bool
 RpmDb::queryChangedFiles(FileList & fileList, const std::string& packageName)
 {
-  bool ok = true;
-
   fileList.clear();
 
   if ( ! initialized() ) return false;
 
-  RpmArgVec opts;
-
-  opts.push_back ("-V");
-  opts.push_back ("--nodeps");
-  opts.push_back ("--noscripts");
-  opts.push_back ("--nomd5");
-  opts.push_back ("--");
-  opts.push_back (packageName.c_str());
-
-  run_rpm (opts, ExternalProgram::Discard_Stderr);
-
-  if ( process == NULL )
+  // Same as 'rpm -V --nodeps --noscripts --nomd5 -- packageName' reporting
+  // a changed size or mtime, but without spawning rpm.
+  RpmFileVerifier verifier( _root );
+  librpmDb::db_const_iterator it;
+  for ( it.findByName( packageName ); *it; ++it )
+    verifier.add( packageName, **it );
+  if ( it.dbError() )
     return false;
 
-  /* from rpm manpage
-   5      MD5 sum
-   S      File size
-   L      Symlink
-   T      Mtime
-   D      Device
-   U      User
-   G      Group
-   M      Mode (includes permissions and file type)
-  */
+  std::map<std::string,FileList> changed { verifier.changedFiles() };
+  if ( ! changed.empty() )
+    fileList.swap( changed.begin()->second );
+  return true;
+}
 
-  std::string line;
-  while (systemReadLine(line))
-  {
-    if (line.length() > 12 &&
-        (line[0] == 'S' || line[0] == 's' ||
-         (line[0] == '.' && line[7] == 'T')))
-    {
-      // file has been changed
-      std::string filename;
+bool
+RpmDb::queryChangedFiles(std::map<std::string,FileList> & changedFiles_r)
+{
+  changedFiles_r.clear();
 
-      filename.assign(line, 11, line.length() - 11);
-      fileList.insert(filename);
-    }
-  }
+  if ( ! initialized() ) return false;
 
-  systemStatus();
-  // exit code ignored, rpm returns 1 no matter if package is installed or
-  // not
+  RpmFileVerifier verifier( _root );
+  librpmDb::db_const_iterator it;
+  for ( ; *it; ++it )
+    verifier.add( (*it)->tag_name(), **it );
+  if ( it.dbError() )
+    return false;
 
-  return ok;
+  MIL << "Verify " << verifier << endl;
+  changedFiles_r = verifier.changedFiles();
+  return true;
 }
 
 
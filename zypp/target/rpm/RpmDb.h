@@ -17,6 +17,8 @@
 
 #include <iosfwd>
 #include <list>
+#include <map>
+#include <set>
 #include <vector>
 #include <string>
 #include <functional>
@@ -486,6 +488,19 @@ public:
    * */
   bool queryChangedFiles(FileList & fileList, const std::string& packageName);
 
+  /**
+   * determine the modified files of all installed packages.
+   *
+   * Like \ref queryChangedFiles for a single package, but the
+   * files are checked in a single pass over the database.
+   *
+   * @param changedFiles_r (output) modified files per package name,
+   * packages without modified files are omitted
+   *
+   * @return false if the database couldn't be queried
+   * */
+  bool queryChangedFiles(std::map<std::string,FileList> & changedFiles_r);
+
 public:
 
   /**
@@ -0,0 +1,171 @@
+/*---------------------------------------------------------------------\
+|                          ____ _   __ __ ___                          |
+|                         |__  / \ / / . \ . \                         |
+|                           / / \ V /|  _/  _/                         |
+|                          / /__ | | | | | |                           |
+|                         /_____||_| |_| |_|                           |
+|                                                                      |
+\---------------------------------------------------------------------*/
+/** \file zypp/target/rpm/RpmFileVerifier.cc
+ *
+*/
+#include "librpm.h"
+
+#include <sys/stat.h>
+
+#include <iostream>
+#include <algorithm>
+#include <atomic>
+#include <string_view>
+#include <thread>
+
+#include <zypp/base/Logger.h>
+#include <zypp/target/rpm/RpmFileVerifier.h>
+
+#undef ZYPP_BASE_LOGGER_LOGGROUP
+#define ZYPP_BASE_LOGGER_LOGGROUP "librpmDb"
+
+using std::endl;
+
+namespace zypp
+{
+namespace target
+{
+namespace rpm
+{
+  namespace
+  {
+    constexpr unsigned maxThreads = 8;
+    constexpr size_t filesPerThread = 256;
+  }
+
+  RpmFileVerifier::RpmFileVerifier( Pathname root_r )
+  : _root( std::move(root_r) )
+  {}
+
+  unsigned RpmFileVerifier::keyIndex( const std::string & key_r )
+  {
+    // packages are usually added in a row
+    if ( ! _keys.empty() && _keys.back() == key_r )
+      return _keys.size() - 1;
+    auto it = std::find( _keys.begin(), _keys.end(), key_r );
+    if ( it != _keys.end() )
+      return it - _keys.begin();
+    _keys.push_back( key_r );
+    return _keys.size() - 1;
+  }
+
+  void RpmFileVerifier::add( const std::string & key_r, const BinHeader & header_r )
+  {
+    std::vector<std::string_view> basenames;
+    if ( ! header_r.string_views( RPMTAG_BASENAMES, basenames ) )
+      return;
+    std::vector<std::string_view> dirnames;
+    header_r.string_views( RPMTAG_DIRNAMES, dirnames );
+
+    BinHeader::intList dirindexes;
+    header_r.int_list( RPMTAG_DIRINDEXES, dirindexes );
+    BinHeader::intList sizes;
+    bool longsizes = header_r.int_list( RPMTAG_LONGFILESIZES, sizes );
+    if ( ! longsizes )
+      header_r.int_list( RPMTAG_FILESIZES, sizes );
+    BinHeader::intList mtimes;
+    header_r.int_list( RPMTAG_FILEMTIMES, mtimes );
+    BinHeader::intList modes;
+    header_r.int_list( RPMTAG_FILEMODES, modes );
+    BinHeader::intList flags;
+    header_r.int_list( RPMTAG_FILEFLAGS, flags );
+    BinHeader::intList verifyflags;
+    header_r.int_list( RPMTAG_FILEVERIFYFLAGS, verifyflags );
+    BinHeader::intList states;
+    header_r.int_list( RPMTAG_FILESTATES, states );
+
+    unsigned key = keyIndex( key_r );
+    for ( unsigned i = 0; i < basenames.size(); ++i )
+    {
+      // rpm -V does not check these for size and mtime
+      if ( i < states.size() && states[i] != RPMFILE_STATE_NORMAL )
+        continue;
+      if ( flags[i] & RPMFILE_GHOST )
+        continue;
+      if ( ! S_ISREG( mode_t(uint16_t(modes[i])) ) )
+        continue;
+
+      rpmVerifyAttrs verify = i < verifyflags.size() ? rpmVerifyAttrs(verifyflags[i]) : RPMVERIFY_ALL;
+      bool checkSize = verify & RPMVERIFY_FILESIZE;
+      bool checkMtime = verify & RPMVERIFY_MTIME;
+      if ( ! ( checkSize || checkMtime ) )
+        continue;
+
+      unsigned dirindex = dirindexes[i];
+      if ( dirindex >= dirnames.size() )
+        continue;
+
+      std::string path;
+      path.reserve( dirnames[dirindex].size() + basenames[i].size() );
+      path.append( dirnames[dirindex] ).append( basenames[i] );
+
+      // sizes and mtimes are unsigned in the header
+      unsigned long long size = longsizes ? (unsigned long long)sizes[i] : uint32_t(sizes[i]);
+      _files.push_back( File{ key, std::move(path), size, time_t(uint32_t(mtimes[i])), checkSize, checkMtime } );
+    }
+  }
+
+  void RpmFileVerifier::addFile( const std::string & key_r, std::string path_r, unsigned long long size_r, time_t mtime_r,
+                                 bool checkSize_r, bool checkMtime_r )
+  {
+    _files.push_back( File{ keyIndex( key_r ), std::move(path_r), size_r, mtime_r, checkSize_r, checkMtime_r } );
+  }
+
+  std::map<std::string,RpmFileVerifier::FileList> RpmFileVerifier::changedFiles() const
+  {
+    std::map<std::string,FileList> ret;
+    if ( _files.empty() )
+      return ret;
+
+    const std::string prefix { _root.emptyOrRoot() ? std::string() : _root.asString() };
+    std::vector<char> changed( _files.size(), 0 );
+    std::atomic<size_t> next { 0 };
+
+    auto worker = [&]() {
+      std::string fullpath { prefix };
+      struct stat st;
+      for ( size_t i = next++; i < _files.size(); i = next++ )
+      {
+        const File & file { _files[i] };
+        fullpath.resize( prefix.size() );
+        fullpath += file.path;
+        if ( ::lstat( fullpath.c_str(), &st ) != 0 )
+          continue;	// missing files are not reported
+        if ( ( file.checkSize && (unsigned long long)st.st_size != file.size )
+          || ( file.checkMtime && st.st_mtime != file.mtime ) )
+          changed[i] = 1;
+      }
+    };
+
+    unsigned nthreads = std::min<size_t>( std::max( std::thread::hardware_concurrency(), 1U ), std::min<size_t>( maxThreads, _files.size() / filesPerThread + 1 ) );
+    std::vector<std::thread> threads;
+    for ( unsigned i = 1; i < nthreads; ++i )
+      threads.emplace_back( worker );
+    worker();
+    for ( auto & t : threads )
+      t.join();
+
+    for ( size_t i = 0; i < _files.size(); ++i )
+    {
+      if ( changed[i] )
+        ret[_keys[_files[i].key]].insert( _files[i].path );
+    }
+    DBG << "Verified " << _files.size() << " files of " << _keys.size() << " packages (" << nthreads << " threads): "
+        << ret.size() << " packages changed" << endl;
+    return ret;
+  }
+
+  std::ostream & operator<<( std::ostream & str, const RpmFileVerifier & obj )
+  {
+    return str << "RpmFileVerifier(" << obj._root << "){" << obj._keys.size() << " packages, " << obj._files.size() << " files}";
+  }
+
+} // namespace rpm
+} // namespace target
+} // namespace zypp
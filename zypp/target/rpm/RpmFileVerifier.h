@@ -0,0 +1,109 @@
+/*---------------------------------------------------------------------\
+|                          ____ _   __ __ ___                          |
+|                         |__  / \ / / . \ . \                         |
+|                           / / \ V /|  _/  _/                         |
+|                          / /__ | | | | | |                           |
+|                         /_____||_| |_| |_|                           |
+|                                                                      |
+\---------------------------------------------------------------------*/
+/** \file zypp/target/rpm/RpmFileVerifier.h
+ *
+*/
+#ifndef ZYPP_TARGET_RPM_RPMFILEVERIFIER_H
+#define ZYPP_TARGET_RPM_RPMFILEVERIFIER_H
+
+#include <iosfwd>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <zypp/Globals.h>
+#include <zypp/Pathname.h>
+#include <zypp/target/rpm/BinHeader.h>
+
+namespace zypp
+{
+namespace target
+{
+namespace rpm
+{
+  ///////////////////////////////////////////////////////////////////
+  /// \class RpmFileVerifier
+  /// \brief Find the modified files of installed packages without running \c rpm -V.
+  ///
+  /// Reports the same files as <tt>rpm -V --nodeps --noscripts --nomd5</tt>
+  /// would flag with a changed size (\c S) or mtime (\c T). The expected
+  /// size and mtime of the regular files are taken from the rpm headers and
+  /// compared with the files below \c root. Missing files, ghost files, files
+  /// not installed and files whose \c %verify excludes size and mtime are
+  /// not reported.
+  ///
+  /// The headers are read when the packages are \ref add ed. \ref changedFiles
+  /// then stats all files on a few threads.
+  ///
+  /// \code
+  ///   RpmFileVerifier verifier( root );
+  ///   for ( librpmDb::db_const_iterator it; *it; ++it )
+  ///     verifier.add( (*it)->tag_name(), **it );
+  ///   for ( const auto & [ name, files ] : verifier.changedFiles() )
+  ///     ...
+  /// \endcode
+  ///////////////////////////////////////////////////////////////////
+  class ZYPP_TESTS RpmFileVerifier
+  {
+    friend std::ostream & operator<<( std::ostream & str, const RpmFileVerifier & obj );
+
+  public:
+    using FileList = std::set<std::string>;
+    using size_type = unsigned;
+
+    /** Verify the files below \a root_r. */
+    explicit RpmFileVerifier( Pathname root_r = "/" );
+
+    /** Add the files of the package \a header_r, reported as \a key_r.
+     * Packages added with the same key (e.g. multiple versions) are merged.
+     */
+    void add( const std::string & key_r, const BinHeader & header_r );
+
+    /** Add a single regular file \a path_r expecting \a size_r and \a mtime_r. */
+    void addFile( const std::string & key_r, std::string path_r, unsigned long long size_r, time_t mtime_r,
+                  bool checkSize_r = true, bool checkMtime_r = true );
+
+    /** Number of files to verify. */
+    size_type size() const
+    { return _files.size(); }
+
+    /** Whether there are no files to verify. */
+    bool empty() const
+    { return _files.empty(); }
+
+    /** The changed files per key. Keys without changed files are omitted. */
+    std::map<std::string,FileList> changedFiles() const;
+
+  private:
+    struct File
+    {
+      unsigned key;
+      std::string path;
+      unsigned long long size;
+      time_t mtime;
+      bool checkSize;
+      bool checkMtime;
+    };
+
+    unsigned keyIndex( const std::string & key_r );
+
+  private:
+    Pathname _root;
+    std::vector<std::string> _keys;
+    std::vector<File> _files;
+  };
+
+  /** \relates RpmFileVerifier Stream output */
+  std::ostream & operator<<( std::ostream & str, const RpmFileVerifier & obj ) ZYPP_TESTS;
+
+} // namespace rpm
+} // namespace target
+} // namespace zypp
+#endif // ZYPP_TARGET_RPM_RPMFILEVERIFIER_H
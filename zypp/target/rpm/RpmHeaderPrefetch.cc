@@ -0,0 +1,200 @@
+/*---------------------------------------------------------------------\
+|                          ____ _   __ __ ___                          |
+|                         |__  / \ / / . \ . \                         |
+|                           / / \ V /|  _/  _/                         |
+|                          / /__ | | | | | |                           |
+|                         /_____||_| |_| |_|                           |
+|                                                                      |
+\---------------------------------------------------------------------*/
+/** \file zypp/target/rpm/RpmHeaderPrefetch.cc
+ *
+*/
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <iostream>
+#include <atomic>
+#include <thread>
+
+#include <zypp/base/Logger.h>
+#include <zypp/ByteCount.h>
+#include <zypp/target/rpm/RpmHeaderPrefetch.h>
+
+using std::endl;
+
+namespace zypp
+{
+namespace target
+{
+namespace rpm
+{
+  namespace
+  {
+    constexpr unsigned maxThreads = 8;
+    constexpr size_t windowSize = 64;	///< packages read at once
+
+    /** Read \a size_r bytes at the end of \a blob_r from \a fd_r. */
+    bool readAppend( int fd_r, std::string & blob_r, size_t size_r )
+    {
+      size_t off = blob_r.size();
+      blob_r.resize( off + size_r );
+      while ( size_r )
+      {
+        ssize_t got = ::read( fd_r, &blob_r[off], size_r );
+        if ( got < 0 && errno == EINTR )
+          continue;
+        if ( got <= 0 )
+          return false;
+        off += got;
+        size_r -= got;
+      }
+      return true;
+    }
+
+    inline uint32_t be32( const std::string & blob_r, size_t off_r )
+    {
+      const unsigned char * p = reinterpret_cast<const unsigned char *>( blob_r.data() + off_r );
+      return ( uint32_t(p[0]) << 24 ) | ( uint32_t(p[1]) << 16 ) | ( uint32_t(p[2]) << 8 ) | uint32_t(p[3]);
+    }
+
+    /** Append the next rpm header structure (intro, index and data) to \a blob_r.
+     * The signature header is padded to a multiple of 8 (\a pad_r).
+     */
+    bool readRpmHeader( int fd_r, std::string & blob_r, bool pad_r )
+    {
+      static const size_t maxHeaderSize = 64 * 1024 * 1024;
+      size_t off = blob_r.size();
+      if ( ! readAppend( fd_r, blob_r, 16 ) )
+        return false;
+      if ( blob_r.compare( off, 4, "\x8e\xad\xe8\x01", 4 ) != 0 )
+        return false;
+      size_t il = be32( blob_r, off+8 );
+      size_t dl = be32( blob_r, off+12 );
+      if ( il > maxHeaderSize/16 || dl > maxHeaderSize )
+        return false;
+      size_t len = il * 16 + dl;
+      if ( pad_r )
+        len += ( 8 - ( len % 8 ) ) % 8;
+      return readAppend( fd_r, blob_r, len );
+    }
+
+    /** Read the leading part of an rpm file libsolv's \c rpm_byfp needs (lead, signature and main header). */
+    bool readRpmHeaderBlob( const Pathname & file_r, std::string & blob_r )
+    {
+      AutoFD fd( ::open( file_r.c_str(), O_RDONLY|O_CLOEXEC ) );
+      if ( fd == -1 )
+        return false;
+      blob_r.clear();
+      return readAppend( fd, blob_r, 96 )	// lead
+          && readRpmHeader( fd, blob_r, true )	// signature
+          && readRpmHeader( fd, blob_r, false );	// header
+    }
+  } // namespace
+
+  RpmHeaderPrefetch::RpmHeaderPrefetch( size_t budget_r )
+  : _budget( budget_r )
+  {}
+
+  void RpmHeaderPrefetch::add( IdType id_r, Pathname file_r )
+  {
+    if ( _index.emplace( id_r, _jobs.size() ).second )
+      _jobs.push_back( Job{ id_r, std::move(file_r) } );
+  }
+
+  AutoDispose<FILE*> RpmHeaderPrefetch::open( IdType id_r )
+  {
+    auto it = _index.find( id_r );
+    if ( it == _index.end() )
+      return AutoDispose<FILE*>();
+
+    Job & job { _jobs[it->second] };
+    if ( job.state == State::Unread )
+      fetch( it->second );
+
+    if ( job.state == State::InMemory )
+    {
+      if ( FILE * fp = ::fmemopen( &job.blob[0], job.blob.size(), "r" ) )
+      {
+        ++_hits;
+        return AutoDispose<FILE*>( fp, ::fclose );
+      }
+    }
+    ++_misses;
+    FILE * fp = ::fopen( job.file.c_str(), "re" );
+    return fp ? AutoDispose<FILE*>( fp, ::fclose ) : AutoDispose<FILE*>();
+  }
+
+  void RpmHeaderPrefetch::fetch( size_t idx_r )
+  {
+    std::vector<size_t> window;
+    for ( size_t i = idx_r; i < _jobs.size() && window.size() < windowSize; ++i )
+    {
+      if ( _jobs[i].state == State::Unread )
+        window.push_back( i );
+    }
+
+    std::vector<char> ok( window.size(), 0 );
+    std::atomic<size_t> next { 0 };
+    auto worker = [&]() {
+      for ( size_t i = next++; i < window.size(); i = next++ )
+      {
+        try {
+          ok[i] = readRpmHeaderBlob( _jobs[window[i]].file, _jobs[window[i]].blob );
+        }
+        catch (...)
+        {}
+      }
+    };
+
+    unsigned nthreads = std::min<size_t>( std::max( std::thread::hardware_concurrency(), 1U ), std::min<size_t>( maxThreads, window.size() ) );
+    std::vector<std::thread> threads;
+    for ( unsigned i = 1; i < nthreads; ++i )
+      threads.emplace_back( worker );
+    worker();
+    for ( auto & t : threads )
+      t.join();
+
+    // Make room for the new window by dropping the oldest headers.
+    size_t needed = 0;
+    for ( size_t i = 0; i < window.size(); ++i )
+    {
+      if ( ok[i] )
+        needed += _jobs[window[i]].blob.size();
+    }
+    while ( ! _inMemory.empty() && _used + needed > _budget )
+    {
+      Job & old { _jobs[_inMemory.front()] };
+      _used -= old.blob.size();
+      std::string().swap( old.blob );
+      old.state = State::OnDisk;
+      _inMemory.pop_front();
+    }
+
+    for ( size_t i = 0; i < window.size(); ++i )
+    {
+      Job & job { _jobs[window[i]] };
+      if ( ok[i] && _used + job.blob.size() <= _budget )
+      {
+        _used += job.blob.size();
+        job.state = State::InMemory;
+        _inMemory.push_back( window[i] );
+      }
+      else
+      {
+        std::string().swap( job.blob );
+        job.state = State::OnDisk;
+      }
+    }
+    DBG << "Prefetched " << window.size() << " package headers (" << nthreads << " threads, " << ByteCount( _used ) << " in memory)" << endl;
+  }
+
+  std::ostream & operator<<( std::ostream & str, const RpmHeaderPrefetch & obj )
+  {
+    return str << "RpmHeaderPrefetch{" << obj._jobs.size() << " packages, " << obj._hits << " from memory, "
+               << obj._misses << " from file, " << ByteCount( obj._used ) << "}";
+  }
+
+} // namespace rpm
+} // namespace target
+} // namespace zypp
@@ -0,0 +1,122 @@
+/*---------------------------------------------------------------------\
+|                          ____ _   __ __ ___                          |
+|                         |__  / \ / / . \ . \                         |
+|                           / / \ V /|  _/  _/                         |
+|                          / /__ | | | | | |                           |
+|                         /_____||_| |_| |_|                           |
+|                                                                      |
+\---------------------------------------------------------------------*/
+/** \file zypp/target/rpm/RpmHeaderPrefetch.h
+ *
+*/
+#ifndef ZYPP_TARGET_RPM_RPMHEADERPREFETCH_H
+#define ZYPP_TARGET_RPM_RPMHEADERPREFETCH_H
+
+#include <cstdio>
+#include <iosfwd>
+#include <string>
+#include <vector>
+#include <deque>
+#include <unordered_map>
+
+#include <zypp/Globals.h>
+#include <zypp/Pathname.h>
+#include <zypp/AutoDispose.h>
+#include <zypp/sat/detail/PoolMember.h>
+
+namespace zypp
+{
+namespace target
+{
+namespace rpm
+{
+  ///////////////////////////////////////////////////////////////////
+  /// \class RpmHeaderPrefetch
+  /// \brief Read the leading part of rpm files (lead, signature and main header) ahead of use.
+  ///
+  /// Serves \c pool_findfileconflicts, which visits each package up to 3
+  /// times and parses the header from a \c FILE*. Instead of opening the
+  /// package on each visit, \ref open returns a stream on the header read
+  /// into memory.
+  ///
+  /// Headers are read lazily: opening a package not read so far reads it
+  /// together with the next few packages (in the order they were added) on
+  /// a couple of threads. The memory kept is bounded; the oldest headers are
+  /// dropped if it is exceeded. Packages dropped, or failing to be read, are
+  /// opened as file.
+  ///
+  /// \code
+  ///   RpmHeaderPrefetch prefetch;
+  ///   prefetch.add( id, "/var/cache/zypp/packages/repo/x86_64/foo.rpm" );
+  ///   ...
+  ///   AutoDispose<FILE*> fp { prefetch.open( id ) };
+  /// \endcode
+  ///////////////////////////////////////////////////////////////////
+  class ZYPP_TESTS RpmHeaderPrefetch
+  {
+    friend std::ostream & operator<<( std::ostream & str, const RpmHeaderPrefetch & obj );
+
+  public:
+    using IdType = sat::detail::IdType;
+
+    /** Default memory budget in bytes. */
+    static constexpr size_t defaultBudget = 64 * 1024 * 1024;
+
+    /** Ctor keeping at most \a budget_r bytes of headers in memory. */
+    explicit RpmHeaderPrefetch( size_t budget_r = defaultBudget );
+
+    RpmHeaderPrefetch( const RpmHeaderPrefetch & ) = delete;
+    RpmHeaderPrefetch & operator=( const RpmHeaderPrefetch & ) = delete;
+
+    /** Remember \a file_r as the rpm file of \a id_r. */
+    void add( IdType id_r, Pathname file_r );
+
+    /** Whether \a id_r was \ref add ed. */
+    bool contains( IdType id_r ) const
+    { return _index.count( id_r ); }
+
+    /** A stream on the rpm file of \a id_r, \c nullptr if \a id_r is unknown.
+     * The stream either reads the header from memory or the file itself.
+     * It must be closed before \ref open is called again.
+     */
+    AutoDispose<FILE*> open( IdType id_r );
+
+  public:
+    /** Number of files opened from memory. */
+    unsigned hits() const
+    { return _hits; }
+
+    /** Number of files opened as file. */
+    unsigned misses() const
+    { return _misses; }
+
+  private:
+    enum class State { Unread, InMemory, OnDisk };
+
+    struct Job
+    {
+      IdType id;
+      Pathname file;
+      State state = State::Unread;
+      std::string blob;
+    };
+
+    void fetch( size_t idx_r );
+
+  private:
+    size_t _budget;
+    size_t _used = 0;
+    std::vector<Job> _jobs;
+    std::deque<size_t> _inMemory;	///< InMemory jobs, oldest first
+    std::unordered_map<IdType,size_t> _index;
+    unsigned _hits = 0;
+    unsigned _misses = 0;
+  };
+
+  /** \relates RpmHeaderPrefetch Stream output */
+  std::ostream & operator<<( std::ostream & str, const RpmHeaderPrefetch & obj ) ZYPP_TESTS;
+
+} // namespace rpm
+} // namespace target
+} // namespace zypp
+#endif // ZYPP_TARGET_RPM_RPMHEADERPREFETCH_H
@@ -17,7 +17,9 @@
 #include <zypp/KeyManager.h>
 #include <zypp/KeyRing.h>
 
+#include <functional>
 #include <optional>
+#include <unordered_map>
 
 namespace zypp {
 
@@ -28,6 +30,10 @@ namespace zypp {
   /// \code
   ///   const std::list<PublicKeyData> & cachedPublicKeyData( const Pathname & keyring );
   /// \endcode
+  ///
+  /// Per keyring a single \ref KeyManagerCtx is kept for the lifetime of the
+  /// cache and used for all operations on that keyring. Key lookups and
+  /// exported keys are remembered until the keyring changes.
   ///////////////////////////////////////////////////////////////////
   struct CachedPublicKeyData : private base::NonCopyable
   {
@@ -35,6 +41,16 @@ namespace zypp {
 
     void setDirty( const Pathname & keyring_r );
 
+    /** The \ref KeyManagerCtx session used for all operations on \a keyring_r. */
+    KeyManagerCtx & context( const Pathname & keyring_r ) const;
+
+    /** The key providing \a id_r in \a keyring_r (\c false if ID is not found). */
+    PublicKeyData lookup( const Pathname & keyring_r, const std::string & id_r ) const;
+
+    /** Key \a id_r exported by \a export_r, remembered until \a keyring_r changes. */
+    filesystem::TmpFile exported( const Pathname & keyring_r, const std::string & id_r,
+                                  const std::function<filesystem::TmpFile()> & export_r ) const;
+
     ///////////////////////////////////////////////////////////////////
     /// \brief Helper providing on demand a KeyManagerCtx to manip the cached keyring.
     ///
@@ -49,7 +65,7 @@ namespace zypp {
     private:
       CachedPublicKeyData & _cache;
       Pathname _keyring;
-      std::optional<KeyManagerCtx> _context;
+      KeyManagerCtx * _context = nullptr;
     };
     ///////////////////////////////////////////////////////////////////
 
@@ -68,6 +84,9 @@ namespace zypp {
       bool hasChanged() const;
 
       std::list<PublicKeyData> _data;
+      std::unordered_map<std::string, PublicKeyData> _lookup;	///< ids looked up in _data
+      std::unordered_map<std::string, filesystem::TmpFile> _exported;	///< keys exported from the keyring
+      std::optional<KeyManagerCtx> _context;	///< session for the keyring
 
     private:
 
@@ -81,6 +100,9 @@ namespace zypp {
 
     const std::list<PublicKeyData> & getData( const Pathname & keyring_r, Cache & cache_r ) const;
 
+    /** The cache entry of \a keyring_r with up to date data. */
+    Cache & assertData( const Pathname & keyring_r ) const;
+
     mutable CacheMap _cacheMap;
   };
 
@@ -150,6 +172,7 @@ namespace zypp {
     { return exportKey( key.keyData(), keyring ); }
 
     void dumpPublicKey( const std::string & id, const Pathname & keyring, std::ostream & stream );
+    /** Export key \a id to a tmp file (remembered until the keyring changes). */
     filesystem::TmpFile dumpPublicKeyToTmp( const std::string & id, const Pathname & keyring );
 
     void deleteKey( const std::string & id, const Pathname & keyring );
@@ -174,6 +197,7 @@ namespace zypp {
     filesystem::TmpDir _general_tmp_dir;
     Pathname _base_dir;
     bool _allowPreload = false;	//< General keyring may be preloaded with keys cached on the system.
+    std::optional<KeyManagerCtx> _volatileCtx;	//< for operations not needing a keyring
 
     /** Functor returning the keyrings data (cached).
      * \code
@@ -17,6 +17,7 @@
 #include <zypp/ZConfig.h>
 #include <zypp/ZYppCallbacks.h>
 #include <zypp/base/LogTools.h>
+#include <zypp/parser/IniFileCache.h>
 #include <zypp/parser/RepoFileReader.h>
 #include <zypp/parser/ServiceFileReader.h>
 #include <zypp/sat/Pool.h>
@@ -103,15 +104,18 @@ namespace zypp
     return true;
   }
 
-  std::list<RepoInfo> repositories_in_file(const Pathname &file)
+  std::list<RepoInfo> repositories_in_file(const Pathname &file, parser::IniFileCache *cache)
   {
     MIL << "repo file: " << file << endl;
     RepoCollector collector;
-    parser::RepoFileReader parser( file, bind( &RepoCollector::collect, &collector, _1 ) );
+    if ( cache )
+      parser::RepoFileReader parser( file, *cache, bind( &RepoCollector::collect, &collector, _1 ) );
+    else
+      parser::RepoFileReader parser( file, bind( &RepoCollector::collect, &collector, _1 ) );
     return std::move(collector.repos);
   }
 
-  std::list<RepoInfo> repositories_in_dir(const Pathname &dir)
+  std::list<RepoInfo> repositories_in_dir(const Pathname &dir, parser::IniFileCache *cache)
   {
     MIL << "directory " << dir << endl;
     std::list<RepoInfo> repos;
@@ -140,7 +144,7 @@ namespace zypp
           }
           else
           {
-            const std::list<RepoInfo> & tmp( repositories_in_file( *it ) );
+            const std::list<RepoInfo> & tmp( repositories_in_file( *it, cache ) );
             repos.insert( repos.end(), tmp.begin(), tmp.end() );
           }
         }
@@ -806,7 +810,7 @@ namespace zypp
     return touchIndexFile( info, _options );
   }
 
-  void RepoManagerBaseImpl::init_knownServices()
+  void RepoManagerBaseImpl::init_knownServices( parser::IniFileCache *cache )
   {
     Pathname dir = _options.knownServicesPath;
     std::list<Pathname> entries;
@@ -821,7 +825,10 @@ namespace zypp
       //str::regex allowedServiceExt("^\\.service(_[0-9]+)?$");
       for_(it, entries.begin(), entries.end() )
       {
-        parser::ServiceFileReader(*it, ServiceCollector(_services));
+        if ( cache )
+          parser::ServiceFileReader(*it, *cache, ServiceCollector(_services));
+        else
+          parser::ServiceFileReader(*it, ServiceCollector(_services));
       }
     }
 
@@ -871,7 +878,7 @@ namespace zypp
     }
   } // namespace
 
-  void RepoManagerBaseImpl::init_knownRepositories()
+  void RepoManagerBaseImpl::init_knownRepositories( parser::IniFileCache *cache )
   {
     MIL << "start construct known repos" << endl;
 
@@ -879,7 +886,7 @@ namespace zypp
     {
       std::list<std::string> repoEscAliases;
       std::list<RepoInfo> orphanedRepos;
-      for ( RepoInfo & repoInfo : repositories_in_dir(_options.knownReposPath) )
+      for ( RepoInfo & repoInfo : repositories_in_dir(_options.knownReposPath, cache) )
       {
         // set the metadata path for the repo
         repoInfo.setMetadataPath( rawcache_path_for_repoinfo(_options, repoInfo) );
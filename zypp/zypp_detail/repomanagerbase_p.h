@@ -26,6 +26,10 @@
 
 namespace zypp {
 
+  namespace parser {
+    class IniFileCache;
+  }
+
   #define OPT_PROGRESS const ProgressData::ReceiverFnc & = ProgressData::ReceiverFnc()
 
   /** Whether repo is not under RM control and provides its own methadata paths. */
@@ -116,8 +120,9 @@ namespace zypp {
      * Reads RepoInfo's from a repo file.
      *
      * \param file pathname of the file to read.
+     * \param cache optional cache of parsed files.
      */
-  std::list<RepoInfo> repositories_in_file( const Pathname & file );
+  std::list<RepoInfo> repositories_in_file( const Pathname & file, parser::IniFileCache * cache = nullptr );
 
   ////////////////////////////////////////////////////////////////////////////
 
@@ -128,8 +133,9 @@ namespace zypp {
      * RepoInfo's contained in that file.
      *
      * \param dir pathname of the directory to read.
+     * \param cache optional cache of parsed files.
      */
-  std::list<RepoInfo> repositories_in_dir( const Pathname &dir );
+  std::list<RepoInfo> repositories_in_dir( const Pathname &dir, parser::IniFileCache * cache = nullptr );
 
   void assert_urls( const RepoInfo & info );
 
@@ -356,8 +362,8 @@ namespace zypp {
     }
 
   protected:
-    void init_knownServices();
-    void init_knownRepositories();
+    void init_knownServices( parser::IniFileCache * cache = nullptr );
+    void init_knownRepositories( parser::IniFileCache * cache = nullptr );
 
     const RepoSet & repos() const { return _reposX; }
     RepoSet & reposManip()        { if ( ! _reposDirty ) _reposDirty = true; return _reposX; }